@@ -30,6 +30,8 @@
 #  PngImageConverter            - PNG image converter
 #  PngImporter                  - PNG importer
 #  StanfordImporter             - Stanford PLY importer
+#  StanfordSceneConverter       - Stanford PLY converter (a library, not a
+#   plugin)
 #  StbImageConverter            - Image converter using stb_image_write
 #  StbImageImporter             - Image importer using stb_image
 #  StbTrueTypeFont              - TrueType font using stb_truetype
@@ -151,6 +153,7 @@ endif()
 # Component distinction (listing them explicitly to avoid mistakes with finding
 # components from other repositories)
 set(_MAGNUMPLUGINS_PLUGIN_COMPONENTS "^(AnyAudioImporter|AnyImageConverter|AnyImageImporter|AnySceneImporter|AssimpImporter|ColladaImporter|DdsImporter|DevIlImageImporter|DrFlacAudioImporter|DrWavAudioImporter|FreeTypeFont|HarfBuzzFont|JpegImporter|MiniExrImageConverter|OpenGexImporter|PngImageConverter|PngImporter|StanfordImporter|StbImageConverter|StbImageImporter|StbTrueTypeFont|StbVorbisAudioImporter)$")
+set(_MAGNUMPLUGINS_LIBRARY_COMPONENTS "^(StanfordSceneConverter)$")
 
 # Find all components
 foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
@@ -216,10 +219,22 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
 
             # Reset back
             set(CMAKE_FIND_LIBRARY_PREFIXES "${_tmp_prefixes}")
+
+        # Library components
+        elseif(_component MATCHES ${_MAGNUMPLUGINS_LIBRARY_COMPONENTS})
+            add_library(MagnumPlugins::${_component} UNKNOWN IMPORTED)
+
+            set(_MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_PATH_NAMES ${_component}.h)
+
+            # Try to find both debug and release version
+            find_library(MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_DEBUG Magnum${_component}-d)
+            find_library(MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_RELEASE Magnum${_component})
+            mark_as_advanced(MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_DEBUG
+                MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_RELEASE)
         endif()
 
         # Library location for libraries/plugins
-        if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS})
+        if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS} OR _component MATCHES ${_MAGNUMPLUGINS_LIBRARY_COMPONENTS})
             if(MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_RELEASE)
                 set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
                     IMPORTED_CONFIGURATIONS RELEASE)
@@ -244,15 +259,18 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
             find_package(AssimpImporter)
             set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES Assimp::Assimp)
+            if(NOT CORRADE_TARGET_EMSCRIPTEN)
+                find_package(Threads)
+                set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
+                    INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+            endif()
         endif()
 
         # ColladaImporter plugin dependencies
-        if(_component STREQUAL ColladaImporter)
-            find_package(Qt4)
-            set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
-                INTERFACE_INCLUDE_DIRECTORIES ${QT_INCLUDE_DIR})
+        if(_component STREQUAL ColladaImporter AND NOT CORRADE_TARGET_EMSCRIPTEN)
+            find_package(Threads)
             set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
-                INTERFACE_LINK_LIBRARIES ${QT_QTCORE_LIBRARY} ${QT_QTXMLPATTERNS_LIBRARY})
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
         endif()
 
         # DdsImporter has no dependencies
@@ -290,7 +308,13 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
         endif()
 
         # MiniExrImageConverter has no dependencies
-        # OpenGexImporter has no dependencies
+
+        # OpenGexImporter plugin dependencies
+        if(_component STREQUAL OpenGexImporter AND NOT CORRADE_TARGET_EMSCRIPTEN)
+            find_package(Threads)
+            set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
+                INTERFACE_LINK_LIBRARIES ${CMAKE_THREAD_LIBS_INIT})
+        endif()
 
         # PngImageConverter plugin dependencies
         if(_component STREQUAL PngImageConverter)
@@ -307,20 +331,21 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
         endif()
 
         # StanfordImporter has no dependencies
+        # StanfordSceneConverter has no dependencies
         # StbImageConverter has no dependencies
         # StbImageImporter has no dependencies
         # StbTrueTypeFont has no dependencies
         # StbVorbisAudioImporter has no dependencies
 
-        # Find plugin includes
-        if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS})
+        # Find plugin and library includes
+        if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS} OR _component MATCHES ${_MAGNUMPLUGINS_LIBRARY_COMPONENTS})
             find_path(_MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_DIR
                 NAMES ${_MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_PATH_NAMES}
                 HINTS ${MAGNUMPLUGINS_INCLUDE_DIR}/MagnumPlugins/${_component})
             mark_as_advanced(_MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_DIR)
         endif()
 
-        if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS})
+        if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS} OR _component MATCHES ${_MAGNUMPLUGINS_LIBRARY_COMPONENTS})
             # Link to core Magnum library, add other Magnum dependencies
             set_property(TARGET MagnumPlugins::${_component} APPEND PROPERTY
                 INTERFACE_LINK_LIBRARIES Magnum::Magnum)
@@ -337,7 +362,7 @@ foreach(_component ${MagnumPlugins_FIND_COMPONENTS})
         endif()
 
         # Decide if the plugin was found
-        if(_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS} AND _MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_DIR AND (MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_DEBUG OR MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_RELEASE))
+        if((_component MATCHES ${_MAGNUMPLUGINS_PLUGIN_COMPONENTS} OR _component MATCHES ${_MAGNUMPLUGINS_LIBRARY_COMPONENTS}) AND _MAGNUMPLUGINS_${_COMPONENT}_INCLUDE_DIR AND (MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_DEBUG OR MAGNUMPLUGINS_${_COMPONENT}_LIBRARY_RELEASE))
             set(MagnumPlugins_${_component}_FOUND TRUE)
         else()
             set(MagnumPlugins_${_component}_FOUND FALSE)
@@ -79,6 +79,7 @@ cmake .. ^
     -DWITH_PNGIMAGECONVERTER=OFF ^
     -DWITH_PNGIMPORTER=OFF ^
     -DWITH_STANFORDIMPORTER=ON ^
+    -DWITH_STANFORDSCENECONVERTER=ON ^
     -DWITH_STBIMAGECONVERTER=ON ^
     -DWITH_STBIMAGEIMPORTER=ON ^
     -DWITH_STBTRUETYPEFONT=ON ^
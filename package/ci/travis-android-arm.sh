@@ -78,6 +78,7 @@ ANDROID_NDK=$TRAVIS_BUILD_DIR/android-ndk-r10e cmake .. \
     -DWITH_PNGIMAGECONVERTER=OFF \
     -DWITH_PNGIMPORTER=OFF \
     -DWITH_STANFORDIMPORTER=ON \
+    -DWITH_STANFORDSCENECONVERTER=ON \
     -DWITH_STBIMAGECONVERTER=ON \
     -DWITH_STBIMAGEIMPORTER=ON \
     -DWITH_STBTRUETYPEFONT=ON \
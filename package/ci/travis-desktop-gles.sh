@@ -63,6 +63,7 @@ cmake .. \
     -DWITH_PNGIMAGECONVERTER=ON \
     -DWITH_PNGIMPORTER=ON \
     -DWITH_STANFORDIMPORTER=ON \
+    -DWITH_STANFORDSCENECONVERTER=ON \
     -DWITH_STBIMAGECONVERTER=ON \
     -DWITH_STBIMAGEIMPORTER=ON \
     -DWITH_STBTRUETYPEFONT=ON \
@@ -29,8 +29,12 @@
 #include <cstring>
 #include <algorithm>
 #include <unordered_map>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
 
 #include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 
 #include <Magnum/Mesh.h>
@@ -48,6 +52,7 @@
 
 #include <MagnumPlugins/AnyImageImporter/AnyImageImporter.h>
 
+#include <assimp/config.h>
 #include <assimp/postprocess.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -64,14 +69,100 @@ template<> struct VectorConverter<3, Float, aiColor3D> {
 
 namespace Magnum { namespace Trade {
 
+namespace {
+
+/* Post-processing steps configurable in the [configuration/postprocess]
+   group, with values used when the option is not present (e.g. when the
+   plugin is instantiated without a plugin manager) */
+constexpr struct {
+    const char* name;
+    aiPostProcessSteps flag;
+    bool enabled;
+} PostprocessSteps[]{
+    /* Without aiProcess_JoinIdenticalVertices all meshes are deindexed (wtf?) */
+    {"JoinIdenticalVertices", aiProcess_JoinIdenticalVertices, true},
+    {"Triangulate", aiProcess_Triangulate, true},
+    {"GenNormals", aiProcess_GenNormals, false},
+    {"GenSmoothNormals", aiProcess_GenSmoothNormals, false},
+    {"SplitLargeMeshes", aiProcess_SplitLargeMeshes, false},
+    {"PreTransformVertices", aiProcess_PreTransformVertices, false},
+    {"ValidateDataStructure", aiProcess_ValidateDataStructure, false},
+    {"ImproveCacheLocality", aiProcess_ImproveCacheLocality, false},
+    {"RemoveRedundantMaterials", aiProcess_RemoveRedundantMaterials, false},
+    {"FixInfacingNormals", aiProcess_FixInfacingNormals, false},
+    {"SortByPType", aiProcess_SortByPType, true},
+    {"FindDegenerates", aiProcess_FindDegenerates, false},
+    {"FindInvalidData", aiProcess_FindInvalidData, false},
+    {"GenUVCoords", aiProcess_GenUVCoords, false},
+    {"TransformUVCoords", aiProcess_TransformUVCoords, false},
+    {"FindInstances", aiProcess_FindInstances, false},
+    {"OptimizeMeshes", aiProcess_OptimizeMeshes, false},
+    {"OptimizeGraph", aiProcess_OptimizeGraph, false},
+    {"FlipUVs", aiProcess_FlipUVs, false},
+    {"FlipWindingOrder", aiProcess_FlipWindingOrder, false}
+};
+
+/* Sets parameters of the post-processing steps on the importer and returns
+   the steps to apply */
+UnsignedInt setupPostprocess(Assimp::Importer& importer, const Utility::ConfigurationGroup& configuration) {
+    UnsignedInt steps = 0;
+    const Utility::ConfigurationGroup* const postprocess = configuration.group("postprocess");
+    for(const auto& step: PostprocessSteps) {
+        if((postprocess && postprocess->hasValue(step.name)) ? postprocess->value<bool>(step.name) : step.enabled)
+            steps |= step.flag;
+    }
+
+    if(configuration.hasValue("improveCacheLocalityCacheSize"))
+        importer.SetPropertyInteger(AI_CONFIG_PP_ICL_PTCACHE_SIZE, configuration.value<Int>("improveCacheLocalityCacheSize"));
+    if(configuration.hasValue("splitLargeMeshesVertexLimit"))
+        importer.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT, configuration.value<Int>("splitLargeMeshesVertexLimit"));
+    if(configuration.hasValue("splitLargeMeshesTriangleLimit"))
+        importer.SetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT, configuration.value<Int>("splitLargeMeshesTriangleLimit"));
+    if(configuration.hasValue("optimizeGraphExcludeList"))
+        importer.SetPropertyString(AI_CONFIG_PP_OG_EXCLUDE_LIST, configuration.value("optimizeGraphExcludeList"));
+
+    return steps;
+}
+
+UnsignedInt threadCount(const Utility::ConfigurationGroup& configuration) {
+    return configuration.hasValue("threadCount") ? configuration.value<UnsignedInt>("threadCount") : 1;
+}
+
+/* Copies face indices into a contiguous array, expecting all faces to have
+   exactly `size` indices */
+template<UnsignedInt size> void flattenIndices(const aiMesh& mesh, UnsignedInt* out) {
+    for(const aiFace& face: Containers::arrayView(mesh.mFaces, mesh.mNumFaces)) {
+        for(UnsignedInt i = 0; i != size; ++i) out[i] = face.mIndices[i];
+        out += size;
+    }
+}
+
+}
+
+/* Importers for images, one instance for each format reused for all images
+   of that format */
+struct AssimpImporter::ImageImporters {
+    std::unordered_map<std::string, std::unique_ptr<AbstractImporter>> embedded;
+    std::unique_ptr<AnyImageImporter> external;
+};
+
 struct AssimpImporter::File {
     std::string _filePath;
     Assimp::Importer _importer;
     const aiScene* _scene = nullptr;
     std::vector<aiNode*> _nodes;
+    /* Meshes of a node except the first one, exposed as additional child
+       objects of the node and indexed after all nodes */
+    std::vector<std::pair<const aiNode*, UnsignedInt>> _meshObjects;
     std::vector<std::pair<const aiMaterial*, aiTextureType>> _textures;
+    std::vector<UnsignedInt> _textureImages;
+    /* Unique images, either "*<index>" for embedded images or path to an
+       external file */
+    std::vector<std::string> _images;
+    ImageImporters _imageImporters;
 
     std::unordered_map<const aiNode*, UnsignedInt> _nodeIndices;
+    std::unordered_map<const aiNode*, UnsignedInt> _nodeMeshObjects;
     std::unordered_map<const aiNode*, std::pair<Trade::ObjectInstanceType3D, UnsignedInt>> _nodeInstances;
     std::unordered_map<std::string, UnsignedInt> _materialIndicesForName;
     std::unordered_map<const aiMaterial*, UnsignedInt> _textureIndices;
@@ -92,8 +183,7 @@ bool AssimpImporter::doIsOpened() const { return _f && _f->_scene; }
 void AssimpImporter::doOpenData(const Containers::ArrayView<const char> data) {
     if(!_f) {
         _f.reset(new File);
-        /* Without aiProcess_JoinIdenticalVertices all meshes are deindexed (wtf?) */
-        _f->_scene = _f->_importer.ReadFileFromMemory(data.data(), data.size(), aiProcess_Triangulate|aiProcess_SortByPType|aiProcess_JoinIdenticalVertices);
+        _f->_scene = _f->_importer.ReadFileFromMemory(data.data(), data.size(), setupPostprocess(_f->_importer, configuration()));
     }
 
     if(!_f->_scene) {
@@ -103,6 +193,9 @@ void AssimpImporter::doOpenData(const Containers::ArrayView<const char> data) {
     /* Fill hashmaps for index lookup for materials/textures/meshes/nodes */
     _f->_materialIndicesForName.reserve(_f->_scene->mNumMaterials);
 
+    /* Images shared by more textures are imported just once */
+    std::unordered_map<std::string, UnsignedInt> imageIndices;
+
     aiString matName;
     aiString texturePath;
     Int textureIndex = 0;
@@ -118,8 +211,13 @@ void AssimpImporter::doOpenData(const Containers::ArrayView<const char> data) {
         _f->_textureIndices[mat] = textureIndex;
         for(auto type: {aiTextureType_AMBIENT, aiTextureType_DIFFUSE, aiTextureType_SPECULAR}) {
             if(mat->Get(AI_MATKEY_TEXTURE(type, 0), texturePath) == AI_SUCCESS) {
-                std::string path = texturePath.C_Str();
+                const std::string path = texturePath.C_Str();
+                std::string image = path[0] == '*' ? path : Utility::Directory::join(_f->_filePath, path);
+                auto found = imageIndices.emplace(image, _f->_images.size());
+                if(found.second) _f->_images.push_back(std::move(image));
+
                 _f->_textures.emplace_back(mat, type);
+                _f->_textureImages.push_back(found.first->second);
                 ++textureIndex;
             }
         }
@@ -143,10 +241,18 @@ void AssimpImporter::doOpenData(const Containers::ArrayView<const char> data) {
         Containers::ArrayView<aiNode*> children(node->mChildren, node->mNumChildren);
         _f->_nodes.insert(_f->_nodes.end(), children.begin(), children.end());
 
-        if(node->mNumMeshes > 0) {
-            /** @todo: Support multiple meshes per node */
+        if(node->mNumMeshes > 0)
             _f->_nodeInstances[node] = {ObjectInstanceType3D::Mesh, node->mMeshes[0]};
-        }
+    }
+
+    /* Remaining meshes of each node get an object of their own, with IDs
+       following all nodes */
+    for(const aiNode* node: _f->_nodes) {
+        if(node->mNumMeshes < 2) continue;
+
+        _f->_nodeMeshObjects[node] = _f->_nodes.size() + _f->_meshObjects.size();
+        for(UnsignedInt i = 1; i != node->mNumMeshes; ++i)
+            _f->_meshObjects.emplace_back(node, i);
     }
 
     for(std::size_t i = 0; i < _f->_scene->mNumCameras; ++i) {
@@ -174,8 +280,7 @@ void AssimpImporter::doOpenState(const void* state, const std::string& filePath)
 
 void AssimpImporter::doOpenFile(const std::string& filename) {
     _f.reset(new File);
-    /* Without aiProcess_JoinIdenticalVertices all meshes are deindexed (wtf?) */
-    _f->_scene = _f->_importer.ReadFile(filename, aiProcess_Triangulate|aiProcess_SortByPType|aiProcess_JoinIdenticalVertices);
+    _f->_scene = _f->_importer.ReadFile(filename, setupPostprocess(_f->_importer, configuration()));
     _f->_filePath = Utility::Directory::path(filename);
 
     doOpenData({});
@@ -212,7 +317,7 @@ Containers::Optional<CameraData> AssimpImporter::doCamera(UnsignedInt id) {
 }
 
 UnsignedInt AssimpImporter::doObject3DCount() const {
-    return _f->_nodes.size();
+    return _f->_nodes.size() + _f->_meshObjects.size();
 }
 
 Int AssimpImporter::doObject3DForName(const std::string& name) {
@@ -221,18 +326,37 @@ Int AssimpImporter::doObject3DForName(const std::string& name) {
 }
 
 std::string AssimpImporter::doObject3DName(const UnsignedInt id) {
+    /* Additional mesh objects are named after their node */
+    if(id >= _f->_nodes.size())
+        return _f->_meshObjects[id - _f->_nodes.size()].first->mName.C_Str();
+
     return _f->_nodes[id]->mName.C_Str();
 }
 
 std::unique_ptr<ObjectData3D> AssimpImporter::doObject3D(const UnsignedInt id) {
+    /* Additional mesh object, having no children and identity
+       transformation relative to its node */
+    if(id >= _f->_nodes.size()) {
+        const aiNode* node;
+        UnsignedInt meshInNode;
+        std::tie(node, meshInNode) = _f->_meshObjects[id - _f->_nodes.size()];
+        const UnsignedInt index = node->mMeshes[meshInNode];
+        return std::unique_ptr<MeshObjectData3D>(new MeshObjectData3D({}, Matrix4{}, index, _f->_scene->mMeshes[index]->mMaterialIndex, node));
+    }
+
     /** @todo support for bone nodes */
     const aiNode* node = _f->_nodes[id];
 
-    /* Gather child indices */
+    /* Gather child indices, followed by objects for additional meshes */
     std::vector<UnsignedInt> children;
-    children.reserve(node->mNumChildren);
+    children.reserve(node->mNumChildren + (node->mNumMeshes > 1 ? node->mNumMeshes - 1 : 0));
     for(auto child: Containers::arrayView(node->mChildren, node->mNumChildren))
         children.push_back(_f->_nodeIndices[child]);
+    if(node->mNumMeshes > 1) {
+        const UnsignedInt first = _f->_nodeMeshObjects[node];
+        for(UnsignedInt i = 0; i != node->mNumMeshes - 1; ++i)
+            children.push_back(first + i);
+    }
 
     const Matrix4 transformation = Matrix4::from(reinterpret_cast<const float*>(&node->mTransformation));
 
@@ -285,34 +409,34 @@ Containers::Optional<MeshData3D> AssimpImporter::doMesh3D(const UnsignedInt id)
 
     /* Primitive */
     MeshPrimitive primitive;
+    UnsignedInt faceSize;
     if(mesh->mPrimitiveTypes == aiPrimitiveType_POINT) {
         primitive = MeshPrimitive::Points;
+        faceSize = 1;
     } else if(mesh->mPrimitiveTypes == aiPrimitiveType_LINE) {
         primitive = MeshPrimitive::Lines;
+        faceSize = 2;
     } else if(mesh->mPrimitiveTypes == aiPrimitiveType_TRIANGLE) {
         primitive = MeshPrimitive::Triangles;
+        faceSize = 3;
     } else {
         Error() << "Trade::AssimpImporter::mesh3D(): unsupported aiPrimitiveType" << mesh->mPrimitiveTypes;
         return Containers::NullOpt;
     }
 
-    /* Mesh data */
-    std::vector<std::vector<Vector3>> positions{{}};
-    std::vector<std::vector<Vector2>> textureCoordinates;
-    std::vector<std::vector<Vector3>> normals;
-    std::vector<std::vector<Color4>> colors;
-
-    /* Import positions */
-    auto vertexArray = Containers::arrayCast<Vector3>(Containers::arrayView(mesh->mVertices, mesh->mNumVertices));
-    positions.front().assign(vertexArray.begin(), vertexArray.end());
+    /* Positions, normals and colors have the same layout in Assimp, so
+       these are copied in bulk */
+    auto vertexArray = Containers::arrayCast<const Vector3>(Containers::arrayView(mesh->mVertices, mesh->mNumVertices));
+    std::vector<std::vector<Vector3>> positions;
+    positions.emplace_back(vertexArray.begin(), vertexArray.end());
 
+    std::vector<std::vector<Vector3>> normals;
     if(mesh->HasNormals()) {
-        normals.emplace_back();
-        auto normalArray = Containers::arrayCast<Vector3>(Containers::arrayView(mesh->mNormals, mesh->mNumVertices));
-        normals.front().assign(normalArray.begin(), normalArray.end());
+        auto normalArray = Containers::arrayCast<const Vector3>(Containers::arrayView(mesh->mNormals, mesh->mNumVertices));
+        normals.emplace_back(normalArray.begin(), normalArray.end());
     }
 
-    /** @todo only first uv layer (or "channel") supported) */
+    std::vector<std::vector<Vector2>> textureCoordinates;
     textureCoordinates.reserve(mesh->GetNumUVChannels());
     for(std::size_t layer = 0; layer < mesh->GetNumUVChannels(); ++layer) {
         if(mesh->mNumUVComponents[layer] != 2) {
@@ -321,34 +445,30 @@ Containers::Optional<MeshData3D> AssimpImporter::doMesh3D(const UnsignedInt id)
             continue;
         }
 
-        textureCoordinates.emplace_back();
-        auto& texCoords = textureCoordinates[layer];
-        texCoords.reserve(mesh->mNumVertices);
-        for(std::size_t i = 0; i < mesh->mNumVertices; ++i) {
+        /* Texture coordinates are stored as three-component vectors in
+           Assimp, so these have to be copied one by one */
+        textureCoordinates.emplace_back(mesh->mNumVertices);
+        Vector2* const out = textureCoordinates.back().data();
+        const aiVector3D* const in = mesh->mTextureCoords[layer];
+        for(std::size_t i = 0; i != mesh->mNumVertices; ++i) {
             /* GCC 4.7 has a problem with .x/.y here */
-            texCoords.emplace_back(mesh->mTextureCoords[layer][i][0], mesh->mTextureCoords[layer][i][1]);
+            out[i] = {in[i][0], in[i][1]};
         }
     }
 
+    std::vector<std::vector<Color4>> colors;
     colors.reserve(mesh->GetNumColorChannels());
     for(std::size_t layer = 0; layer < mesh->GetNumColorChannels(); ++layer) {
-        colors.emplace_back();
-        auto colorArray = Containers::arrayCast<Color4>(Containers::arrayView(mesh->mColors[layer], mesh->mNumVertices));
-        colors[layer].assign(colorArray.begin(), colorArray.end());
+        auto colorArray = Containers::arrayCast<const Color4>(Containers::arrayView(mesh->mColors[layer], mesh->mNumVertices));
+        colors.emplace_back(colorArray.begin(), colorArray.end());
     }
 
-    /* Import indices */
-    std::vector<UnsignedInt> indices;
-    indices.reserve(mesh->mNumFaces*3);
-
-    for(std::size_t faceIndex = 0; faceIndex < mesh->mNumFaces; ++faceIndex) {
-        const aiFace& face = mesh->mFaces[faceIndex];
-
-        CORRADE_ASSERT(face.mNumIndices <= 3, "Trade::AssimpImporter::mesh3D(): triangulation while loading should have ensured <= 3 vertices per primitive", {});
-        for(std::size_t i = 0; i < face.mNumIndices; ++i) {
-            indices.push_back(face.mIndices[i]);
-        }
-    }
+    /* Import indices. The mesh is triangulated and contains just one
+       primitive type, so all faces have the same index count. */
+    std::vector<UnsignedInt> indices(mesh->mNumFaces*faceSize);
+    if(faceSize == 1) flattenIndices<1>(*mesh, indices.data());
+    else if(faceSize == 2) flattenIndices<2>(*mesh, indices.data());
+    else flattenIndices<3>(*mesh, indices.data());
 
     return MeshData3D(primitive, std::move(indices), std::move(positions), std::move(normals), std::move(textureCoordinates), std::move(colors), mesh);
 }
@@ -452,25 +572,70 @@ Containers::Optional<TextureData> AssimpImporter::doTexture(const UnsignedInt id
 
     return TextureData{TextureData::Type::Texture2D,
         Sampler::Filter::Linear, Sampler::Filter::Linear, Sampler::Mipmap::Linear,
-        {wrappingU, wrappingV, Sampler::Wrapping::ClampToEdge}, id, &_f->_textures[id]};
+        {wrappingU, wrappingV, Sampler::Wrapping::ClampToEdge}, _f->_textureImages[id], &_f->_textures[id]};
 }
 
-UnsignedInt AssimpImporter::doImage2DCount() const { return _f->_textures.size(); }
+UnsignedInt AssimpImporter::doImage2DCount() const { return _f->_images.size(); }
 
 Containers::Optional<ImageData2D> AssimpImporter::doImage2D(const UnsignedInt id) {
     CORRADE_ASSERT(manager(), "Trade::AssimpImporter::image2D(): the plugin must be instantiated with access to plugin manager in order to open image files", {});
 
-    const aiMaterial* mat;
-    aiTextureType type;
-    std::tie(mat, type) = _f->_textures[id];
+    AbstractImporter* importer = openImage(id, _f->_imageImporters);
+    if(!importer) return Containers::NullOpt;
 
-    aiString texturePath;
-    if(mat->Get(AI_MATKEY_TEXTURE(type, 0), texturePath) != AI_SUCCESS) {
-        Error() << "Trade::AssimpImporter::image2D(): error getting path for texture" << id;
-        return Containers::NullOpt;
+    /* Close the importer right after so it doesn't keep the data around */
+    Containers::Optional<ImageData2D> image = importer->image2D(0);
+    importer->close();
+    return image;
+}
+
+std::vector<Containers::Optional<ImageData2D>> AssimpImporter::images2D() {
+    CORRADE_ASSERT(isOpened(), "Trade::AssimpImporter::images2D(): no file opened", {});
+    CORRADE_ASSERT(manager(), "Trade::AssimpImporter::images2D(): the plugin must be instantiated with access to plugin manager in order to open image files", {});
+
+    std::vector<Containers::Optional<ImageData2D>> out(_f->_images.size());
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    UnsignedInt threadCount = Trade::threadCount(configuration());
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    threadCount = std::min(threadCount, UnsignedInt(out.size()));
+    if(threadCount > 1) {
+        /* The plugin manager is not thread-safe, so the images are opened
+           and closed serially in batches and only decoded in parallel. Each
+           thread has its own set of importers, reused for all batches. */
+        std::vector<ImageImporters> importers(threadCount);
+        std::vector<AbstractImporter*> opened(threadCount);
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount);
+        for(std::size_t batch = 0; batch < out.size(); batch += threadCount) {
+            const std::size_t count = std::min(std::size_t(threadCount), out.size() - batch);
+            for(std::size_t i = 0; i != count; ++i)
+                opened[i] = openImage(batch + i, importers[i]);
+
+            for(std::size_t i = 0; i != count; ++i) if(opened[i])
+                threads.emplace_back([&out, &opened, batch, i]() {
+                    out[batch + i] = opened[i]->image2D(0);
+                });
+            for(std::thread& thread: threads) thread.join();
+            threads.clear();
+
+            for(std::size_t i = 0; i != count; ++i)
+                if(opened[i]) opened[i]->close();
+        }
+
+        return out;
     }
+    #endif
+
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = doImage2D(i);
+
+    return out;
+}
+
+AbstractImporter* AssimpImporter::openImage(const UnsignedInt id, ImageImporters& importers) {
+    const std::string& path = _f->_images[id];
 
-    std::string path = texturePath.C_Str();
     /* If path is prefixed with '*', load embedded texture */
     if(path[0] == '*') {
         char* err;
@@ -480,12 +645,12 @@ Containers::Optional<ImageData2D> AssimpImporter::doImage2D(const UnsignedInt id
         const Int index = Int(std::strtol(str, &err, 10));
         if(err == nullptr || err == str) {
             Error() << "Trade::AssimpImporter::image2D(): embedded texture path did not contain a valid integer string";
-            return Containers::NullOpt;
+            return nullptr;
         }
 
         const aiTexture* texture = _f->_scene->mTextures[index];
         if(texture->mHeight == 0) {
-            /* Compressed image data */
+            /* Compressed image data, passed to the importer directly */
             auto textureData = Containers::ArrayView<const char>(reinterpret_cast<const char*>(texture->pcData), texture->mWidth);
 
             std::string importerName;
@@ -499,29 +664,30 @@ Containers::Optional<ImageData2D> AssimpImporter::doImage2D(const UnsignedInt id
                 importerName = "PngImporter";
             } else {
                 Error() << "Trade::AssimpImporter::image2D(): could not detect filetype of embedded data";
-                return Containers::NullOpt;
+                return nullptr;
             }
 
-            std::unique_ptr<Trade::AbstractImporter> importer = manager()->loadAndInstantiate(importerName);
+            std::unique_ptr<AbstractImporter>& importer = importers.embedded[importerName];
+            if(!importer) importer = manager()->loadAndInstantiate(importerName);
             if(!importer) {
                 Error() << "Trade::AssimpImporter::image2D(): could not find importer for embedded data";
-                return Containers::NullOpt;
+                return nullptr;
             }
 
-            importer->openData(textureData);
-            return importer->image2D(0);
+            if(!importer->openData(textureData)) return nullptr;
+            return importer.get();
 
         /* Uncompressed image data */
         } else {
             Error() << "Trade::AssimpImporter::image2D(): uncompressed embedded image data is not supported";
-            return Containers::NullOpt;
+            return nullptr;
         }
 
     /* Load external texture */
     } else {
-        AnyImageImporter importer{*manager()};
-        importer.openFile(Utility::Directory::join(_f->_filePath, path));
-        return importer.image2D(0);
+        if(!importers.external) importers.external.reset(new AnyImageImporter{*manager()});
+        if(!importers.external->openFile(path)) return nullptr;
+        return importers.external.get();
     }
 }
 
@@ -30,6 +30,7 @@
  * @brief Class @ref Magnum::Trade::AssimpImporter
  */
 
+#include <vector>
 #include <Magnum/Trade/AbstractImporter.h>
 #include <Magnum/Trade/ObjectData3D.h>
 
@@ -127,7 +128,11 @@ information.
 
 @subsection Trade-AssimpImporter-limitations-meshes Mesh import
 
--   Only the first mesh of a `aiNode` is loaded
+-   If an `aiNode` references more than one mesh, the first mesh is assigned
+    to the object corresponding to the node and each of the remaining meshes
+    is exposed as an additional object. These objects are listed after all
+    objects corresponding to nodes, are children of the node object, have
+    the same name and an identity transformation.
 -   Only triangle meshes are loaded
 -   Texture coordinate layers with other than two components are skipped
 
@@ -146,6 +151,50 @@ information.
 
 -   Not supported
 
+@section Trade-AssimpImporter-images Image import
+
+Images are deduplicated when opening the file, so textures that reference
+the same embedded image or the same external file share a single image ID
+and the image is decoded only once. External files are compared by their
+path relative to the opened file, without further normalization.
+
+Embedded images are passed to a plugin chosen based on their format,
+external images are opened using @ref AnyImageImporter. The importer keeps
+one instance of each of these plugins for the whole time the file is opened
+and reuses it for all images of given format.
+
+All images in the file can be imported at once using @ref images2D(), which
+is available when using the plugin class directly, for example when linking
+it statically. By default the images are decoded serially. Parallel decoding
+is enabled by setting the @cb{.ini} threadCount @ce option in the
+@cb{.ini} [configuration] @ce group of the plugin configuration to a value
+other than @cpp 1 @ce, which is documented in the `AssimpImporter.conf` file.
+As the plugin manager is not thread-safe, the images are then opened serially
+and only decoded in parallel, each thread having its own set of plugin
+instances.
+
+@attention Parallel decoding is safe only if all image plugins used for the
+    file are thread-safe. That's not the case for example with
+    @ref DevIlImageImporter, which decodes into a global DevIL image, or with
+    @ref StbImageImporter, which sets global decoder state --- with these
+    providing the image format, decoding in parallel leads to corrupted images
+    or crashes.
+
+@section Trade-AssimpImporter-postprocess Post-processing
+
+Assimp post-processing steps applied when opening a file are controlled by
+the @cb{.ini} [configuration/postprocess] @ce group of the plugin
+configuration, with options named after the `aiProcess_*` flags. By default
+only `aiProcess_JoinIdenticalVertices`, `aiProcess_Triangulate` and
+`aiProcess_SortByPType` are enabled, as the importer supports only meshes
+with a single primitive type. Enabling for example
+`aiProcess_ImproveCacheLocality`, `aiProcess_OptimizeMeshes` or
+`aiProcess_SplitLargeMeshes` produces meshes optimized for rendering at the
+cost of longer import times. Parameters of these steps are set through
+options in the @cb{.ini} [configuration] @ce group. All options are
+documented in the `AssimpImporter.conf` file and are read when the file is
+opened.
+
 @section Trade-AssimpImporter-state Access to internal importer state
 
 The Assimp structures used to import data from a file can be accessed through
@@ -191,8 +240,21 @@ class MAGNUM_TRADE_ASSIMPIMPORTER_EXPORT AssimpImporter: public AbstractImporter
 
         ~AssimpImporter();
 
+        /**
+         * @brief Import all images
+         *
+         * Expects that a file is opened and that the plugin was instantiated
+         * with access to plugin manager. Returns the same as calling
+         * @ref image2D() for all IDs in range [0, @ref image2DCount()), with
+         * @ref Containers::NullOpt for images that failed to import, but
+         * the images can be decoded in parallel. See
+         * @ref Trade-AssimpImporter-images for more information.
+         */
+        std::vector<Containers::Optional<ImageData2D>> images2D();
+
     private:
         struct File;
+        struct ImageImporters;
 
         MAGNUM_TRADE_ASSIMPIMPORTER_LOCAL Features doFeatures() const override;
 
@@ -233,6 +295,10 @@ class MAGNUM_TRADE_ASSIMPIMPORTER_EXPORT AssimpImporter: public AbstractImporter
 
         MAGNUM_TRADE_ASSIMPIMPORTER_LOCAL const void* doImporterState() const override;
 
+        /* Open image in an importer taken from the set, returns nullptr on
+           failure */
+        MAGNUM_TRADE_ASSIMPIMPORTER_LOCAL AbstractImporter* openImage(UnsignedInt id, ImageImporters& importers);
+
         std::unique_ptr<File> _f;
 };
 
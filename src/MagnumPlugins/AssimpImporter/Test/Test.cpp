@@ -31,6 +31,7 @@
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/Mesh.h>
 #include <Magnum/Math/Vector3.h>
@@ -85,10 +86,15 @@ struct AssimpImporterTest: public TestSuite::Tester {
     void mesh();
     void pointMesh();
     void lineMesh();
+    void meshMultiplePerNode();
+    void meshPostprocess();
+    void meshPostprocessNoTriangulate();
 
     void scene();
     void texture();
     void embeddedTexture();
+    void images2D();
+    void images2DSequential();
 
     void openState();
     void openStateTexture();
@@ -111,10 +117,15 @@ AssimpImporterTest::AssimpImporterTest() {
               &AssimpImporterTest::mesh,
               &AssimpImporterTest::pointMesh,
               &AssimpImporterTest::lineMesh,
+              &AssimpImporterTest::meshMultiplePerNode,
+              &AssimpImporterTest::meshPostprocess,
+              &AssimpImporterTest::meshPostprocessNoTriangulate,
 
               &AssimpImporterTest::scene,
               &AssimpImporterTest::texture,
               &AssimpImporterTest::embeddedTexture,
+              &AssimpImporterTest::images2D,
+              &AssimpImporterTest::images2DSequential,
 
               &AssimpImporterTest::openState,
               &AssimpImporterTest::openStateTexture});
@@ -307,6 +318,81 @@ void AssimpImporterTest::lineMesh() {
     CORRADE_COMPARE(meshObject->instance(), 0);
 }
 
+void AssimpImporterTest::meshMultiplePerNode() {
+    AssimpImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(ASSIMPIMPORTER_TEST_DIR, "mesh-multiple.dae")));
+
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+
+    Containers::Optional<Trade::MeshData3D> triangle = importer.mesh3D(0);
+    CORRADE_VERIFY(triangle);
+    CORRADE_COMPARE(triangle->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(triangle->positions(0).size(), 3);
+    CORRADE_COMPARE(triangle->indices().size(), 3);
+
+    /* The quad gets triangulated */
+    Containers::Optional<Trade::MeshData3D> quad = importer.mesh3D(1);
+    CORRADE_VERIFY(quad);
+    CORRADE_COMPARE(quad->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(quad->positions(0).size(), 4);
+    CORRADE_COMPARE(quad->indices().size(), 6);
+
+    /* Root, the node with both meshes, its child and an additional object
+       for the second mesh */
+    CORRADE_COMPARE(importer.object3DCount(), 4);
+
+    std::unique_ptr<Trade::ObjectData3D> node = importer.object3D(1);
+    CORRADE_COMPARE(node->instanceType(), ObjectInstanceType3D::Mesh);
+    CORRADE_COMPARE(node->instance(), 0);
+    CORRADE_COMPARE(node->children(), (std::vector<UnsignedInt>{2, 3}));
+    CORRADE_COMPARE(node->transformation(), Matrix4::translation({1.0f, 2.0f, 3.0f}));
+
+    std::unique_ptr<Trade::ObjectData3D> child = importer.object3D(2);
+    CORRADE_COMPARE(child->instanceType(), ObjectInstanceType3D::Empty);
+    CORRADE_COMPARE(importer.object3DName(2), "Child");
+
+    std::unique_ptr<Trade::ObjectData3D> second = importer.object3D(3);
+    CORRADE_COMPARE(second->instanceType(), ObjectInstanceType3D::Mesh);
+    CORRADE_COMPARE(second->instance(), 1);
+    CORRADE_COMPARE(second->children(), std::vector<UnsignedInt>{});
+    CORRADE_COMPARE(second->transformation(), Matrix4());
+    CORRADE_COMPARE(importer.object3DName(3), "Node");
+
+    /* The node name maps to the node object */
+    CORRADE_COMPARE(importer.object3DForName("Node"), 1);
+}
+
+void AssimpImporterTest::meshPostprocess() {
+    AssimpImporter importer;
+    Utility::ConfigurationGroup& postprocess = *importer.configuration().addGroup("postprocess");
+    postprocess.setValue("ImproveCacheLocality", true);
+    postprocess.setValue("FindInstances", true);
+    importer.configuration().setValue("improveCacheLocalityCacheSize", 8);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(ASSIMPIMPORTER_TEST_DIR, "mesh-multiple.dae")));
+
+    /* Default steps are still applied when not overridden */
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+    Containers::Optional<Trade::MeshData3D> quad = importer.mesh3D(1);
+    CORRADE_VERIFY(quad);
+    CORRADE_COMPARE(quad->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(quad->positions(0).size(), 4);
+    CORRADE_COMPARE(quad->indices().size(), 6);
+}
+
+void AssimpImporterTest::meshPostprocessNoTriangulate() {
+    AssimpImporter importer;
+    importer.configuration().addGroup("postprocess")->setValue("Triangulate", false);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(ASSIMPIMPORTER_TEST_DIR, "mesh-multiple.dae")));
+
+    /* The triangle is imported fine, the quad is left as a polygon */
+    CORRADE_VERIFY(importer.mesh3D(0));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.mesh3D(1));
+    CORRADE_COMPARE(out.str(), "Trade::AssimpImporter::mesh3D(): unsupported aiPrimitiveType 8\n");
+}
+
 void AssimpImporterTest::scene() {
     AssimpImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(ASSIMPIMPORTER_TEST_DIR, "scene.dae")));
@@ -406,6 +492,98 @@ void AssimpImporterTest::embeddedTexture() {
         '\xb3', '\x69', '\x00', '\xff'
     };
     CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels), TestSuite::Compare::Container);
+
+    /* Importing again reuses the PngImporter instance */
+    Containers::Optional<Trade::ImageData2D> again = importer.image2D(0);
+    CORRADE_VERIFY(again);
+    CORRADE_COMPARE_AS(again->data(), Containers::arrayView(pixels), TestSuite::Compare::Container);
+}
+
+void AssimpImporterTest::images2D() {
+    const UnsignedInt version = aiGetVersionMajor()*100 + aiGetVersionMinor();
+    /* @todo Possibly works with earlier versions (definitely not 3.0) */
+    if(version < 302)
+        CORRADE_SKIP("Current version of assimp would SEGFAULT on this test.");
+
+    PluginManager::Manager<AbstractImporter> manager{MAGNUM_PLUGINS_IMPORTER_DIR};
+
+    if(manager.loadState("PngImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("PngImporter plugin not found, cannot test");
+
+    AssimpImporter importer{manager};
+    importer.configuration().setValue("threadCount", 2);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(ASSIMPIMPORTER_TEST_DIR, "textures.dae")));
+
+    /* Three textures in two materials, the first two referencing the same
+       file */
+    CORRADE_COMPARE(importer.textureCount(), 3);
+    CORRADE_COMPARE(importer.image2DCount(), 2);
+    Containers::Optional<Trade::TextureData> diffuse = importer.texture(0);
+    Containers::Optional<Trade::TextureData> diffuseAgain = importer.texture(1);
+    Containers::Optional<Trade::TextureData> specular = importer.texture(2);
+    CORRADE_VERIFY(diffuse);
+    CORRADE_VERIFY(diffuseAgain);
+    CORRADE_VERIFY(specular);
+    CORRADE_COMPARE(diffuse->image(), 0);
+    CORRADE_COMPARE(diffuseAgain->image(), 0);
+    CORRADE_COMPARE(specular->image(), 1);
+
+    const char pixels[] = {
+        '\xb3', '\x69', '\x00', '\xff'
+    };
+
+    /* Both images decoded on two threads */
+    std::vector<Containers::Optional<Trade::ImageData2D>> images = importer.images2D();
+    CORRADE_COMPARE(images.size(), 2);
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        CORRADE_VERIFY(images[i]);
+        CORRADE_COMPARE(images[i]->size(), Vector2i{1});
+        CORRADE_COMPARE_AS(images[i]->data(), Containers::arrayView(pixels), TestSuite::Compare::Container);
+    }
+
+    /* Importing one by one reuses the same importer instance */
+    for(UnsignedInt i = 0; i != importer.image2DCount(); ++i) {
+        Containers::Optional<Trade::ImageData2D> image = importer.image2D(i);
+        CORRADE_VERIFY(image);
+        CORRADE_COMPARE_AS(image->data(), Containers::arrayView(pixels), TestSuite::Compare::Container);
+    }
+}
+
+void AssimpImporterTest::images2DSequential() {
+    const UnsignedInt version = aiGetVersionMajor()*100 + aiGetVersionMinor();
+    /* @todo Possibly works with earlier versions (definitely not 3.0) */
+    if(version < 302)
+        CORRADE_SKIP("Current version of assimp would SEGFAULT on this test.");
+
+    PluginManager::Manager<AbstractImporter> manager{MAGNUM_PLUGINS_IMPORTER_DIR};
+
+    if(manager.loadState("PngImporter") == PluginManager::LoadState::NotFound)
+        CORRADE_SKIP("PngImporter plugin not found, cannot test");
+
+    /* Default configuration, decoding on a single thread */
+    AssimpImporter importer{manager};
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(ASSIMPIMPORTER_TEST_DIR, "textures.dae")));
+    CORRADE_COMPARE(importer.image2DCount(), 2);
+
+    const char pixels[] = {
+        '\xb3', '\x69', '\x00', '\xff'
+    };
+
+    std::vector<Containers::Optional<Trade::ImageData2D>> images = importer.images2D();
+    CORRADE_COMPARE(images.size(), 2);
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        CORRADE_VERIFY(images[i]);
+        CORRADE_COMPARE(images[i]->size(), Vector2i{1});
+        CORRADE_COMPARE_AS(images[i]->data(), Containers::arrayView(pixels), TestSuite::Compare::Container);
+    }
+
+    /* Calling it again reuses the importer instances */
+    images = importer.images2D();
+    CORRADE_COMPARE(images.size(), 2);
+    for(std::size_t i = 0; i != images.size(); ++i) {
+        CORRADE_VERIFY(images[i]);
+        CORRADE_COMPARE_AS(images[i]->data(), Containers::arrayView(pixels), TestSuite::Compare::Container);
+    }
 }
 
 void AssimpImporterTest::openState() {
@@ -25,12 +25,16 @@
 
 #include "ColladaImporter.h"
 
+#include <algorithm>
+#include <cstring>
 #include <unordered_map>
-#include <QtCore/QCoreApplication>
-#include <QtCore/QFile>
-#include <QtCore/QStringList>
-#include <QtXmlPatterns/QXmlQuery>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <atomic>
+#include <thread>
+#endif
+#include <Corrade/Containers/Array.h>
 #include <Corrade/PluginManager/Manager.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/Mesh.h>
 #include <Magnum/Math/Constants.h>
@@ -45,12 +49,52 @@
 #include "MagnumPlugins/AnyImageImporter/AnyImageImporter.h"
 #include "MagnumPlugins/ColladaImporter/ColladaType.h"
 #include "MagnumPlugins/ColladaImporter/Utility.h"
+#include "MagnumPlugins/ColladaImporter/Xml.h"
 
 namespace Magnum { namespace Trade {
 
+using Implementation::XmlDocument;
+
 struct ColladaImporter::Document {
+    /* Float array, the contents are converted from the file data on first
+       access */
+    struct FloatArray {
+        std::size_t element;
+        bool converted;
+        std::vector<Float> data;
+    };
+
+    /* A <triangles>, <polylist> or <polygons> element, all converted to a
+       list of vertex counts and interleaved index arrays */
+    struct Primitives {
+        std::size_t element;
+        UnsignedInt stride;
+        std::vector<UnsignedInt> vertexCountPerFace,
+            interleavedIndexArrays;
+    };
+
+    /* Primitive groups of a mesh, the index arrays are converted from the
+       file data on first access */
+    struct Mesh {
+        bool converted;
+        std::vector<Primitives> primitives;
+    };
+
+    /* Converted contents of given float array */
+    const std::vector<Float>& floatArray(FloatArray& array, UnsignedInt threadCount);
+
+    /* Primitive groups of given mesh with converted index arrays */
+    const Mesh& mesh(UnsignedInt id, UnsignedInt threadCount);
+
     std::string filename;
 
+    /* Count of threads for converting large arrays */
+    UnsignedInt threadCount;
+
+    /* File contents, referenced by the parsed XML document */
+    Containers::Array<char> data;
+    XmlDocument xml;
+
     /* Data */
     /** @todo Camera, light names, deduplicate the relevant code */
     std::vector<std::string> scenes,
@@ -60,6 +104,17 @@ struct ColladaImporter::Document {
         textures,
         images2D;
 
+    /* XML elements corresponding to the above */
+    std::vector<std::size_t> sceneElements,
+        objectElements,
+        meshElements,
+        materialElements,
+        textureElements,
+        image2DElements;
+
+    /* Primitive groups of all meshes */
+    std::vector<Mesh> meshPrimitives;
+
     /** @todo Make public use for camerasForName, lightsForName */
     std::unordered_map<std::string, UnsignedInt> camerasForName,
         lightsForName,
@@ -70,157 +125,285 @@ struct ColladaImporter::Document {
         texturesForName,
         images2DForName;
 
-    QXmlQuery query;
+    /* Elements referenced by ID or SID from elsewhere in the document */
+    std::unordered_map<std::string, std::size_t> sourcesForId,
+        verticesForId,
+        effectsForId,
+        surfacesForSid;
+
+    /* All float arrays */
+    std::unordered_map<std::string, FloatArray> floatArraysForId;
+
+    std::string defaultScene;
 };
 
-const QString ColladaImporter::namespaceDeclaration =
-    "declare default element namespace \"http://www.collada.org/2005/11/COLLADASchema\";\n";
+namespace {
+
+inline bool startsWith(const Containers::ArrayView<const char> string, const char* const prefix) {
+    const std::size_t size = std::strlen(prefix);
+    return string.size() >= size && std::memcmp(string.data(), prefix, size) == 0;
+}
+
+/* Element name, empty if there's no such element */
+std::string name(const XmlDocument& xml, const std::size_t element) {
+    if(element == XmlDocument::NoElement) return {};
+    const Containers::ArrayView<const char> name = xml.element(element).name;
+    return {name.data(), name.size()};
+}
+
+/* Element text, empty if there's no such element */
+std::string text(const XmlDocument& xml, const std::size_t element) {
+    return element == XmlDocument::NoElement ? std::string{} : xml.text(element);
+}
+
+/* Raw element text for numeric arrays, which contain no entities, empty if
+   there's no such element */
+Containers::ArrayView<const char> rawText(const XmlDocument& xml, const std::size_t element) {
+    return element == XmlDocument::NoElement ? nullptr : xml.element(element).text;
+}
+
+/* Attribute value with the leading # stripped */
+std::string reference(const XmlDocument& xml, const std::size_t element, const char* const attribute) {
+    if(element == XmlDocument::NoElement) return {};
+    const std::string value = xml.attributeString(element, attribute);
+    return value.empty() ? value : value.substr(1);
+}
+
+UnsignedInt unsignedIntAttribute(const XmlDocument& xml, const std::size_t element, const char* const attribute) {
+    if(element == XmlDocument::NoElement) return 0;
+    return Implementation::ColladaType<UnsignedInt>::fromString(xml.attributeString(element, attribute));
+}
+
+/* First child with name starting with given prefix */
+std::size_t firstChildWithPrefix(const XmlDocument& xml, const std::size_t element, const char* const prefix) {
+    for(std::size_t i = xml.firstChild(element); i != XmlDocument::NoElement; i = xml.nextSibling(i))
+        if(startsWith(xml.element(i).name, prefix)) return i;
+
+    return XmlDocument::NoElement;
+}
+
+/* N-th <input> child with given semantic */
+std::size_t input(const XmlDocument& xml, const std::size_t element, const char* const semantic, UnsignedInt id = 0) {
+    for(std::size_t i = xml.firstChild(element, "input"); i != XmlDocument::NoElement; i = xml.nextSibling(i, "input"))
+        if(xml.attributeString(i, "semantic") == semantic && !id--) return i;
+
+    return XmlDocument::NoElement;
+}
+
+/* Importer instantiated without a plugin manager has an empty configuration,
+   use the default in that case */
+UnsignedInt threadCount(const Utility::ConfigurationGroup& configuration) {
+    return configuration.hasValue("threadCount") ? configuration.value<UnsignedInt>("threadCount") : 0;
+}
+
+/* Gather children with given name that have an ID */
+void gatherIds(const XmlDocument& xml, const std::size_t library, const char* const child, std::vector<std::string>* const names, std::vector<std::size_t>* const elements, std::unordered_map<std::string, UnsignedInt>& namesForId) {
+    for(std::size_t i = xml.firstChild(library, child); i != XmlDocument::NoElement; i = xml.nextSibling(i, child)) {
+        std::string id = xml.attributeString(i, "id");
+        if(id.empty()) continue;
 
-/** @todo use init()/fini() for this */
-/** @todo somehow delegating constructors for this? */
-ColladaImporter::ColladaImporter(): d(nullptr), zero(0), app(qApp ? nullptr : new QCoreApplication(zero, nullptr)) {}
+        if(names) names->push_back(id);
+        if(elements) elements->push_back(i);
+        namesForId.emplace(std::move(id), namesForId.size());
+    }
+}
+
+}
 
-ColladaImporter::ColladaImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager}, d(nullptr), zero(0), app(qApp ? nullptr : new QCoreApplication(zero, nullptr)) {}
+const std::vector<Float>& ColladaImporter::Document::floatArray(FloatArray& array, const UnsignedInt threadCount) {
+    if(!array.converted) {
+        Implementation::Utility::parseArray(rawText(xml, array.element), array.data, unsignedIntAttribute(xml, array.element, "count"), threadCount);
+        array.converted = true;
+    }
+
+    return array.data;
+}
 
-ColladaImporter::ColladaImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin}, d(nullptr), zero(0), app(qApp ? nullptr : new QCoreApplication(zero, nullptr)) {}
+auto ColladaImporter::Document::mesh(const UnsignedInt id, const UnsignedInt threadCount) -> const Mesh& {
+    Mesh& mesh = meshPrimitives[id];
+    if(mesh.converted) return mesh;
+
+    for(Primitives& primitives: mesh.primitives) {
+        /* Input count per vertex */
+        for(std::size_t i = xml.firstChild(primitives.element, "input"); i != XmlDocument::NoElement; i = xml.nextSibling(i, "input"))
+            ++primitives.stride;
+
+        /* Triangles, all faces have three vertices */
+        if(xml.is(primitives.element, "triangles")) {
+            const UnsignedInt count = unsignedIntAttribute(xml, primitives.element, "count");
+            primitives.vertexCountPerFace.assign(count, 3);
+            Implementation::Utility::parseArray(rawText(xml, xml.firstChild(primitives.element, "p")), primitives.interleavedIndexArrays, count*3*primitives.stride, threadCount);
+
+        /* Polygon list, vertex count per polygon is given explicitly */
+        } else if(xml.is(primitives.element, "polylist")) {
+            Implementation::Utility::parseArray(rawText(xml, xml.firstChild(primitives.element, "vcount")), primitives.vertexCountPerFace, unsignedIntAttribute(xml, primitives.element, "count"), threadCount);
+            UnsignedInt vertexCount = 0;
+            for(const UnsignedInt count: primitives.vertexCountPerFace)
+                vertexCount += count;
+
+            Implementation::Utility::parseArray(rawText(xml, xml.firstChild(primitives.element, "p")), primitives.interleavedIndexArrays, vertexCount*primitives.stride, threadCount);
+
+        /* Polygons, each in its own <p> element. Polygons with holes in
+           <ph> elements are not supported and thus skipped. */
+        } else if(primitives.stride) {
+            std::vector<UnsignedInt> polygon;
+            for(std::size_t p = xml.firstChild(primitives.element, "p"); p != XmlDocument::NoElement; p = xml.nextSibling(p, "p")) {
+                const std::size_t vertexCount = Implementation::Utility::arraySize(rawText(xml, p))/primitives.stride;
+                Implementation::Utility::parseArray(rawText(xml, p), polygon, vertexCount*primitives.stride, 1);
+                primitives.vertexCountPerFace.push_back(vertexCount);
+                primitives.interleavedIndexArrays.insert(primitives.interleavedIndexArrays.end(), polygon.begin(), polygon.end());
+            }
+        }
+    }
 
-ColladaImporter::~ColladaImporter() {
-    close();
-    delete app;
+    mesh.converted = true;
+    return mesh;
 }
 
+ColladaImporter::ColladaImporter(): d(nullptr) {}
+
+ColladaImporter::ColladaImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter{manager}, d(nullptr) {}
+
+ColladaImporter::ColladaImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin}, d(nullptr) {}
+
+ColladaImporter::~ColladaImporter() { close(); }
+
 auto ColladaImporter::doFeatures() const -> Features { return {}; }
 
 bool ColladaImporter::doIsOpened() const { return d; }
 
 void ColladaImporter::doOpenFile(const std::string& filename) {
-    QXmlQuery query;
-
-    /* Open the file and load it into XQuery */
-    QFile file(QString::fromStdString(filename));
-    if(!file.open(QIODevice::ReadOnly)) {
+    /* Open the file and parse it */
+    if(!Utility::Directory::fileExists(filename)) {
         Error() << "Trade::ColladaImporter:openFile(): cannot open file" << filename;
         return;
     }
-    if(!query.setFocus(&file)) {
-        Error() << "Trade::ColladaImporter::openFile(): cannot load XML";
+
+    std::unique_ptr<Document> document{new Document};
+    document->filename = filename;
+    document->threadCount = threadCount(configuration());
+    document->data = Utility::Directory::read(filename);
+    XmlDocument& xml = document->xml;
+    if(!xml.parse({document->data.data(), document->data.size()})) {
+        Error() << "Trade::ColladaImporter::openFile(): cannot load XML, error on line" << xml.errorLine();
         return;
     }
 
-    QString tmp;
-
     /* Check namespace */
-    query.setQuery("namespace-uri(/*:COLLADA)");
-    query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
-    if(tmp != "http://www.collada.org/2005/11/COLLADASchema") {
-        Error() << "Trade::ColladaImporter::openFile(): unsupported namespace" << ('"'+tmp+'"').toStdString();
+    const std::string ns = xml.is(0, "COLLADA") ? xml.attributeString(0, "xmlns") : std::string{};
+    if(ns != "http://www.collada.org/2005/11/COLLADASchema") {
+        Error() << "Trade::ColladaImporter::openFile(): unsupported namespace" << '"' + ns + '"';
         return;
     }
 
     /* Check version */
-    query.setQuery(namespaceDeclaration + "/COLLADA/@version/string()");
-    query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
-    if(tmp != "1.4.1") {
-        Error() << "Trade::ColladaImporter::openFile(): unsupported version" << ('"'+tmp+'"').toStdString();
+    const std::string version = xml.attributeString(0, "version");
+    if(version != "1.4.1") {
+        Error() << "Trade::ColladaImporter::openFile(): unsupported version" << '"' + version + '"';
         return;
     }
 
-    d = new Document;
-    d->filename = filename;
-    d->query = query;
-
-    QStringList tmpList;
-
-    /* Create scene name -> scene id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene/@id/string()");
-    query.evaluateTo(&tmpList);
-    d->scenes.reserve(tmpList.size());
-    d->scenesForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        std::string name = id.trimmed().toStdString();
-        d->scenes.push_back(name);
-        d->scenesForName.emplace(std::move(name), d->scenesForName.size());
-    }
+    /* Go through all libraries and create name -> id maps. Everything is
+       gathered in document order, the first occurence of a name wins. */
+    for(std::size_t library = xml.firstChild(0); library != XmlDocument::NoElement; library = xml.nextSibling(library)) {
+        /* Scenes and objects in them */
+        if(xml.is(library, "library_visual_scenes")) {
+            gatherIds(xml, library, "visual_scene", &document->scenes, &document->sceneElements, document->scenesForName);
+
+            /* Nodes in the scene, the elements are stored depth-first, so
+               just go through the whole range */
+            for(std::size_t scene = xml.firstChild(library, "visual_scene"); scene != XmlDocument::NoElement; scene = xml.nextSibling(scene, "visual_scene")) {
+                for(std::size_t i = scene + 1; i != xml.element(scene).end; ++i) {
+                    if(!xml.is(i, "node")) continue;
+
+                    std::string id = xml.attributeString(i, "id");
+                    if(id.empty()) continue;
+
+                    document->objects.push_back(id);
+                    document->objectElements.push_back(i);
+                    document->objectsForName.emplace(std::move(id), document->objectsForName.size());
+                }
+            }
 
-    /* Create object name -> object id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node/@id/string()");
-    tmpList.clear();
-    query.evaluateTo(&tmpList);
-    d->objects.reserve(tmpList.size());
-    d->objectsForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        std::string name = id.trimmed().toStdString();
-        d->objects.push_back(name);
-        d->objectsForName.emplace(std::move(name), d->objectsForName.size());
-    }
+        /* Cameras */
+        } else if(xml.is(library, "library_cameras")) {
+            gatherIds(xml, library, "camera", nullptr, nullptr, document->camerasForName);
 
-    /* Create camera name -> camera id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_cameras/camera/@id/string()");
-    tmpList.clear();
-    query.evaluateTo(&tmpList);
-    d->camerasForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        d->camerasForName.emplace(id.trimmed().toStdString(), d->camerasForName.size());
-    }
+        /* Lights */
+        } else if(xml.is(library, "library_lights")) {
+            gatherIds(xml, library, "light", nullptr, nullptr, document->lightsForName);
 
-    /* Create light name -> light id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_lights/light/@id/string()");
-    tmpList.clear();
-    query.evaluateTo(&tmpList);
-    d->lightsForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        d->lightsForName.emplace(id.trimmed().toStdString(), d->lightsForName.size());
-    }
+        /* Meshes, their sources and polygon lists */
+        } else if(xml.is(library, "library_geometries")) {
+            for(std::size_t geometry = xml.firstChild(library, "geometry"); geometry != XmlDocument::NoElement; geometry = xml.nextSibling(geometry, "geometry")) {
+                const std::size_t mesh = xml.firstChild(geometry, "mesh");
+                if(mesh == XmlDocument::NoElement) continue;
 
-    /* Create mesh name -> mesh id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_geometries/geometry/@id/string()");
-    tmpList.clear();
-    query.evaluateTo(&tmpList);
-    d->meshes.reserve(tmpList.size());
-    d->meshesForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        std::string name = id.trimmed().toStdString();
-        d->meshes.push_back(name);
-        d->meshesForName.emplace(std::move(name), d->meshesForName.size());
-    }
+                for(std::size_t source = xml.firstChild(mesh, "source"); source != XmlDocument::NoElement; source = xml.nextSibling(source, "source")) {
+                    document->sourcesForId.emplace(xml.attributeString(source, "id"), source);
 
-    /* Create material name -> material id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_materials/material/@id/string()");
-    tmpList.clear();
-    query.evaluateTo(&tmpList);
-    d->materials.reserve(tmpList.size());
-    d->materialsForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        std::string name = id.trimmed().toStdString();
-        d->materials.push_back(name);
-        d->materialsForName.emplace(std::move(name), d->materialsForName.size());
-    }
+                    /* The contents are converted only when a mesh needs them */
+                    const std::size_t floatArray = xml.firstChild(source, "float_array");
+                    if(floatArray != XmlDocument::NoElement)
+                        document->floatArraysForId.emplace(xml.attributeString(floatArray, "id"), Document::FloatArray{floatArray, false, {}});
+                }
 
-    /* Create texture name -> texture id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam/*[starts-with(name(), 'sampler')]/../@sid/string()");
-    tmpList.clear();
-    query.evaluateTo(&tmpList);
-    d->textures.reserve(tmpList.size());
-    d->materialsForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        std::string name = id.trimmed().toStdString();
-        d->textures.push_back(name);
-        d->texturesForName.emplace(std::move(name), d->texturesForName.size());
-    }
+                for(std::size_t vertices = xml.firstChild(mesh, "vertices"); vertices != XmlDocument::NoElement; vertices = xml.nextSibling(vertices, "vertices"))
+                    document->verticesForId.emplace(xml.attributeString(vertices, "id"), vertices);
+            }
 
-    /* Create image name -> image id map */
-    query.setQuery(namespaceDeclaration + "/COLLADA/library_images/image/@id/string()");
-    tmpList.clear();
-    query.evaluateTo(&tmpList);
-    d->images2D.reserve(tmpList.size());
-    d->images2DForName.reserve(tmpList.size());
-    for(const QString& id: tmpList) {
-        std::string name = id.trimmed().toStdString();
-        d->images2D.push_back(name);
-        d->images2DForName.emplace(std::move(name), d->images2DForName.size());
+            const std::size_t previousMeshCount = document->meshElements.size();
+            gatherIds(xml, library, "geometry", &document->meshes, &document->meshElements, document->meshesForName);
+
+            /* Primitive groups, index arrays are converted on first access to
+               the mesh. Lines and strips are not supported and thus skipped. */
+            for(std::size_t i = previousMeshCount; i != document->meshElements.size(); ++i) {
+                Document::Mesh mesh{false, {}};
+                for(std::size_t j = xml.firstChild(xml.firstChild(document->meshElements[i], "mesh")); j != XmlDocument::NoElement; j = xml.nextSibling(j))
+                    if(xml.is(j, "triangles") || xml.is(j, "polylist") || xml.is(j, "polygons"))
+                        mesh.primitives.push_back({j, 0, {}, {}});
+
+                document->meshPrimitives.push_back(std::move(mesh));
+            }
+
+        /* Materials */
+        } else if(xml.is(library, "library_materials")) {
+            gatherIds(xml, library, "material", &document->materials, &document->materialElements, document->materialsForName);
+
+        /* Effects, textures and surfaces in them */
+        } else if(xml.is(library, "library_effects")) {
+            for(std::size_t effect = xml.firstChild(library, "effect"); effect != XmlDocument::NoElement; effect = xml.nextSibling(effect, "effect")) {
+                document->effectsForId.emplace(xml.attributeString(effect, "id"), effect);
+
+                const std::size_t profile = xml.firstChild(effect, "profile_COMMON");
+                if(profile == XmlDocument::NoElement) continue;
+
+                for(std::size_t newparam = xml.firstChild(profile, "newparam"); newparam != XmlDocument::NoElement; newparam = xml.nextSibling(newparam, "newparam")) {
+                    std::string sid = xml.attributeString(newparam, "sid");
+                    if(sid.empty()) continue;
+
+                    if(xml.firstChild(newparam, "surface") != XmlDocument::NoElement)
+                        document->surfacesForSid.emplace(sid, newparam);
+
+                    if(firstChildWithPrefix(xml, newparam, "sampler") != XmlDocument::NoElement) {
+                        document->textures.push_back(sid);
+                        document->textureElements.push_back(newparam);
+                        document->texturesForName.emplace(std::move(sid), document->texturesForName.size());
+                    }
+                }
+            }
+
+        /* Images */
+        } else if(xml.is(library, "library_images")) {
+            gatherIds(xml, library, "image", &document->images2D, &document->image2DElements, document->images2DForName);
+
+        /* Default scene */
+        } else if(xml.is(library, "scene")) {
+            document->defaultScene = reference(xml, xml.firstChild(library, "instance_visual_scene"), "url");
+        }
     }
+
+    d = document.release();
 }
 
 void ColladaImporter::doClose() {
@@ -229,13 +412,7 @@ void ColladaImporter::doClose() {
 }
 
 Int ColladaImporter::doDefaultScene() {
-    QString tmp;
-
-    /* Default scene */
-    d->query.setQuery(namespaceDeclaration + "/COLLADA/scene/instance_visual_scene/@url/string()");
-    d->query.evaluateTo(&tmp);
-
-    auto it = d->scenesForName.find(tmp.trimmed().mid(1).toStdString());
+    auto it = d->scenesForName.find(d->defaultScene);
     return it == d->scenesForName.end() ? -1 : it->second;
 }
 
@@ -249,17 +426,16 @@ Int ColladaImporter::doSceneForName(const std::string& name) {
 std::string ColladaImporter::doSceneName(const UnsignedInt id) { return d->scenes[id]; }
 
 Containers::Optional<SceneData> ColladaImporter::doScene(const UnsignedInt id) {
-    QStringList tmpList;
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene[%0]/node/@id/string()").arg(id+1));
-    d->query.evaluateTo(&tmpList);
+    const XmlDocument& xml = d->xml;
 
     std::vector<UnsignedInt> children;
-    children.reserve(tmpList.size());
-    for(const QString& childId: tmpList) {
-        const std::string childIdTrimmed = childId.trimmed().toStdString();
-        const Int id = doObject3DForName(childIdTrimmed);
+    for(std::size_t node = xml.firstChild(d->sceneElements[id], "node"); node != XmlDocument::NoElement; node = xml.nextSibling(node, "node")) {
+        const std::string childId = xml.attributeString(node, "id");
+        if(childId.empty()) continue;
+
+        const Int id = doObject3DForName(childId);
         if(id == -1) {
-            Error() << "Trade::ColladaImporter::scene(): object" << '"' + childIdTrimmed + '"' << "was not found";
+            Error() << "Trade::ColladaImporter::scene(): object" << '"' + childId + '"' << "was not found";
             return Containers::NullOpt;
         }
         children.push_back(id);
@@ -278,69 +454,50 @@ Int ColladaImporter::doObject3DForName(const std::string& name) {
 std::string ColladaImporter::doObject3DName(const UnsignedInt id) { return d->objects[id]; }
 
 std::unique_ptr<ObjectData3D> ColladaImporter::doObject3D(const UnsignedInt id) {
-    /* Referring to <node>s with numbers somehow doesn't work (i.e. it selects
-       many extra elements), we need to refer to them by id attribute instead */
-    const auto name = QString::fromStdString(doObject3DName(id));
-
-    QString tmp;
-    QStringList tmpList, tmpList2;
+    const XmlDocument& xml = d->xml;
+    const std::size_t node = d->objectElements[id];
 
     /* Transformations */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node[@id='%0']/(translate|rotate|scale)/name()").arg(name));
-    d->query.evaluateTo(&tmpList);
-
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node[@id='%0']/(translate|rotate|scale)/string()").arg(name));
-    d->query.evaluateTo(&tmpList2);
-
     Matrix4 transformation;
-    for(std::size_t i = 0; i != std::size_t(tmpList.size()); ++i) {
-        QString type = tmpList[i].trimmed();
+    for(std::size_t i = xml.firstChild(node); i != XmlDocument::NoElement; i = xml.nextSibling(i)) {
         /* Translation */
-        if(type == "translate")
-            transformation = transformation*Matrix4::translation(Implementation::Utility::parseVector<Vector3>(tmpList2[i]));
+        if(xml.is(i, "translate"))
+            transformation = transformation*Matrix4::translation(Implementation::Utility::parseVector<Vector3>(text(xml, i)));
 
         /* Rotation */
-        else if(type == "rotate") {
-            int pos = 0;
-            Vector3 axis = Implementation::Utility::parseVector<Vector3>(tmpList2[i], &pos);
-            Deg angle(Implementation::ColladaType<Float>::fromString(tmpList2[i].mid(pos)));
+        else if(xml.is(i, "rotate")) {
+            const std::string data = text(xml, i);
+            std::size_t pos = 0;
+            Vector3 axis = Implementation::Utility::parseVector<Vector3>(data, &pos);
+            Deg angle(Implementation::ColladaType<Float>::fromString(data.substr(pos)));
             transformation = transformation*Matrix4::rotation(angle, axis);
 
         /* Scaling */
-        } else if(type == "scale")
-            transformation = transformation*Matrix4::scaling(Implementation::Utility::parseVector<Vector3>(tmpList2[i]));
-
-        /* It shouldn't get here */
-        else CORRADE_ASSERT(0, ("Trade::ColladaImporter::object3D(): unknown translation " + type).toStdString(), nullptr);
+        } else if(xml.is(i, "scale"))
+            transformation = transformation*Matrix4::scaling(Implementation::Utility::parseVector<Vector3>(text(xml, i)));
     }
 
-    /* Child object names */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node[@id='%0']/node/@id/string()").arg(name));
-    tmpList.clear();
-    d->query.evaluateTo(&tmpList);
-
     /* Child object IDs */
     std::vector<UnsignedInt> children;
-    children.reserve(tmpList.size());
-    for(const QString& childId: tmpList) {
-        const std::string childIdTrimmed = childId.trimmed().toStdString();
-        const Int id = doObject3DForName(childIdTrimmed);
+    for(std::size_t child = xml.firstChild(node, "node"); child != XmlDocument::NoElement; child = xml.nextSibling(child, "node")) {
+        const std::string childId = xml.attributeString(child, "id");
+        if(childId.empty()) continue;
+
+        const Int id = doObject3DForName(childId);
         if(id == -1) {
-            Error() << "Trade::ColladaImporter::object3D(): object" << '"' + childIdTrimmed + '"' << "was not found";
+            Error() << "Trade::ColladaImporter::object3D(): object" << '"' + childId + '"' << "was not found";
             return nullptr;
         }
         children.push_back(id);
     }
 
     /* Instance type */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node[@id='%0']/*[starts-with(name(), 'instance_')]/name()").arg(name));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    const std::string instance = name(xml, firstChildWithPrefix(xml, node, "instance_"));
 
     /* Camera instance */
-    if(tmp == "instance_camera") {
+    if(instance == "instance_camera") {
         /** @todo use doCameraForName() */
-        std::string cameraName = instanceName(name, "instance_camera");
+        std::string cameraName = instanceName(node, "instance_camera");
         auto cameraId = d->camerasForName.find(cameraName);
         if(cameraId == d->camerasForName.end()) {
             Error() << "Trade::ColladaImporter::object3D(): camera" << '"'+cameraName+'"' << "was not found";
@@ -351,9 +508,9 @@ std::unique_ptr<ObjectData3D> ColladaImporter::doObject3D(const UnsignedInt id)
         return std::unique_ptr<ObjectData3D>(new ObjectData3D(std::move(children), transformation, ObjectInstanceType3D::Camera, cameraId->second));
 
     /* Light instance */
-    } else if(tmp == "instance_light") {
+    } else if(instance == "instance_light") {
         /** @todo use doLightForName() */
-        std::string lightName = instanceName(name, "instance_light");
+        std::string lightName = instanceName(node, "instance_light");
         auto lightId = d->lightsForName.find(lightName);
         if(lightId == d->lightsForName.end()) {
             Error() << "Trade::ColladaImporter::object3D(): light" << '"'+lightName+'"' << "was not found";
@@ -364,26 +521,25 @@ std::unique_ptr<ObjectData3D> ColladaImporter::doObject3D(const UnsignedInt id)
         return std::unique_ptr<ObjectData3D>(new ObjectData3D(std::move(children), transformation, ObjectInstanceType3D::Light, lightId->second));
 
     /* Mesh instance */
-    } else if(tmp == "instance_geometry") {
-        std::string meshName = instanceName(name, "instance_geometry");
+    } else if(instance == "instance_geometry") {
+        std::string meshName = instanceName(node, "instance_geometry");
         const Int meshId = doMesh3DForName(meshName);
         if(meshId == -1) {
             Error() << "Trade::ColladaImporter::object3D(): mesh" << '"'+meshName+'"' << "was not found";
             return nullptr;
         }
 
-        d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node[@id='%0']/instance_geometry/bind_material/technique_common/count(instance_material)").arg(name));
-        d->query.evaluateTo(&tmp);
+        const std::size_t technique = xml.child(node, {"instance_geometry", "bind_material", "technique_common"});
+        UnsignedInt materialCount = 0;
+        for(std::size_t i = xml.firstChild(technique, "instance_material"); i != XmlDocument::NoElement; i = xml.nextSibling(i, "instance_material"))
+            ++materialCount;
 
-        const Int materialCount = tmp.toInt();
         Int materialId = -1;
         if(materialCount > 1) {
             Error() << "Trade::ColladaImporter::object3D(): multiple materials per object are not supported";
             return nullptr;
         } else if(materialCount != 0) {
-            d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node[@id='%0']/instance_geometry/bind_material/technique_common/instance_material/@target/string()").arg(name));
-            d->query.evaluateTo(&tmp);
-            std::string materialName = tmp.trimmed().mid(1).toStdString();
+            std::string materialName = reference(xml, xml.firstChild(technique, "instance_material"), "target");
 
             /* If the mesh doesn't have bound material, add default one, else find
                its ID */
@@ -401,11 +557,11 @@ std::unique_ptr<ObjectData3D> ColladaImporter::doObject3D(const UnsignedInt id)
         return std::unique_ptr<ObjectData3D>(new MeshObjectData3D(std::move(children), transformation, meshId, materialId));
 
     /* Blender group instance */
-    } else if(tmp.isEmpty())
+    } else if(instance.empty())
         return std::unique_ptr<ObjectData3D>(new ObjectData3D(std::move(children), transformation));
 
     /* Something else */
-    Error() << "Trade::ColladaImporter::object3D():" << '"'+tmp.toStdString()+'"' << "instance type not supported";
+    Error() << "Trade::ColladaImporter::object3D():" << '"'+instance+'"' << "instance type not supported";
     return nullptr;
 }
 
@@ -419,105 +575,161 @@ Int ColladaImporter::doMesh3DForName(const std::string& name) {
 std::string ColladaImporter::doMesh3DName(const UnsignedInt id) { return d->meshes[id]; }
 
 Containers::Optional<MeshData3D> ColladaImporter::doMesh3D(const UnsignedInt id) {
-    /** @todo More polylists in one mesh */
-
-    /* Get polygon count */
-    QString tmp;
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry[%0]/mesh/polylist/@count/string()").arg(id+1));
-    d->query.evaluateTo(&tmp);
-    UnsignedInt polygonCount = Implementation::ColladaType<UnsignedInt>::fromString(tmp);
-
-    /* Get vertex count per polygon */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry[%0]/mesh/polylist/vcount/string()").arg(id+1));
-    d->query.evaluateTo(&tmp);
-    std::vector<UnsignedInt> vertexCountPerFace = Implementation::Utility::parseArray<UnsignedInt>(tmp, polygonCount);
-
-    UnsignedInt vertexCount = 0;
-    std::vector<UnsignedInt> quads;
-    for(std::size_t i = 0; i != vertexCountPerFace.size(); ++i) {
-        UnsignedInt count = vertexCountPerFace[i];
-
-        if(count == 4) quads.push_back(i);
-        else if(count != 3) {
-            Error() << "Trade::ColladaImporter::mesh3D():" << count << "vertices per face not supported";
-            return Containers::NullOpt;
-        }
+    return importMesh(id, d->threadCount);
+}
 
-        vertexCount += count;
+std::vector<Containers::Optional<MeshData3D>> ColladaImporter::meshes() {
+    CORRADE_ASSERT(isOpened(), "Trade::ColladaImporter::meshes(): no file opened", {});
+
+    std::vector<Containers::Optional<MeshData3D>> out(d->meshes.size());
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    UnsignedInt threadCount = d->threadCount;
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    threadCount = std::min(threadCount, UnsignedInt(out.size()));
+    if(threadCount > 1) {
+        /* Convert all float arrays and index arrays first so the meshes can
+           be then built without touching any shared state. Each item is
+           converted on a single thread, the items are handed out
+           dynamically as the sizes vary a lot. */
+        std::vector<Document::FloatArray*> floatArrays;
+        floatArrays.reserve(d->floatArraysForId.size());
+        for(auto& floatArray: d->floatArraysForId)
+            floatArrays.push_back(&floatArray.second);
+
+        std::atomic<std::size_t> next{0};
+        auto convert = [this, &floatArrays, &next]() {
+            for(std::size_t i; (i = next++) < floatArrays.size() + d->meshes.size(); ) {
+                if(i < floatArrays.size()) d->floatArray(*floatArrays[i], 1);
+                else d->mesh(i - floatArrays.size(), 1);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(threadCount - 1);
+        for(UnsignedInt i = 1; i != threadCount; ++i)
+            threads.emplace_back(convert);
+        convert();
+        for(std::thread& thread: threads) thread.join();
+        threads.clear();
+
+        /* Build the meshes */
+        next = 0;
+        auto build = [this, &out, &next]() {
+            for(std::size_t i; (i = next++) < out.size(); )
+                out[i] = importMesh(i, 1);
+        };
+        for(UnsignedInt i = 1; i != threadCount; ++i)
+            threads.emplace_back(build);
+        build();
+        for(std::thread& thread: threads) thread.join();
+
+        return out;
     }
+    #endif
 
-    /* Get input count per vertex */
-    d->query.setQuery((namespaceDeclaration + "count(/COLLADA/library_geometries/geometry[%0]/mesh/polylist/input)").arg(id+1));
-    d->query.evaluateTo(&tmp);
-    UnsignedInt stride = Implementation::ColladaType<UnsignedInt>::fromString(tmp);
+    for(std::size_t i = 0; i != out.size(); ++i)
+        out[i] = importMesh(i, d->threadCount);
 
-    /* Get mesh index arrays */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry[%0]/mesh/polylist/p/string()").arg(id+1));
-    d->query.evaluateTo(&tmp);
-    std::vector<UnsignedInt> interleavedIndexArrays = Implementation::Utility::parseArray<UnsignedInt>(tmp, vertexCount*stride);
+    return out;
+}
 
-    /* Combine index arrays */
-    std::vector<UnsignedInt> combinedIndices;
-    std::tie(combinedIndices, interleavedIndexArrays) = MeshTools::combineIndexArrays(interleavedIndexArrays, stride);
+Containers::Optional<MeshData3D> ColladaImporter::importMesh(const UnsignedInt id, const UnsignedInt threadCount) {
+    const XmlDocument& xml = d->xml;
+    const Document::Mesh& mesh = d->mesh(id, threadCount);
 
-    /* Convert quads to triangles */
+    /* All primitive groups are merged into a single mesh, the groups are
+       expected to have the same attributes */
     std::vector<UnsignedInt> indices;
-    std::size_t quadId = 0;
-    for(std::size_t i = 0; i != vertexCountPerFace.size(); ++i) {
-        if(quads.size() > quadId && quads[quadId] == i) {
-            indices.insert(indices.end(), {
-                combinedIndices[i*3+quadId],
-                combinedIndices[i*3+quadId+1],
-                combinedIndices[i*3+quadId+2],
-                combinedIndices[i*3+quadId],
-                combinedIndices[i*3+quadId+2],
-                combinedIndices[i*3+quadId+3]
-            });
+    std::vector<Vector3> vertices;
+    std::vector<std::vector<Vector3>> normals;
+    std::vector<std::vector<Vector2>> textureCoords2D;
+    for(std::size_t group = 0; group != mesh.primitives.size(); ++group) {
+        const Document::Primitives& primitives = mesh.primitives[group];
+
+        /* Vertex count per polygon */
+        const std::vector<UnsignedInt>& vertexCountPerFace = primitives.vertexCountPerFace;
+        for(const UnsignedInt count: vertexCountPerFace) {
+            if(count != 3 && count != 4) {
+                Error() << "Trade::ColladaImporter::mesh3D():" << count << "vertices per face not supported";
+                return Containers::NullOpt;
+            }
+        }
+
+        /* Input count per vertex, groups without any inputs have no data */
+        const UnsignedInt stride = primitives.stride;
+        if(!stride) continue;
 
-            ++quadId;
-        } else {
+        /* Combine index arrays */
+        std::vector<UnsignedInt> combinedIndices, interleavedIndexArrays;
+        std::tie(combinedIndices, interleavedIndexArrays) = MeshTools::combineIndexArrays(primitives.interleavedIndexArrays, stride);
+
+        /* Convert quads to triangles, offsetting the indices to vertices of
+           previous groups */
+        const UnsignedInt indexOffset = vertices.size();
+        std::size_t offset = 0;
+        for(const UnsignedInt count: vertexCountPerFace) {
             indices.insert(indices.end(), {
-                combinedIndices[i*3+quadId],
-                combinedIndices[i*3+quadId+1],
-                combinedIndices[i*3+quadId+2]
+                indexOffset + combinedIndices[offset],
+                indexOffset + combinedIndices[offset + 1],
+                indexOffset + combinedIndices[offset + 2]
+            });
+            if(count == 4) indices.insert(indices.end(), {
+                indexOffset + combinedIndices[offset],
+                indexOffset + combinedIndices[offset + 2],
+                indexOffset + combinedIndices[offset + 3]
             });
+
+            offset += count;
         }
-    }
 
-    /* Get mesh vertices */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry[%0]/mesh/polylist/input[@semantic='VERTEX']/@source/string()")
-        .arg(id+1));
-    d->query.evaluateTo(&tmp);
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry/mesh/vertices[@id='%0']/input[@semantic='POSITION']/@source/string()")
-        .arg(tmp.mid(1).trimmed()));
-    d->query.evaluateTo(&tmp);
-    std::vector<Vector3> originalVertices = parseSource<Vector3>(tmp.mid(1).trimmed());
-
-    /* Build vertex array */
-    UnsignedInt vertexOffset = attributeOffset(id, "VERTEX");
-    std::vector<Vector3> vertices(interleavedIndexArrays.size()/stride);
-    for(UnsignedInt i = 0; i != vertices.size(); ++i)
-        vertices[i] = originalVertices[interleavedIndexArrays[i*stride + vertexOffset]];
-
-    QStringList tmpList;
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry[%0]/mesh/polylist/input/@semantic/string()").arg(id+1));
-    d->query.evaluateTo(&tmpList);
-    std::vector<std::vector<Vector3>> normals;
-    std::vector<std::vector<Vector2>> textureCoords2D;
-    for(QString attribute: tmpList) {
-        /* Vertices - already built */
-        if(attribute == "VERTEX") continue;
+        /* Get mesh vertices */
+        auto vertexInput = d->verticesForId.find(reference(xml, input(xml, primitives.element, "VERTEX"), "source"));
+        std::vector<Vector3> originalVertices = parseSource<Vector3>(vertexInput == d->verticesForId.end() ? std::string{} :
+            reference(xml, input(xml, vertexInput->second, "POSITION"), "source"));
+
+        /* Build vertex array */
+        UnsignedInt vertexOffset = attributeOffset(primitives.element, "VERTEX");
+        vertices.reserve(vertices.size() + interleavedIndexArrays.size()/stride);
+        for(UnsignedInt i = 0; i != interleavedIndexArrays.size()/stride; ++i)
+            vertices.push_back(originalVertices[interleavedIndexArrays[i*stride + vertexOffset]]);
+
+        std::vector<std::vector<Vector3>> groupNormals;
+        std::vector<std::vector<Vector2>> groupTextureCoords2D;
+        for(std::size_t i = xml.firstChild(primitives.element, "input"); i != XmlDocument::NoElement; i = xml.nextSibling(i, "input")) {
+            const std::string attribute = xml.attributeString(i, "semantic");
+
+            /* Vertices - already built */
+            if(attribute == "VERTEX") continue;
+
+            /* Normals */
+            else if(attribute == "NORMAL")
+                groupNormals.push_back(buildAttributeArray<Vector3>(primitives.element, "NORMAL", groupNormals.size(), stride, interleavedIndexArrays));
+
+            /* 2D texture coords */
+            else if(attribute == "TEXCOORD")
+                groupTextureCoords2D.push_back(buildAttributeArray<Vector2>(primitives.element, "TEXCOORD", groupTextureCoords2D.size(), stride, interleavedIndexArrays));
+
+            /* Something other */
+            else Warning() << "Trade::ColladaImporter::mesh3D():" << '"' + attribute + '"' << "input semantic not supported";
+        }
 
-        /* Normals */
-        else if(attribute == "NORMAL")
-            normals.push_back(buildAttributeArray<Vector3>(id, "NORMAL", normals.size(), stride, interleavedIndexArrays));
+        /* First group defines the attributes */
+        if(!group) {
+            normals = std::move(groupNormals);
+            textureCoords2D = std::move(groupTextureCoords2D);
+            continue;
+        }
 
-        /* 2D texture coords */
-        else if(attribute == "TEXCOORD")
-            textureCoords2D.push_back(buildAttributeArray<Vector2>(id, "TEXCOORD", textureCoords2D.size(), stride, interleavedIndexArrays));
+        if(groupNormals.size() != normals.size() || groupTextureCoords2D.size() != textureCoords2D.size()) {
+            Error() << "Trade::ColladaImporter::mesh3D(): primitive groups with different attributes are not supported";
+            return Containers::NullOpt;
+        }
 
-        /* Something other */
-        else Warning() << "Trade::ColladaImporter::mesh3D():" << '"' + attribute.toStdString() + '"' << "input semantic not supported";
+        for(std::size_t i = 0; i != normals.size(); ++i)
+            normals[i].insert(normals[i].end(), groupNormals[i].begin(), groupNormals[i].end());
+        for(std::size_t i = 0; i != textureCoords2D.size(); ++i)
+            textureCoords2D[i].insert(textureCoords2D[i].end(), groupTextureCoords2D[i].begin(), groupTextureCoords2D[i].end());
     }
 
     return MeshData3D{MeshPrimitive::Triangles, std::move(indices), {std::move(vertices)}, std::move(normals), std::move(textureCoords2D), {}, nullptr};
@@ -535,52 +747,46 @@ std::string ColladaImporter::doMaterialName(const UnsignedInt id) {
 }
 
 std::unique_ptr<AbstractMaterialData> ColladaImporter::doMaterial(const UnsignedInt id) {
-    /* Get effect ID */
-    QString effect;
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_materials/material[%0]/instance_effect/@url/string()").arg(id+1));
-    d->query.evaluateTo(&effect);
-    effect = effect.mid(1).trimmed();
+    const XmlDocument& xml = d->xml;
+
+    /* Get effect */
+    auto effect = d->effectsForId.find(reference(xml, xml.firstChild(d->materialElements[id], "instance_effect"), "url"));
 
     /* Find out which profile it is */
-    QString tmp;
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/*[starts-with(name(), 'profile_')]/name()").arg(effect));
-    d->query.evaluateTo(&tmp);
+    const std::size_t profile = effect == d->effectsForId.end() ? XmlDocument::NoElement : firstChildWithPrefix(xml, effect->second, "profile_");
+    const std::string profileName = name(xml, profile);
 
     /** @todo Support other profiles */
 
-    if(tmp.trimmed() != "profile_COMMON") {
-        Error() << "Trade::ColladaImporter::material():" << ('"'+tmp.trimmed()+'"').toStdString() << "effect profile not supported";
+    if(profileName != "profile_COMMON") {
+        Error() << "Trade::ColladaImporter::material():" << '"'+profileName+'"' << "effect profile not supported";
         return nullptr;
     }
 
     /* Get shader type */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/*/name()").arg(effect));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    const std::size_t shader = xml.firstChild(xml.firstChild(profile, "technique"));
+    const std::string shaderName = name(xml, shader);
 
     /** @todo Other (blinn, goraund) profiles */
-    if(tmp != "phong") {
-        Error() << "Trade::ColladaImporter::material():" << ('"'+tmp+'"').toStdString() << "shader not supported";
+    if(shaderName != "phong") {
+        Error() << "Trade::ColladaImporter::material():" << '"'+shaderName+'"' << "shader not supported";
         return nullptr;
     }
 
     /* Shininess */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/phong/shininess/float/string()").arg(effect));
-    d->query.evaluateTo(&tmp);
-    const Float shininess = Implementation::ColladaType<Float>::fromString(tmp);
+    const Float shininess = Implementation::ColladaType<Float>::fromString(text(xml, xml.child(shader, {"shininess", "float"})));
 
     /* Decide about what is textured in the material */
     PhongMaterialData::Flags flags;
 
     /* Ambient texture */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/phong/ambient/texture/@texture/string()").arg(effect));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    const std::size_t ambientTextureElement = xml.child(shader, {"ambient", "texture"});
     UnsignedInt ambientTexture = 0;
-    if(!tmp.isEmpty()) {
-        auto it = d->texturesForName.find(tmp.toStdString());
+    if(ambientTextureElement != XmlDocument::NoElement) {
+        const std::string name = xml.attributeString(ambientTextureElement, "texture");
+        auto it = d->texturesForName.find(name);
         if(it == d->texturesForName.end()) {
-            Error() << "Trade::ColladaImporter::material(): ambient texture" << tmp.toStdString() << "not found";
+            Error() << "Trade::ColladaImporter::material(): ambient texture" << name << "not found";
             return nullptr;
         }
 
@@ -589,14 +795,13 @@ std::unique_ptr<AbstractMaterialData> ColladaImporter::doMaterial(const Unsigned
     }
 
     /* Diffuse texture */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/phong/diffuse/texture/@texture/string()").arg(effect));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    const std::size_t diffuseTextureElement = xml.child(shader, {"diffuse", "texture"});
     UnsignedInt diffuseTexture = 0;
-    if(!tmp.isEmpty()) {
-        auto it = d->texturesForName.find(tmp.toStdString());
+    if(diffuseTextureElement != XmlDocument::NoElement) {
+        const std::string name = xml.attributeString(diffuseTextureElement, "texture");
+        auto it = d->texturesForName.find(name);
         if(it == d->texturesForName.end()) {
-            Error() << "Trade::ColladaImporter::material(): diffuse texture" << tmp.toStdString() << "not found";
+            Error() << "Trade::ColladaImporter::material(): diffuse texture" << name << "not found";
             return nullptr;
         }
 
@@ -605,14 +810,13 @@ std::unique_ptr<AbstractMaterialData> ColladaImporter::doMaterial(const Unsigned
     }
 
     /* Specular texture */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/phong/specular/texture/@texture/string()").arg(effect));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    const std::size_t specularTextureElement = xml.child(shader, {"specular", "texture"});
     UnsignedInt specularTexture = 0;
-    if(!tmp.isEmpty()) {
-        auto it = d->texturesForName.find(tmp.toStdString());
+    if(specularTextureElement != XmlDocument::NoElement) {
+        const std::string name = xml.attributeString(specularTextureElement, "texture");
+        auto it = d->texturesForName.find(name);
         if(it == d->texturesForName.end()) {
-            Error() << "Trade::ColladaImporter::material(): specular texture" << tmp.toStdString() << "not found";
+            Error() << "Trade::ColladaImporter::material(): specular texture" << name << "not found";
             return nullptr;
         }
 
@@ -625,29 +829,17 @@ std::unique_ptr<AbstractMaterialData> ColladaImporter::doMaterial(const Unsigned
     /* Ambient texture or color, if not textured */
     if(flags & PhongMaterialData::Flag::AmbientTexture)
         material->ambientTexture() = ambientTexture;
-    else {
-        d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/phong/ambient/color/string()").arg(effect));
-        d->query.evaluateTo(&tmp);
-        material->ambientColor() = Implementation::Utility::parseVector<Vector3>(tmp);
-    }
+    else material->ambientColor() = Implementation::Utility::parseVector<Vector3>(text(xml, xml.child(shader, {"ambient", "color"})));
 
     /* Diffuse texture or color, if not textured */
     if(flags & PhongMaterialData::Flag::DiffuseTexture)
         material->diffuseTexture() = diffuseTexture;
-    else {
-        d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/phong/diffuse/color/string()").arg(effect));
-        d->query.evaluateTo(&tmp);
-        material->diffuseColor() = Implementation::Utility::parseVector<Vector3>(tmp);
-    }
+    else material->diffuseColor() = Implementation::Utility::parseVector<Vector3>(text(xml, xml.child(shader, {"diffuse", "color"})));
 
     /* Specular color */
     if(flags & PhongMaterialData::Flag::SpecularTexture)
         material->specularTexture() = specularTexture;
-    else {
-        d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect[@id='%0']/profile_COMMON/technique/phong/specular/color/string()").arg(effect));
-        d->query.evaluateTo(&tmp);
-        material->specularColor() = Implementation::Utility::parseVector<Vector3>(tmp);
-    }
+    else material->specularColor() = Implementation::Utility::parseVector<Vector3>(text(xml, xml.child(shader, {"specular", "color"})));
 
     /** @todo Emission, IOR */
 
@@ -668,102 +860,87 @@ std::string ColladaImporter::doTextureName(const UnsignedInt id) {
 
 namespace {
 
-Sampler::Wrapping wrappingFromString(const QString& string) {
+Sampler::Wrapping wrappingFromString(const std::string& string) {
     /* Treat NONE and element not present as default */
-    if(string.isEmpty() || string == "WRAP" || string == "NONE") return Sampler::Wrapping::Repeat;
+    if(string.empty() || string == "WRAP" || string == "NONE") return Sampler::Wrapping::Repeat;
     if(string == "MIRROR") return Sampler::Wrapping::MirroredRepeat;
     if(string == "CLAMP") return Sampler::Wrapping::ClampToEdge;
     if(string == "BORDER") return Sampler::Wrapping::ClampToBorder;
 
-    Error() << "Trade::ColladaImporter::texture(): unknown texture wrapping" << string.toStdString();
+    Error() << "Trade::ColladaImporter::texture(): unknown texture wrapping" << string;
     return Sampler::Wrapping(-1);
 }
 
-Sampler::Filter filterFromString(const QString& string) {
+Sampler::Filter filterFromString(const std::string& string) {
     /* Treat NONE and element not present as default */
-    if(string.isEmpty() || string == "NEAREST" || string == "NONE") return Sampler::Filter::Nearest;
+    if(string.empty() || string == "NEAREST" || string == "NONE") return Sampler::Filter::Nearest;
     if(string == "LINEAR") return Sampler::Filter::Linear;
 
-    Error() << "Trade::ColladaImporter::texture(): unknown texture filter" << string.toStdString();
+    Error() << "Trade::ColladaImporter::texture(): unknown texture filter" << string;
     return Sampler::Filter(-1);
 }
 
-Sampler::Mipmap mipmapFromString(const QString& string) {
+Sampler::Mipmap mipmapFromString(const std::string& string) {
     /* Treat element not present as default */
-    if(string.isEmpty() || string == "NONE") return Sampler::Mipmap::Base;
+    if(string.empty() || string == "NONE") return Sampler::Mipmap::Base;
     if(string == "NEAREST") return Sampler::Mipmap::Nearest;
     if(string == "LINEAR") return Sampler::Mipmap::Linear;
 
-    Error() << "Trade::ColladaImporter::texture(): unknown texture mipmap filter" << string.toStdString();
+    Error() << "Trade::ColladaImporter::texture(): unknown texture mipmap filter" << string;
     return Sampler::Mipmap(-1);
 }
 
 }
 
 Containers::Optional<TextureData> ColladaImporter::doTexture(const UnsignedInt id) {
-    const auto name = QString::fromStdString(d->textures[id]);
+    const XmlDocument& xml = d->xml;
 
     /* Texture type */
-    QString tmp;
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/name()").arg(name));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    const std::size_t sampler = firstChildWithPrefix(xml, d->textureElements[id], "sampler");
+    const std::string samplerType = name(xml, sampler);
 
     TextureData::Type type;
-    if(tmp == "sampler1D")          type = TextureData::Type::Texture1D;
-    else if(tmp == "sampler2D")     type = TextureData::Type::Texture2D;
-    else if(tmp == "sampler3D")     type = TextureData::Type::Texture3D;
-    else if(tmp == "samplerCUBE")   type = TextureData::Type::Cube;
+    if(samplerType == "sampler1D")          type = TextureData::Type::Texture1D;
+    else if(samplerType == "sampler2D")     type = TextureData::Type::Texture2D;
+    else if(samplerType == "sampler3D")     type = TextureData::Type::Texture3D;
+    else if(samplerType == "samplerCUBE")   type = TextureData::Type::Cube;
     else {
-        Error() << "Trade::ColladaImporter::texture(): unsupported sampler type" << tmp.toStdString();
+        Error() << "Trade::ColladaImporter::texture(): unsupported sampler type" << samplerType;
         return Containers::NullOpt;
     }
 
     /* Texture image */
     /** @todo Verify that surface type is the same as sampler type */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[surface][@sid=/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/source/string()]/surface/init_from/string()").arg(name));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    auto surface = d->surfacesForSid.find(text(xml, xml.firstChild(sampler, "source")));
+    const std::string imageName = surface == d->surfacesForSid.end() ? std::string{} : text(xml, xml.child(surface->second, {"surface", "init_from"}));
 
-    auto it = d->images2DForName.find(tmp.toStdString());
+    auto it = d->images2DForName.find(imageName);
     if(it == d->images2DForName.end()) {
-        Error() << "Trade::ColladaImporter::texture(): image" << tmp.toStdString() << "not found";
+        Error() << "Trade::ColladaImporter::texture(): image" << imageName << "not found";
         return Containers::NullOpt;
     }
     const UnsignedInt image = it->second;
 
     /* Texture sampler wrapping */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/wrap_s/string()").arg(name));
-    d->query.evaluateTo(&tmp);
-    const Sampler::Wrapping wrappingX = wrappingFromString(tmp.trimmed());
+    const Sampler::Wrapping wrappingX = wrappingFromString(text(xml, xml.firstChild(sampler, "wrap_s")));
     if(wrappingX == Sampler::Wrapping(-1)) return Containers::NullOpt;
 
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/wrap_t/string()").arg(name));
-    d->query.evaluateTo(&tmp);
-    const Sampler::Wrapping wrappingY = wrappingFromString(tmp.trimmed());
+    const Sampler::Wrapping wrappingY = wrappingFromString(text(xml, xml.firstChild(sampler, "wrap_t")));
     if(wrappingY == Sampler::Wrapping(-1)) return Containers::NullOpt;
 
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/wrap_p/string()").arg(name));
-    d->query.evaluateTo(&tmp);
-    const Sampler::Wrapping wrappingZ = wrappingFromString(tmp.trimmed());
+    const Sampler::Wrapping wrappingZ = wrappingFromString(text(xml, xml.firstChild(sampler, "wrap_p")));
     if(wrappingZ == Sampler::Wrapping(-1)) return Containers::NullOpt;
 
     /* Texture minification filter */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/minfilter/string()").arg(name));
-    d->query.evaluateTo(&tmp);
-    const Sampler::Filter minificationFilter = filterFromString(tmp.trimmed());
+    const Sampler::Filter minificationFilter = filterFromString(text(xml, xml.firstChild(sampler, "minfilter")));
     if(minificationFilter == Sampler::Filter(-1)) return Containers::NullOpt;
 
     /* Texture magnification filter */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/magfilter/string()").arg(name));
-    d->query.evaluateTo(&tmp);
-    const Sampler::Filter magnificationFilter = filterFromString(tmp.trimmed());
+    const Sampler::Filter magnificationFilter = filterFromString(text(xml, xml.firstChild(sampler, "magfilter")));
     if(magnificationFilter == Sampler::Filter(-1)) return Containers::NullOpt;
 
     /* Texture mipmap filter */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_effects/effect/profile_COMMON/newparam[@sid='%0']/*[starts-with(name(), 'sampler')]/mipfilter/string()").arg(name));
-    d->query.evaluateTo(&tmp);
-    const Sampler::Mipmap mipmapFilter = mipmapFromString(tmp.trimmed());
+    const Sampler::Mipmap mipmapFilter = mipmapFromString(text(xml, xml.firstChild(sampler, "mipfilter")));
     if(mipmapFilter == Sampler::Mipmap(-1)) return Containers::NullOpt;
 
     return TextureData(type, minificationFilter, magnificationFilter, mipmapFilter, {wrappingX, wrappingY, wrappingZ}, image);
@@ -782,84 +959,59 @@ std::string ColladaImporter::doImage2DName(const UnsignedInt id) {
 
 Containers::Optional<ImageData2D> ColladaImporter::doImage2D(const UnsignedInt id) {
     /* Image filename */
-    QString tmp;
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_images/image[%0]/init_from/string()").arg(id+1));
-    d->query.evaluateTo(&tmp);
-    tmp = tmp.trimmed();
+    const std::string filename = text(d->xml, d->xml.firstChild(d->image2DElements[id], "init_from"));
 
     CORRADE_ASSERT(manager(), "Trade::ColladaImporter::image2D(): the plugin must be instantiated with access to plugin manager in order to open image files", Containers::NullOpt);
 
     AnyImageImporter imageImporter{static_cast<PluginManager::Manager<AbstractImporter>&>(*manager())};
-    if(!imageImporter.openFile(Utility::Directory::join(Utility::Directory::path(d->filename), tmp.toStdString())))
+    if(!imageImporter.openFile(Utility::Directory::join(Utility::Directory::path(d->filename), filename)))
         return Containers::NullOpt;
 
     return imageImporter.image2D(0);
 }
 
-UnsignedInt ColladaImporter::attributeOffset(UnsignedInt meshId, const QString& attribute, UnsignedInt id) {
-    QString tmp;
-
-    /* Get attribute offset in indices */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry[%0]/mesh/polylist/input[@semantic='%1'][%2]/@offset/string()")
-        .arg(meshId+1).arg(attribute).arg(id+1));
-    d->query.evaluateTo(&tmp);
-    return Implementation::ColladaType<UnsignedInt>::fromString(tmp);
+UnsignedInt ColladaImporter::attributeOffset(const std::size_t polylist, const char* const attribute, const UnsignedInt id) {
+    return unsignedIntAttribute(d->xml, input(d->xml, polylist, attribute, id), "offset");
 }
 
-template<class T> std::vector<T> ColladaImporter::parseSource(const QString& id) {
+template<class T> std::vector<T> ColladaImporter::parseSource(const std::string& id) {
+    const XmlDocument& xml = d->xml;
     std::vector<T> output;
-    QString tmp;
-
-    /* Count of items */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry/mesh/source[@id='%0']/technique_common/accessor/@count/string()").arg(id));
-    d->query.evaluateTo(&tmp);
-    UnsignedInt count = Implementation::ColladaType<UnsignedInt>::fromString(tmp);
-
-    /* Size of each item */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry/mesh/source[@id='%0']/technique_common/accessor/@stride/string()").arg(id));
-    d->query.evaluateTo(&tmp);
-    UnsignedInt size = Implementation::ColladaType<UnsignedInt>::fromString(tmp);
-
-    /* Data source */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry/mesh/source[@id='%0']/technique_common/accessor/@source/string()").arg(id));
-    d->query.evaluateTo(&tmp);
-    QString source = tmp.mid(1).trimmed();
-
-    /* Verify total count */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry/mesh/source/float_array[@id='%0']/@count/string()").arg(source));
-    d->query.evaluateTo(&tmp);
-    if(Implementation::ColladaType<UnsignedInt>::fromString(tmp) != count*size) {
-        Error() << "Trade::ColladaImporter::mesh3D(): wrong total count in source" << ('"'+id+'"').toStdString();
+
+    /* Count and size of items */
+    auto source = d->sourcesForId.find(id);
+    const std::size_t accessor = source == d->sourcesForId.end() ? XmlDocument::NoElement : xml.child(source->second, {"technique_common", "accessor"});
+    const UnsignedInt count = unsignedIntAttribute(xml, accessor, "count");
+    const UnsignedInt size = unsignedIntAttribute(xml, accessor, "stride");
+
+    /* Verify total count of the data source */
+    auto array = d->floatArraysForId.find(reference(xml, accessor, "source"));
+    const std::vector<Float>* const data = array == d->floatArraysForId.end() ? nullptr : &d->floatArray(array->second, d->threadCount);
+    if((data ? data->size() : 0) != count*size) {
+        Error() << "Trade::ColladaImporter::mesh3D(): wrong total count in source" << '"' + id + '"';
         return output;
     }
 
     /** @todo Assert right order of coordinates and type */
 
-    /* Items */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry/mesh/source/float_array[@id='%0']/string()").arg(source));
-    d->query.evaluateTo(&tmp);
-
-    output.reserve(count);
-    Int from = 0;
+    /* Items, taking only as many components as fits into the type */
+    output.resize(count);
+    const std::size_t componentCount = std::min(std::size_t(size), std::size_t(T::Size));
     for(std::size_t i = 0; i != count; ++i)
-        output.push_back(Implementation::Utility::parseVector<T>(tmp, &from, size));
+        for(std::size_t j = 0; j != componentCount; ++j)
+            output[i][j] = (*data)[i*size + j];
 
     return output;
 }
 
 /* Doxygen got confused by the templates and thinks this is undocumented */
 #ifndef DOXYGEN_GENERATING_OUTPUT
-template<class T> std::vector<T> ColladaImporter::buildAttributeArray(UnsignedInt meshId, const QString& attribute, UnsignedInt id, UnsignedInt stride, const std::vector<UnsignedInt>& interleavedIndexArrays) {
-    QString tmp;
-
+template<class T> std::vector<T> ColladaImporter::buildAttributeArray(const std::size_t polylist, const char* const attribute, const UnsignedInt id, const UnsignedInt stride, const std::vector<UnsignedInt>& interleavedIndexArrays) {
     /* Original attribute array */
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_geometries/geometry[%0]/mesh/polylist/input[@semantic='%1'][%2]/@source/string()")
-        .arg(meshId+1).arg(attribute).arg(id+1));
-    d->query.evaluateTo(&tmp);
-    std::vector<T> originalArray = parseSource<T>(tmp.mid(1).trimmed());
+    std::vector<T> originalArray = parseSource<T>(reference(d->xml, input(d->xml, polylist, attribute, id), "source"));
 
     /* Attribute offset in original index array */
-    UnsignedInt offset = attributeOffset(meshId, attribute, id);
+    UnsignedInt offset = attributeOffset(polylist, attribute, id);
 
     /* Build resulting array */
     std::vector<T> array(interleavedIndexArrays.size()/stride);
@@ -870,12 +1022,8 @@ template<class T> std::vector<T> ColladaImporter::buildAttributeArray(UnsignedIn
 }
 #endif
 
-std::string ColladaImporter::instanceName(const QString& name, const QString& instanceTag) {
-    QString tmp;
-
-    d->query.setQuery((namespaceDeclaration + "/COLLADA/library_visual_scenes/visual_scene//node[@id='%0']/%1/@url/string()").arg(name).arg(instanceTag));
-    d->query.evaluateTo(&tmp);
-    return tmp.trimmed().mid(1).toStdString();
+std::string ColladaImporter::instanceName(const std::size_t node, const char* const instanceTag) {
+    return reference(d->xml, d->xml.firstChild(node, instanceTag), "url");
 }
 
 }}
@@ -29,6 +29,7 @@
  * @brief Class @ref Magnum::Trade::ColladaImporter
  */
 
+#include <vector>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/ColladaImporter/configure.h"
@@ -49,9 +50,6 @@
 #define MAGNUM_COLLADAIMPORTER_LOCAL
 #endif
 
-class QCoreApplication;
-class QString;
-
 namespace Magnum { namespace Trade {
 
 class ColladaMeshData;
@@ -63,8 +61,8 @@ Imports the XML-based [COLLADA](https://collada.org/) format. Supports triangle
 and quad meshes, images (delegated to @ref AnyImageImporter), Phong material
 data, texture properties and scene hierarchy.
 
-This plugin depends on the @ref Trade, @ref MeshTools and [Qt 4](https://qt.io)
-libraries and the @ref AnyImageImporter plugin. It is built if
+This plugin depends on the @ref Trade and @ref MeshTools libraries and the
+@ref AnyImageImporter plugin. It is built if
 `WITH_COLLADAIMPORTER` is enabled when building Magnum Plugins. To use as a
 dynamic plugin, you need to load the @cpp "ColladaImporter" @ce plugin from
 `MAGNUM_PLUGINS_IMPORTER_DIR`. To use as a static plugin or as a dependency of
@@ -78,12 +76,27 @@ of the `MagnumPlugins` package in CMake and link to the
 @subsection Trade-ColladaImporter-limitations-meshes Mesh import
 
 -   Only quad and triangle meshes are supported
--   More than one polygon list in a single mesh is not supported
+-   All @cb{.xml} <triangles> @ce, @cb{.xml} <polylist> @ce and
+    @cb{.xml} <polygons> @ce primitive groups of a mesh are merged into a
+    single mesh, the groups are expected to have the same attributes.
+    Materials assigned to particular groups are ignored. Lines, strips, fans
+    and polygons with holes are not supported.
 -   Only vertex positions, normals and 2D texture coordinates are supported
 
 @subsection Trade-ColladaImporter-limitations-materials Material import
 
 -   Only the `COMMON` effect profile is supported
+
+@section Trade-ColladaImporter-parallel Parallel import
+
+Contents of large numeric arrays are converted on multiple threads. All meshes
+in the file can be imported at once using @ref meshes(), which is available
+when using the plugin class directly, for example when linking it statically.
+It first converts contents of all arrays in the file and then builds the
+meshes in parallel, each on a single thread. Count of threads used is
+controlled by the @cb{.ini} threadCount @ce option in the
+@cb{.ini} [configuration] @ce group of the plugin configuration, which is
+documented in the `ColladaImporter.conf` file.
 */
 class MAGNUM_COLLADAIMPORTER_EXPORT ColladaImporter: public AbstractImporter {
     public:
@@ -108,11 +121,22 @@ class MAGNUM_COLLADAIMPORTER_EXPORT ColladaImporter: public AbstractImporter {
 
         ~ColladaImporter();
 
+        /**
+         * @brief Import all meshes
+         *
+         * Expects that a file is opened. Returns the same as calling
+         * @ref mesh3D() for all IDs in range [0, @ref mesh3DCount()), with
+         * @ref Containers::NullOpt for meshes that failed to import, but
+         * the meshes are imported in parallel. See
+         * @ref Trade-ColladaImporter-parallel for more information.
+         */
+        std::vector<Containers::Optional<MeshData3D>> meshes();
+
     #ifdef DOXYGEN_GENERATING_OUTPUT
     private:
     #endif
         /* Parse the &lt;source&gt; element */
-        template<class T> std::vector<T> parseSource(const QString& id);
+        template<class T> std::vector<T> parseSource(const std::string& id);
 
     private:
         struct Document;
@@ -154,25 +178,20 @@ class MAGNUM_COLLADAIMPORTER_EXPORT ColladaImporter: public AbstractImporter {
         MAGNUM_COLLADAIMPORTER_LOCAL std::string doImage2DName(UnsignedInt id) override;
         MAGNUM_COLLADAIMPORTER_LOCAL Containers::Optional<ImageData2D> doImage2D(UnsignedInt id) override;
 
+        /* Import mesh, converting its index arrays on given count of
+           threads if not already */
+        MAGNUM_COLLADAIMPORTER_LOCAL Containers::Optional<MeshData3D> importMesh(UnsignedInt id, UnsignedInt threadCount);
+
         /* Offset of attribute in mesh index array */
-        MAGNUM_COLLADAIMPORTER_LOCAL UnsignedInt attributeOffset(UnsignedInt meshId, const QString& attribute, UnsignedInt id = 0);
+        MAGNUM_COLLADAIMPORTER_LOCAL UnsignedInt attributeOffset(std::size_t polylist, const char* attribute, UnsignedInt id = 0);
 
         /* Build attribute array */
-        template<class T> MAGNUM_COLLADAIMPORTER_LOCAL std::vector<T> buildAttributeArray(UnsignedInt meshId, const QString& attribute, UnsignedInt id, UnsignedInt stride, const std::vector<UnsignedInt>& interleavedIndexArrays);
-
-        MAGNUM_COLLADAIMPORTER_LOCAL std::string instanceName(const QString& name, const QString& instanceTag);
+        template<class T> MAGNUM_COLLADAIMPORTER_LOCAL std::vector<T> buildAttributeArray(std::size_t polylist, const char* attribute, UnsignedInt id, UnsignedInt stride, const std::vector<UnsignedInt>& interleavedIndexArrays);
 
-        /* Default namespace declaration for XQuery */
-        static const QString namespaceDeclaration;
+        MAGNUM_COLLADAIMPORTER_LOCAL std::string instanceName(std::size_t node, const char* instanceTag);
 
         /* Currently opened document */
         Document* d;
-
-        /* QCoreApplication needs pointer to 'argc', faking it by pointing here */
-        int zero;
-
-        /* QCoreApplication, which must be started in order to use QXmlQuery */
-        QCoreApplication* app;
 };
 
 }}
@@ -25,7 +25,8 @@
     DEALINGS IN THE SOFTWARE.
 */
 
-#include <QtCore/QString>
+#include <cstdlib>
+#include <string>
 #include <Magnum/Magnum.h>
 
 namespace Magnum { namespace Trade { namespace Implementation {
@@ -33,10 +34,11 @@ namespace Magnum { namespace Trade { namespace Implementation {
 template<class T> struct ColladaType;
 
 template<> struct ColladaType<UnsignedInt> {
-    static UnsignedInt fromString(const QString& str) { return str.toUInt(); }
+    static UnsignedInt fromString(const std::string& str) { return std::strtoul(str.data(), nullptr, 10); }
 };
 template<> struct ColladaType<Float> {
-    static Float fromString(const QString& str) { return str.toFloat(); }
+    /* Not exposed into std:: namespace on Android */
+    static Float fromString(const std::string& str) { return strtof(str.data(), nullptr); }
 };
 
 }}}
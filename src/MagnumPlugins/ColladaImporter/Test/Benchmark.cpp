@@ -0,0 +1,218 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/Trade/MeshData3D.h>
+
+#include "MagnumPlugins/ColladaImporter/ColladaImporter.h"
+#include "MagnumPlugins/ColladaImporter/Utility.h"
+#include "MagnumPlugins/ColladaImporter/Xml.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct ColladaImporterBenchmark: TestSuite::Tester {
+    explicit ColladaImporterBenchmark();
+
+    void parseXml();
+    void parseFloatArray();
+    void open();
+    void openImportMeshes();
+
+    private:
+        /* The data are generated on first use, so running a subset of the
+           benchmarks doesn't need to generate all of them */
+        const std::string& documentFilename();
+        Containers::ArrayView<const char> documentData();
+        const std::string& floatArrayData();
+
+        std::string _filename;
+        Containers::Array<char> _data;
+        std::string _floatArray;
+};
+
+namespace {
+
+enum: std::size_t {
+    MeshCount = 500,
+    QuadCount = 256,
+    FloatCount = 1000000
+};
+
+/* Document with many small meshes, each instanced in a scene node, similar
+   to what DCC tools export for architectural scenes */
+std::string multiMeshDocument() {
+    std::string out =
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<COLLADA xmlns=\"http://www.collada.org/2005/11/COLLADASchema\" version=\"1.4.1\">\n"
+        "  <library_geometries>\n";
+
+    for(std::size_t i = 0; i != MeshCount; ++i) {
+        const std::string id = "Mesh" + std::to_string(i);
+
+        /* Grid of 17x17 positions with per-quad normals */
+        std::string positions, normals, vcount, p;
+        for(std::size_t y = 0; y != 17; ++y)
+            for(std::size_t x = 0; x != 17; ++x)
+                positions += std::to_string(Float(x)*0.25f + Float(i)) + " " + std::to_string(Float(y)*0.25f) + " " + std::to_string(Float((x*y + i) % 7)*0.125f) + " ";
+        for(std::size_t q = 0; q != QuadCount; ++q) {
+            normals += "0 0 1 ";
+            vcount += "4 ";
+            const std::size_t x = q % 16, y = q/16;
+            for(const std::size_t vertex: {y*17 + x, y*17 + x + 1, (y + 1)*17 + x + 1, (y + 1)*17 + x})
+                p += std::to_string(vertex) + " " + std::to_string(q) + " ";
+        }
+
+        out +=
+            "    <geometry id=\"" + id + "\">\n"
+            "      <mesh>\n"
+            "        <source id=\"" + id + "Positions\">\n"
+            "          <float_array id=\"" + id + "PositionsArray\" count=\"" + std::to_string(17*17*3) + "\">" + positions + "</float_array>\n"
+            "          <technique_common>\n"
+            "            <accessor source=\"#" + id + "PositionsArray\" count=\"" + std::to_string(17*17) + "\" stride=\"3\"/>\n"
+            "          </technique_common>\n"
+            "        </source>\n"
+            "        <source id=\"" + id + "Normals\">\n"
+            "          <float_array id=\"" + id + "NormalsArray\" count=\"" + std::to_string(QuadCount*3) + "\">" + normals + "</float_array>\n"
+            "          <technique_common>\n"
+            "            <accessor source=\"#" + id + "NormalsArray\" count=\"" + std::to_string(QuadCount) + "\" stride=\"3\"/>\n"
+            "          </technique_common>\n"
+            "        </source>\n"
+            "        <vertices id=\"" + id + "Vertices\">\n"
+            "          <input semantic=\"POSITION\" source=\"#" + id + "Positions\"/>\n"
+            "        </vertices>\n"
+            "        <polylist count=\"" + std::to_string(QuadCount) + "\">\n"
+            "          <input semantic=\"VERTEX\" source=\"#" + id + "Vertices\" offset=\"0\"/>\n"
+            "          <input semantic=\"NORMAL\" source=\"#" + id + "Normals\" offset=\"1\"/>\n"
+            "          <vcount>" + vcount + "</vcount>\n"
+            "          <p>" + p + "</p>\n"
+            "        </polylist>\n"
+            "      </mesh>\n"
+            "    </geometry>\n";
+    }
+
+    out +=
+        "  </library_geometries>\n"
+        "  <library_visual_scenes>\n"
+        "    <visual_scene id=\"Scene\">\n";
+    for(std::size_t i = 0; i != MeshCount; ++i)
+        out +=
+            "      <node id=\"Node" + std::to_string(i) + "\">\n"
+            "        <translate>" + std::to_string(i) + " 0 0</translate>\n"
+            "        <instance_geometry url=\"#Mesh" + std::to_string(i) + "\"/>\n"
+            "      </node>\n";
+    out +=
+        "    </visual_scene>\n"
+        "  </library_visual_scenes>\n"
+        "  <scene>\n"
+        "    <instance_visual_scene url=\"#Scene\"/>\n"
+        "  </scene>\n"
+        "</COLLADA>\n";
+
+    return out;
+}
+
+}
+
+ColladaImporterBenchmark::ColladaImporterBenchmark() {
+    addBenchmarks({&ColladaImporterBenchmark::parseXml,
+                   &ColladaImporterBenchmark::parseFloatArray,
+                   &ColladaImporterBenchmark::open,
+                   &ColladaImporterBenchmark::openImportMeshes}, 5);
+}
+
+const std::string& ColladaImporterBenchmark::documentFilename() {
+    if(_filename.empty()) {
+        const std::string data = multiMeshDocument();
+        _filename = Utility::Directory::join(COLLADAIMPORTER_WRITE_TEST_DIR, "benchmark.dae");
+        CORRADE_INTERNAL_ASSERT_OUTPUT(Utility::Directory::write(_filename, {data.data(), data.size()}));
+    }
+    return _filename;
+}
+
+Containers::ArrayView<const char> ColladaImporterBenchmark::documentData() {
+    if(!_data) _data = Utility::Directory::read(documentFilename());
+    return _data;
+}
+
+const std::string& ColladaImporterBenchmark::floatArrayData() {
+    /* A million floats, similar to a position array of a large mesh */
+    if(_floatArray.empty()) for(std::size_t i = 0; i != FloatCount; ++i)
+        _floatArray += std::to_string(Float(i % 1000)*0.125f - 50.0f) + (i % 3 == 2 ? "\n" : " ");
+    return _floatArray;
+}
+
+void ColladaImporterBenchmark::parseXml() {
+    const Containers::ArrayView<const char> data = documentData();
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        Implementation::XmlDocument xml;
+        parsed = xml.parse(data);
+    }
+
+    CORRADE_VERIFY(parsed);
+}
+
+void ColladaImporterBenchmark::parseFloatArray() {
+    const std::string& data = floatArrayData();
+    std::vector<Float> out;
+    CORRADE_BENCHMARK(1) {
+        Implementation::Utility::parseArray({data.data(), data.size()}, out, FloatCount);
+    }
+
+    CORRADE_COMPARE(out.size(), FloatCount);
+    CORRADE_COMPARE(out[1001], -49.875f);
+}
+
+void ColladaImporterBenchmark::open() {
+    const std::string& filename = documentFilename();
+    ColladaImporter importer;
+    CORRADE_BENCHMARK(1) {
+        importer.openFile(filename);
+    }
+
+    CORRADE_COMPARE(importer.mesh3DCount(), MeshCount);
+    CORRADE_COMPARE(importer.object3DCount(), MeshCount);
+}
+
+void ColladaImporterBenchmark::openImportMeshes() {
+    const std::string& filename = documentFilename();
+    ColladaImporter importer;
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        importer.openFile(filename);
+        for(UnsignedInt i = 0; i != importer.mesh3DCount(); ++i)
+            if(importer.mesh3D(i)) ++count;
+    }
+
+    CORRADE_COMPARE(count, MeshCount);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ColladaImporterBenchmark)
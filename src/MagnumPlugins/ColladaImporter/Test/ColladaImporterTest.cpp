@@ -24,7 +24,6 @@
 */
 
 #include <sstream>
-#include <QtCore/QString>
 #include <Corrade/PluginManager/Manager.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
@@ -55,6 +54,10 @@ struct ColladaImporterTest: TestSuite::Tester {
     void objectMultipleMaterials();
 
     void mesh();
+    void meshPrimitiveGroups();
+    void meshPrimitiveGroupsDifferentAttributes();
+    void meshPrimitiveGroupsWrongPolygon();
+    void meshes();
     void material();
     void texture();
     void image();
@@ -70,6 +73,10 @@ ColladaImporterTest::ColladaImporterTest() {
               &ColladaImporterTest::objectMultipleMaterials,
 
               &ColladaImporterTest::mesh,
+              &ColladaImporterTest::meshPrimitiveGroups,
+              &ColladaImporterTest::meshPrimitiveGroupsDifferentAttributes,
+              &ColladaImporterTest::meshPrimitiveGroupsWrongPolygon,
+              &ColladaImporterTest::meshes,
               &ColladaImporterTest::material,
               &ColladaImporterTest::texture,
               &ColladaImporterTest::image});
@@ -310,6 +317,113 @@ void ColladaImporterTest::mesh() {
     CORRADE_COMPARE(mesh->textureCoords2D(1), std::vector<Vector2>(8));
 }
 
+void ColladaImporterTest::meshPrimitiveGroups() {
+    ColladaImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(COLLADAIMPORTER_TEST_DIR, "mesh-primitive-groups.dae")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 3);
+
+    /* Triangles, polylist and polygons merged together, lines and polygons
+       with holes skipped */
+    Containers::Optional<MeshData3D> mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{
+        0, 1, 2, 0, 2, 3,
+        4, 5, 6, 4, 6, 7,
+        8, 9, 10, 11, 12, 13
+    }));
+    CORRADE_COMPARE(mesh->positionArrayCount(), 1);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {1, -1, 1},
+        {1, -1, -1},
+        {1, 1, -1},
+        {1, 1, 1},
+
+        {-1, -1, 1},
+        {1, -1, 1},
+        {1, 1, 1},
+        {-1, 1, 1},
+
+        {-1, -1, 1},
+        {1, 1, 1},
+        {-1, 1, 1},
+        {1, -1, -1},
+        {1, 1, -1},
+        {1, 1, 1}
+    }));
+    CORRADE_COMPARE(mesh->normalArrayCount(), 1);
+    CORRADE_COMPARE(mesh->normals(0), (std::vector<Vector3>{
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0},
+
+        {0, 0, 1},
+        {0, 0, 1},
+        {0, 0, 1},
+        {0, 0, 1},
+
+        {0, 0, 1},
+        {0, 0, 1},
+        {0, 0, 1},
+        {1, 0, 0},
+        {1, 0, 0},
+        {1, 0, 0}
+    }));
+    CORRADE_COMPARE(mesh->textureCoords2DArrayCount(), 0);
+}
+
+void ColladaImporterTest::meshPrimitiveGroupsDifferentAttributes() {
+    ColladaImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(COLLADAIMPORTER_TEST_DIR, "mesh-primitive-groups.dae")));
+
+    std::stringstream debug;
+    Error redirectError{&debug};
+    CORRADE_COMPARE(importer.mesh3DForName("DifferentAttributes"), 1);
+    CORRADE_VERIFY(!importer.mesh3D(1));
+    CORRADE_COMPARE(debug.str(), "Trade::ColladaImporter::mesh3D(): primitive groups with different attributes are not supported\n");
+}
+
+void ColladaImporterTest::meshPrimitiveGroupsWrongPolygon() {
+    ColladaImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(COLLADAIMPORTER_TEST_DIR, "mesh-primitive-groups.dae")));
+
+    std::stringstream debug;
+    Error redirectError{&debug};
+    CORRADE_COMPARE(importer.mesh3DForName("WrongPolygon"), 2);
+    CORRADE_VERIFY(!importer.mesh3D(2));
+    CORRADE_COMPARE(debug.str(), "Trade::ColladaImporter::mesh3D(): 5 vertices per face not supported\n");
+}
+
+void ColladaImporterTest::meshes() {
+    /* Import everything on more threads than there are meshes */
+    ColladaImporter importer;
+    importer.configuration().setValue("threadCount", 8);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(COLLADAIMPORTER_TEST_DIR, "mesh.dae")));
+
+    std::vector<Containers::Optional<MeshData3D>> meshes;
+    {
+        /* The mesh that fails prints an error, possibly from a different
+           thread */
+        std::stringstream debug;
+        Error redirectError{&debug};
+        meshes = importer.meshes();
+    }
+    CORRADE_COMPARE(meshes.size(), 5);
+    CORRADE_VERIFY(!meshes[0]);
+
+    /* The result should be the same as when importing one by one */
+    for(UnsignedInt i = 1; i != meshes.size(); ++i) {
+        Containers::Optional<MeshData3D> mesh = importer.mesh3D(i);
+        CORRADE_VERIFY(mesh);
+        CORRADE_VERIFY(meshes[i]);
+        CORRADE_COMPARE(meshes[i]->indices(), mesh->indices());
+        CORRADE_COMPARE(meshes[i]->positions(0), mesh->positions(0));
+        CORRADE_COMPARE(meshes[i]->normalArrayCount(), mesh->normalArrayCount());
+        CORRADE_COMPARE(meshes[i]->textureCoords2DArrayCount(), mesh->textureCoords2DArrayCount());
+    }
+}
+
 void ColladaImporterTest::material() {
     ColladaImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(COLLADAIMPORTER_TEST_DIR, "material.dae")));
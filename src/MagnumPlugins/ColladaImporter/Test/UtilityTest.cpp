@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cstring>
+#include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Math/Constants.h>
 #include <Magnum/Math/Vector3.h>
 
 #include "MagnumPlugins/ColladaImporter/Utility.h"
@@ -35,11 +38,29 @@ struct ColladaImporterUtilityTest: TestSuite::Tester {
 
     void parseVector();
     void parseArray();
+    void parseArrayFloat();
+    void parseArrayFloatFallback();
+    void parseArrayUnsignedInt();
+    void parseArrayDifferentSize();
+    void parseArrayParallel();
+    void arraySize();
 };
 
 ColladaImporterUtilityTest::ColladaImporterUtilityTest() {
     addTests({&ColladaImporterUtilityTest::parseVector,
-              &ColladaImporterUtilityTest::parseArray});
+              &ColladaImporterUtilityTest::parseArray,
+              &ColladaImporterUtilityTest::parseArrayFloat,
+              &ColladaImporterUtilityTest::parseArrayFloatFallback,
+              &ColladaImporterUtilityTest::parseArrayUnsignedInt,
+              &ColladaImporterUtilityTest::parseArrayDifferentSize,
+              &ColladaImporterUtilityTest::parseArrayParallel,
+              &ColladaImporterUtilityTest::arraySize});
+}
+
+namespace {
+    Containers::ArrayView<const char> view(const char* const data) {
+        return {data, std::strlen(data)};
+    }
 }
 
 void ColladaImporterUtilityTest::parseVector() {
@@ -58,7 +79,7 @@ void ColladaImporterUtilityTest::parseVector() {
     CORRADE_COMPARE(Implementation::Utility::parseVector<Vector3>("2.17 3.28 5.15", 2), Vector3(2.17f, 3.28f, 0.0f));
 
     /* Moving from value */
-    int from;
+    std::size_t from;
     Implementation::Utility::parseVector<Vector2>("2.17 3.28", &(from = 0));
     CORRADE_COMPARE(from, 9);
 
@@ -79,6 +100,117 @@ void ColladaImporterUtilityTest::parseArray() {
     CORRADE_COMPARE(Implementation::Utility::parseArray<Float>("2.17 3.28 5.15", 2), (std::vector<Float>{2.17f, 3.28f}));
 }
 
+void ColladaImporterUtilityTest::parseArrayFloat() {
+    std::vector<Float> out;
+
+    /* Extremely spaceless */
+    Implementation::Utility::parseArray(view("3.14"), out, 1);
+    CORRADE_COMPARE(out, (std::vector<Float>{3.14f}));
+
+    /* Any whitespace, also long runs of it */
+    Implementation::Utility::parseArray(view("\n\t  2.17\r\n3.28\t\t                              \n  -1.5  \n"), out, 3);
+    CORRADE_COMPARE(out, (std::vector<Float>{2.17f, 3.28f, -1.5f}));
+
+    /* Signs, exponents, no integer or fractional part */
+    Implementation::Utility::parseArray(view("+1 -0 .5 5. 1e3 1.5E-2 -2.5e+1 0.000001"), out, 8);
+    CORRADE_COMPARE(out, (std::vector<Float>{1.0f, -0.0f, 0.5f, 5.0f, 1000.0f, 0.015f, -25.0f, 0.000001f}));
+
+    /* Invalid numbers are zero */
+    Implementation::Utility::parseArray(view("1.5 abc 2.5x - 3"), out, 5);
+    CORRADE_COMPARE(out, (std::vector<Float>{1.5f, 0.0f, 0.0f, 0.0f, 3.0f}));
+}
+
+void ColladaImporterUtilityTest::parseArrayFloatFallback() {
+    std::vector<Float> out;
+
+    /* Too many significant digits, too large or small exponents and special
+       values go through the standard library */
+    Implementation::Utility::parseArray(view("3.14159265358979323846264 1e30 -1.5e-30 1e-45 inf nan"), out, 6);
+    CORRADE_COMPARE(out[0], 3.14159265358979323846264f);
+    CORRADE_COMPARE(out[1], 1.0e30f);
+    CORRADE_COMPARE(out[2], -1.5e-30f);
+    CORRADE_COMPARE(out[3], 1.0e-45f);
+    CORRADE_COMPARE(out[4], Constants::inf());
+    CORRADE_VERIFY(out[5] != out[5]);
+
+    /* Exactly halfway between two floats, rounded to even */
+    Implementation::Utility::parseArray(view("16777217 16777219"), out, 2);
+    CORRADE_VERIFY(out[0] == 16777216.0f);
+    CORRADE_VERIFY(out[1] == 16777220.0f);
+}
+
+void ColladaImporterUtilityTest::parseArrayUnsignedInt() {
+    std::vector<UnsignedInt> out;
+    Implementation::Utility::parseArray(view("  0 17\n4294967295\t+3 "), out, 4);
+    CORRADE_COMPARE(out, (std::vector<UnsignedInt>{0, 17, 4294967295u, 3}));
+
+    /* Invalid numbers and numbers that don't fit are zero */
+    Implementation::Utility::parseArray(view("-1 4294967296 1.5 2"), out, 4);
+    CORRADE_COMPARE(out, (std::vector<UnsignedInt>{0, 0, 0, 2}));
+}
+
+void ColladaImporterUtilityTest::parseArrayDifferentSize() {
+    /* Previous contents are discarded */
+    std::vector<Float> out{7.0f, 7.0f, 7.0f, 7.0f};
+
+    Implementation::Utility::parseArray(view("2.17 3.28"), out, 3);
+    CORRADE_COMPARE(out, (std::vector<Float>{2.17f, 3.28f, 0.0f}));
+
+    Implementation::Utility::parseArray(view("2.17 3.28 5.15"), out, 2);
+    CORRADE_COMPARE(out, (std::vector<Float>{2.17f, 3.28f}));
+
+    Implementation::Utility::parseArray(nullptr, out, 2);
+    CORRADE_COMPARE(out, (std::vector<Float>{0.0f, 0.0f}));
+
+    Implementation::Utility::parseArray(view("1 2"), out, 0);
+    CORRADE_VERIFY(out.empty());
+}
+
+void ColladaImporterUtilityTest::parseArrayParallel() {
+    /* Large enough to be split into four chunks, with uneven whitespace so
+       the boundaries don't fall on the same place in each number */
+    std::ostringstream out;
+    std::vector<UnsignedInt> expected;
+    for(UnsignedInt i = 0; i != 300000; ++i) {
+        out << i << (i % 7 ? " " : "\n  \t");
+        expected.push_back(i);
+    }
+    const std::string data = out.str();
+
+    std::vector<UnsignedInt> parsed;
+    Implementation::Utility::parseArray({data.data(), data.size()}, parsed, expected.size(), 4);
+    CORRADE_COMPARE(parsed.size(), expected.size());
+    CORRADE_VERIFY(parsed == expected);
+
+    /* Less numbers than expected, only the tail is zero */
+    Implementation::Utility::parseArray({data.data(), data.size()}, parsed, expected.size() + 5, 4);
+    CORRADE_COMPARE(parsed.size(), expected.size() + 5);
+    CORRADE_COMPARE(parsed[expected.size() - 1], expected.back());
+    CORRADE_COMPARE(parsed.back(), 0);
+
+    /* More numbers than expected, the rest is ignored */
+    Implementation::Utility::parseArray({data.data(), data.size()}, parsed, 1000, 4);
+    CORRADE_VERIFY(parsed == std::vector<UnsignedInt>(expected.begin(), expected.begin() + 1000));
+
+    /* Floats */
+    std::vector<Float> parsedFloats;
+    Implementation::Utility::parseArray({data.data(), data.size()}, parsedFloats, expected.size(), 4);
+    CORRADE_COMPARE(parsedFloats.size(), expected.size());
+    CORRADE_COMPARE(parsedFloats[123456], 123456.0f);
+    CORRADE_COMPARE(parsedFloats.back(), Float(expected.back()));
+}
+
+void ColladaImporterUtilityTest::arraySize() {
+    CORRADE_COMPARE(Implementation::Utility::arraySize(nullptr), 0);
+    CORRADE_COMPARE(Implementation::Utility::arraySize(view(" \n\t ")), 0);
+    CORRADE_COMPARE(Implementation::Utility::arraySize(view("3")), 1);
+    CORRADE_COMPARE(Implementation::Utility::arraySize(view("\n  1 2\t3.5 x\n")), 4);
+
+    /* Long enough to go through the vectorized loop, with items crossing
+       the 16-byte boundaries */
+    CORRADE_COMPARE(Implementation::Utility::arraySize(view("0 1 22 333 4444 55555 666666 7777777 88888888 999999999 \n\n\n\n  10 11")), 12);
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::ColladaImporterUtilityTest)
@@ -0,0 +1,212 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "MagnumPlugins/ColladaImporter/Xml.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct ColladaImporterXmlTest: TestSuite::Tester {
+    explicit ColladaImporterXmlTest();
+
+    void elements();
+    void attributes();
+    void text();
+    void skipped();
+    void string();
+
+    void invalidAttribute();
+    void mismatchedEndTag();
+    void unclosed();
+    void empty();
+    void multipleRoots();
+};
+
+namespace {
+
+typedef Implementation::XmlDocument XmlDocument;
+
+Containers::ArrayView<const char> view(const char* const data) {
+    return {data, std::strlen(data)};
+}
+
+std::string name(const XmlDocument& xml, const std::size_t element) {
+    return {xml.element(element).name.data(), xml.element(element).name.size()};
+}
+
+}
+
+ColladaImporterXmlTest::ColladaImporterXmlTest() {
+    addTests({&ColladaImporterXmlTest::elements,
+              &ColladaImporterXmlTest::attributes,
+              &ColladaImporterXmlTest::text,
+              &ColladaImporterXmlTest::skipped,
+              &ColladaImporterXmlTest::string,
+
+              &ColladaImporterXmlTest::invalidAttribute,
+              &ColladaImporterXmlTest::mismatchedEndTag,
+              &ColladaImporterXmlTest::unclosed,
+              &ColladaImporterXmlTest::empty,
+              &ColladaImporterXmlTest::multipleRoots});
+}
+
+void ColladaImporterXmlTest::elements() {
+    XmlDocument xml;
+    CORRADE_VERIFY(xml.parse(view(
+        "<root>\n"
+        "  <a><b/><c></c></a>\n"
+        "  <b />\n"
+        "  <a><d/></a>\n"
+        "</root>\n")));
+
+    /* Elements are stored depth-first */
+    CORRADE_COMPARE(xml.elementCount(), 7);
+    CORRADE_VERIFY(xml.is(0, "root"));
+    CORRADE_COMPARE(name(xml, 1), "a");
+    CORRADE_COMPARE(name(xml, 2), "b");
+    CORRADE_COMPARE(name(xml, 3), "c");
+    CORRADE_COMPARE(name(xml, 4), "b");
+    CORRADE_COMPARE(name(xml, 5), "a");
+    CORRADE_COMPARE(name(xml, 6), "d");
+
+    CORRADE_COMPARE(xml.element(0).parent, std::size_t(XmlDocument::NoElement));
+    CORRADE_COMPARE(xml.element(3).parent, 1);
+    CORRADE_COMPARE(xml.element(0).end, 7);
+    CORRADE_COMPARE(xml.element(1).end, 4);
+    CORRADE_COMPARE(xml.element(2).end, 3);
+
+    /* Traversal */
+    CORRADE_COMPARE(xml.firstChild(0), 1);
+    CORRADE_COMPARE(xml.firstChild(0, "b"), 4);
+    CORRADE_COMPARE(xml.firstChild(0, "e"), std::size_t(XmlDocument::NoElement));
+    CORRADE_COMPARE(xml.firstChild(2), std::size_t(XmlDocument::NoElement));
+    CORRADE_COMPARE(xml.firstChild(XmlDocument::NoElement), std::size_t(XmlDocument::NoElement));
+    CORRADE_COMPARE(xml.nextSibling(1), 4);
+    CORRADE_COMPARE(xml.nextSibling(1, "a"), 5);
+    CORRADE_COMPARE(xml.nextSibling(5), std::size_t(XmlDocument::NoElement));
+    CORRADE_COMPARE(xml.nextSibling(0), std::size_t(XmlDocument::NoElement));
+
+    /* Only the first element with given name is taken for each path item */
+    CORRADE_COMPARE(xml.child(0, {"a", "c"}), 3);
+    CORRADE_COMPARE(xml.child(0, {"a", "d"}), std::size_t(XmlDocument::NoElement));
+    CORRADE_COMPARE(xml.child(0, {"e", "d"}), std::size_t(XmlDocument::NoElement));
+}
+
+void ColladaImporterXmlTest::attributes() {
+    XmlDocument xml;
+    CORRADE_VERIFY(xml.parse(view("<a x=\"1\" y='two' z = \"&lt;3&gt;\" empty=\"\"/>")));
+
+    CORRADE_COMPARE(xml.attributeString(0, "x"), "1");
+    CORRADE_COMPARE(xml.attributeString(0, "y"), "two");
+
+    /* Entities are decoded only in the string */
+    CORRADE_COMPARE(xml.attribute(0, "z").size(), 9);
+    CORRADE_COMPARE(xml.attributeString(0, "z"), "<3>");
+
+    /* Empty and nonexistent attribute */
+    CORRADE_VERIFY(xml.attribute(0, "empty").data());
+    CORRADE_VERIFY(xml.attribute(0, "empty").empty());
+    CORRADE_VERIFY(!xml.attribute(0, "w").data());
+    CORRADE_COMPARE(xml.attributeString(0, "w"), "");
+}
+
+void ColladaImporterXmlTest::text() {
+    XmlDocument xml;
+    CORRADE_VERIFY(xml.parse(view("<a>  hello\n<b>inner &amp; more</b> tail</a>")));
+
+    /* Text is taken only up to the first child */
+    CORRADE_COMPARE(xml.element(0).text.size(), 8);
+    CORRADE_COMPARE(xml.text(0), "hello");
+    CORRADE_COMPARE(xml.text(1), "inner & more");
+}
+
+void ColladaImporterXmlTest::skipped() {
+    XmlDocument xml;
+    CORRADE_VERIFY(xml.parse(view(
+        "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+        "<!DOCTYPE a [\n"
+        "  <!ENTITY x \"y\">\n"
+        "]>\n"
+        "<!-- <b/> -->\n"
+        "<a><![CDATA[<c/>]]><!----><d/></a>\n"
+        "<!-- trailing comment -->\n")));
+
+    CORRADE_COMPARE(xml.elementCount(), 2);
+    CORRADE_VERIFY(xml.is(0, "a"));
+    CORRADE_VERIFY(xml.is(1, "d"));
+}
+
+void ColladaImporterXmlTest::string() {
+    /* Leading and trailing whitespace */
+    CORRADE_COMPARE(XmlDocument::string(view("  \n a b \t")), "a b");
+    CORRADE_COMPARE(XmlDocument::string(view(" \n\t ")), "");
+    CORRADE_COMPARE(XmlDocument::string(nullptr), "");
+
+    /* Predefined entities and character references */
+    CORRADE_COMPARE(XmlDocument::string(view("&amp;&quot;&apos;&#65;&#x42;&#x10d;")), "&\"'AB\xc4\x8d");
+
+    /* Unknown and unterminated entities are kept */
+    CORRADE_COMPARE(XmlDocument::string(view("&unknown; &#xZ; &amp")), "&unknown; &#xZ; &amp");
+}
+
+void ColladaImporterXmlTest::invalidAttribute() {
+    XmlDocument xml;
+    CORRADE_VERIFY(!xml.parse(view("<a>\n<b x=1/>\n</a>")));
+    CORRADE_COMPARE(xml.errorLine(), 2);
+    CORRADE_COMPARE(xml.elementCount(), 0);
+}
+
+void ColladaImporterXmlTest::mismatchedEndTag() {
+    XmlDocument xml;
+    CORRADE_VERIFY(!xml.parse(view("<a>\n  <b>\n  </c>\n</a>")));
+    CORRADE_COMPARE(xml.errorLine(), 3);
+}
+
+void ColladaImporterXmlTest::unclosed() {
+    XmlDocument xml;
+    CORRADE_VERIFY(!xml.parse(view("<a>\n<b></b>\n")));
+    CORRADE_COMPARE(xml.errorLine(), 3);
+
+    CORRADE_VERIFY(!xml.parse(view("<a><!-- </a>")));
+    CORRADE_COMPARE(xml.errorLine(), 1);
+}
+
+void ColladaImporterXmlTest::empty() {
+    XmlDocument xml;
+    CORRADE_VERIFY(!xml.parse(view("<?xml version=\"1.0\"?>\n")));
+    CORRADE_COMPARE(xml.errorLine(), 2);
+}
+
+void ColladaImporterXmlTest::multipleRoots() {
+    XmlDocument xml;
+    CORRADE_VERIFY(!xml.parse(view("<a/>\n<b/>")));
+    CORRADE_COMPARE(xml.errorLine(), 2);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::ColladaImporterXmlTest)
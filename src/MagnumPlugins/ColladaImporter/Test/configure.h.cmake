@@ -30,3 +30,4 @@
 #endif
 
 #define COLLADAIMPORTER_TEST_DIR "${CMAKE_CURRENT_SOURCE_DIR}/ColladaImporterTestFiles/"
+#define COLLADAIMPORTER_WRITE_TEST_DIR "${CMAKE_CURRENT_BINARY_DIR}"
@@ -0,0 +1,397 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Utility.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+#include <thread>
+#endif
+
+/* Delimiters are searched for 16 bytes at a time where the instructions are
+   available, otherwise (and for the remaining tail) byte-by-byte. Same as in
+   the OpenDDL parser, AVX2 is not used as it would need runtime dispatch. */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAGNUM_COLLADAIMPORTER_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAGNUM_COLLADAIMPORTER_USE_NEON
+#include <arm_neon.h>
+#endif
+#if defined(MAGNUM_COLLADAIMPORTER_USE_SSE2) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+namespace {
+
+/* Each thread gets at least this many bytes, smaller arrays are parsed on the
+   calling thread */
+enum: std::size_t { MinimalChunkSize = 256*1024 };
+
+#ifdef MAGNUM_COLLADAIMPORTER_USE_SSE2
+inline UnsignedInt firstSetBit(const UnsignedInt mask) {
+    #ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+    #else
+    return __builtin_ctz(mask);
+    #endif
+}
+
+inline UnsignedInt bitCount(UnsignedInt mask) {
+    #ifdef _MSC_VER
+    /* __popcnt() needs the POPCNT instruction, which is not implied by SSE2 */
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    return (((mask + (mask >> 4)) & 0x0f0f0f0fu)*0x01010101u) >> 24;
+    #else
+    return __builtin_popcount(mask);
+    #endif
+}
+
+/* Mask of bytes that are not whitespace (i.e., > 32 in the platform-specific
+   signedness of char, same as the scalar loops) */
+inline UnsignedInt nonblankMask(const char* const i) {
+    const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+    #if CHAR_MIN < 0
+    return _mm_movemask_epi8(_mm_cmpgt_epi8(chunk, _mm_set1_epi8(32)));
+    #else
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(33)), chunk));
+    #endif
+}
+#elif defined(MAGNUM_COLLADAIMPORTER_USE_NEON)
+inline UnsignedInt firstSetBit(const std::uint64_t mask) {
+    return __builtin_ctzll(mask);
+}
+
+/* There's no movemask on NEON, each byte is narrowed to four bits instead */
+inline std::uint64_t nonblankMask(const char* const i) {
+    #if CHAR_MIN < 0
+    const uint8x16_t nonblank = vcgtq_s8(vld1q_s8(reinterpret_cast<const int8_t*>(i)), vdupq_n_s8(32));
+    #else
+    const uint8x16_t nonblank = vcgtq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(i)), vdupq_n_u8(32));
+    #endif
+    return vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(nonblank), 4)), 0);
+}
+#endif
+
+/* Skips whitespace */
+inline const char* blank(const char* i, const char* const end) {
+    #ifdef MAGNUM_COLLADAIMPORTER_USE_SSE2
+    for(; end - i >= 16; i += 16)
+        if(const UnsignedInt mask = nonblankMask(i))
+            return i + firstSetBit(mask);
+    #elif defined(MAGNUM_COLLADAIMPORTER_USE_NEON)
+    for(; end - i >= 16; i += 16)
+        if(const std::uint64_t mask = nonblankMask(i))
+            return i + firstSetBit(mask)/4;
+    #endif
+
+    while(i != end && *i <= 32) ++i;
+    return i;
+}
+
+/* Skips everything except whitespace. Numbers are short, so this checks a
+   few bytes one-by-one first before switching to the vectorized loop. */
+inline const char* nonblank(const char* i, const char* const end) {
+    for(std::size_t j = 0; j != 8; ++j, ++i)
+        if(i == end || *i <= 32) return i;
+
+    #ifdef MAGNUM_COLLADAIMPORTER_USE_SSE2
+    for(; end - i >= 16; i += 16)
+        if(const UnsignedInt mask = ~nonblankMask(i) & 0xffff)
+            return i + firstSetBit(mask);
+    #elif defined(MAGNUM_COLLADAIMPORTER_USE_NEON)
+    for(; end - i >= 16; i += 16)
+        if(const std::uint64_t mask = ~nonblankMask(i))
+            return i + firstSetBit(mask)/4;
+    #endif
+
+    while(i != end && *i > 32) ++i;
+    return i;
+}
+
+/* Counts starts of whitespace-separated tokens, i.e. non-whitespace
+   characters preceded by whitespace or the beginning of the range */
+std::size_t tokenCount(const char* i, const char* const end) {
+    std::size_t count = 0;
+    bool previousNonblank = false;
+
+    #ifdef MAGNUM_COLLADAIMPORTER_USE_SSE2
+    for(; end - i >= 16; i += 16) {
+        const UnsignedInt mask = nonblankMask(i);
+        count += bitCount(mask & ~((mask << 1)|UnsignedInt(previousNonblank)));
+        previousNonblank = mask & 0x8000;
+    }
+    #endif
+
+    for(; i != end; ++i) {
+        const bool current = *i > 32;
+        if(current && !previousNonblank) ++count;
+        previousNonblank = current;
+    }
+
+    return count;
+}
+
+constexpr bool isDecimal(const char c) {
+    return c >= '0' && c <= '9';
+}
+
+/* Powers of ten that are exactly representable in a double */
+constexpr Double PowersOfTen[]{
+    1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+    1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+    1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* Converts a decimal float without going through a string buffer. If both
+   the significand and the power of ten are exactly representable in a
+   double, a single IEEE multiplication or division gives a correctly
+   rounded double, which is then rounded to a float. The result is always
+   in the normal float range. Returns false for anything unexpected or if
+   the number doesn't fit, the caller is expected to fall back to the
+   standard library in that case. */
+bool fastFloat(const char* i, const char* const end, Float& out) {
+    /* With x87 extended precision the result would be rounded twice */
+    #if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0 && FLT_EVAL_METHOD != 1
+    static_cast<void>(i);
+    static_cast<void>(end);
+    static_cast<void>(out);
+    return false;
+    #else
+    bool negative = false;
+    if(*i == '-') {
+        negative = true;
+        ++i;
+    } else if(*i == '+') ++i;
+
+    /* Significand, leading zeros are not counted into significant digits */
+    std::uint64_t significand = 0;
+    Int digits = 0;
+    Int exponent = 0;
+    bool fraction = false;
+    bool anyDigits = false;
+    for(; i != end; ++i) {
+        const char c = *i;
+        if(isDecimal(c)) {
+            anyDigits = true;
+            if(significand || c != '0') {
+                if(++digits > 19) return false;
+                significand = significand*10 + (c - '0');
+            }
+            if(fraction) --exponent;
+        } else if(c == '.' && !fraction) fraction = true;
+        else break;
+    }
+
+    if(!anyDigits) return false;
+
+    /* Exponent */
+    if(i != end && (*i == 'e' || *i == 'E')) {
+        if(++i == end) return false;
+
+        bool negativeExponent = false;
+        if(*i == '+') ++i;
+        else if(*i == '-') {
+            negativeExponent = true;
+            ++i;
+        }
+
+        if(i == end || !isDecimal(*i)) return false;
+
+        Int value = 0;
+        for(; i != end && isDecimal(*i); ++i) {
+            if(value > 1000) return false;
+            value = value*10 + (*i - '0');
+        }
+
+        exponent += negativeExponent ? -value : value;
+    }
+
+    /* Anything else unexpected */
+    if(i != end) return false;
+
+    if(!significand) {
+        out = negative ? -0.0f : 0.0f;
+        return true;
+    }
+
+    if(significand > (1ull << 53) || exponent < -22 || exponent > 22)
+        return false;
+
+    const Double value = exponent < 0 ?
+        Double(significand)/PowersOfTen[-exponent] :
+        Double(significand)*PowersOfTen[exponent];
+
+    /* Rounding the correctly rounded double to a float gives a correctly
+       rounded float, unless the double lies exactly halfway between two
+       floats */
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(Double));
+    if((bits & 0x1fffffff) == 0x10000000) return false;
+
+    out = Float(negative ? -value : value);
+    return true;
+    #endif
+}
+
+Float parseFloat(const char* const begin, const char* const end) {
+    Float out;
+    if(fastFloat(begin, end, out)) return out;
+
+    /* The token isn't null-terminated, copy it to a local buffer. Numbers
+       that don't fit are not valid anyway. */
+    char buffer[128];
+    const std::size_t size = end - begin;
+    if(size >= sizeof(buffer)) return 0.0f;
+    std::memcpy(buffer, begin, size);
+    buffer[size] = '\0';
+
+    /* Not exposed into std:: namespace on Android */
+    char* parsedEnd;
+    out = strtof(buffer, &parsedEnd);
+    return parsedEnd == buffer + size ? out : 0.0f;
+}
+
+UnsignedInt parseUnsignedInt(const char* i, const char* const end) {
+    if(*i == '+') ++i;
+    if(i == end) return 0;
+
+    std::uint64_t out = 0;
+    for(; i != end; ++i) {
+        if(!isDecimal(*i)) return 0;
+        out = out*10 + (*i - '0');
+        if(out > 0xffffffffull) return 0;
+    }
+
+    return UnsignedInt(out);
+}
+
+inline void parse(const char* const begin, const char* const end, Float& out) {
+    out = parseFloat(begin, end);
+}
+
+inline void parse(const char* const begin, const char* const end, UnsignedInt& out) {
+    out = parseUnsignedInt(begin, end);
+}
+
+/* Parses at most `count` numbers, returns count of parsed numbers */
+template<class T> std::size_t parseRange(const char* i, const char* const end, T* const output, const std::size_t count) {
+    std::size_t parsed = 0;
+    for(; parsed != count; ++parsed) {
+        i = blank(i, end);
+        if(i == end) break;
+
+        const char* const tokenEnd = nonblank(i, end);
+        parse(i, tokenEnd, output[parsed]);
+        i = tokenEnd;
+    }
+
+    return parsed;
+}
+
+template<class T> void parseArrayInto(const Containers::ArrayView<const char> data, std::vector<T>& output, const std::size_t count, UnsignedInt threadCount) {
+    /* Numbers that are not present are zero */
+    output.clear();
+    output.resize(count);
+    if(!count) return;
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    const std::size_t chunkCount = std::min(std::size_t(threadCount), data.size()/MinimalChunkSize);
+    #else
+    static_cast<void>(threadCount);
+    const std::size_t chunkCount = 1;
+    #endif
+
+    if(chunkCount < 2) {
+        parseRange(data.begin(), data.end(), output.data(), count);
+        return;
+    }
+
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    /* Split the data into roughly equally-sized chunks, moving each boundary
+       forward to the nearest whitespace so no number is split in two */
+    std::vector<const char*> boundaries;
+    boundaries.reserve(chunkCount + 1);
+    boundaries.push_back(data.begin());
+    for(std::size_t i = 1; i != chunkCount; ++i)
+        boundaries.push_back(nonblank(std::max(boundaries.back(), data.begin() + data.size()*i/chunkCount), data.end()));
+    boundaries.push_back(data.end());
+
+    /* Count the numbers in each chunk to know where its output starts */
+    std::vector<std::size_t> offsets(chunkCount + 1);
+    {
+        std::vector<std::thread> threads;
+        threads.reserve(chunkCount - 1);
+        for(std::size_t i = 1; i != chunkCount; ++i)
+            threads.emplace_back([&boundaries, &offsets, i]() {
+                offsets[i + 1] = tokenCount(boundaries[i], boundaries[i + 1]);
+            });
+        offsets[1] = tokenCount(boundaries[0], boundaries[1]);
+        for(std::thread& thread: threads) thread.join();
+    }
+    for(std::size_t i = 0; i != chunkCount; ++i)
+        offsets[i + 1] += offsets[i];
+
+    /* Parse each chunk directly into its part of the output, ignoring
+       everything past the expected count */
+    auto parseChunk = [&boundaries, &offsets, &output, count](const std::size_t i) {
+        if(offsets[i] >= count) return;
+        parseRange(boundaries[i], boundaries[i + 1], output.data() + offsets[i], std::min(offsets[i + 1], count) - offsets[i]);
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(chunkCount - 1);
+    for(std::size_t i = 1; i != chunkCount; ++i)
+        threads.emplace_back(parseChunk, i);
+    parseChunk(0);
+    for(std::thread& thread: threads) thread.join();
+    #endif
+}
+
+}
+
+void Utility::parseArray(const Containers::ArrayView<const char> data, std::vector<Float>& output, const std::size_t count, const UnsignedInt threadCount) {
+    parseArrayInto(data, output, count, threadCount);
+}
+
+void Utility::parseArray(const Containers::ArrayView<const char> data, std::vector<UnsignedInt>& output, const std::size_t count, const UnsignedInt threadCount) {
+    parseArrayInto(data, output, count, threadCount);
+}
+
+std::size_t Utility::arraySize(const Containers::ArrayView<const char> data) {
+    return tokenCount(data.begin(), data.end());
+}
+
+}}}
@@ -25,8 +25,9 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <string>
 #include <vector>
-#include <QtCore/QString>
+#include <Corrade/Containers/ArrayView.h>
 
 #include "ColladaType.h"
 
@@ -43,16 +44,17 @@ class Utility {
          *      saved to the vector)
          *
          * Returns parsed vector and moves @c from to position of next vector.
+         * The numbers can be separated by any whitespace.
          */
-        template<class Vector> static Vector parseVector(const QString& data, int* from, std::size_t size = Vector::Size);
+        template<class Vector> static Vector parseVector(const std::string& data, std::size_t* from, std::size_t size = Vector::Size);
 
         /**
          * @brief Parse vector of numbers
          *
-         * Convenience alternative to parseVector(const QString&, int*, std::size_t).
+         * Convenience alternative to parseVector(const std::string&, std::size_t*, std::size_t).
          */
-        template<class Vector> static Vector parseVector(const QString& data, std::size_t size = Vector::Size) {
-            int from = 0;
+        template<class Vector> static Vector parseVector(const std::string& data, std::size_t size = Vector::Size) {
+            std::size_t from = 0;
             return parseVector<Vector>(data, &from, size);
         }
 
@@ -61,38 +63,68 @@ class Utility {
          * @tparam Single   Single-value data type, parsable by ColladaType.
          * @param data      Data array
          * @param count     Count of numbers
+         *
+         * Convenience alternative to @ref parseArray(Containers::ArrayView<const char>, std::vector<Float>&, std::size_t, UnsignedInt)
+         * that parses the data on a single thread.
+         */
+        template<class Single> static std::vector<Single> parseArray(const std::string& data, std::size_t count);
+
+        /**
+         * @brief Parse array of floats from UTF-8 text
+         * @param data          Whitespace-separated numbers
+         * @param output        Output array
+         * @param count         Count of numbers
+         * @param threadCount   Count of threads to use for large arrays.
+         *      If @cpp 0 @ce, @ref std::thread::hardware_concurrency() is
+         *      used.
+         *
+         * The numbers can be separated by any whitespace and are written
+         * directly into @p output, which is resized to @p count. If there's
+         * less numbers than @p count, the rest is zero, superfluous numbers
+         * are ignored. Numbers that are not valid are parsed as zero. Arrays
+         * larger than a few hundred kilobytes are split on whitespace
+         * boundaries and parsed in parallel.
+         */
+        static void parseArray(Containers::ArrayView<const char> data, std::vector<Float>& output, std::size_t count, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Parse array of unsigned integers from UTF-8 text
+         *
+         * Same as @ref parseArray(Containers::ArrayView<const char>, std::vector<Float>&, std::size_t, UnsignedInt),
+         * but for indices and counts. Numbers that are not valid or don't
+         * fit into 32 bits are parsed as zero.
          */
-        template<class Single> static std::vector<Single> parseArray(const QString& data, std::size_t count);
+        static void parseArray(Containers::ArrayView<const char> data, std::vector<UnsignedInt>& output, std::size_t count, UnsignedInt threadCount = 0);
+
+        /**
+         * @brief Count of numbers in UTF-8 text
+         *
+         * Returns count of whitespace-separated items in @p data, without
+         * checking that they are valid numbers.
+         */
+        static std::size_t arraySize(Containers::ArrayView<const char> data);
 };
 
-template<class Vector> Vector Utility::parseVector(const QString& data, int* from, std::size_t size) {
+template<class Vector> Vector Utility::parseVector(const std::string& data, std::size_t* from, std::size_t size) {
     Vector output;
-    int to;
     for(std::size_t j = 0; j != size; ++j) {
-        to = data.indexOf(' ', *from);
-        while(to == *from)
-            to = data.indexOf(' ', ++*from);
-        output[j] = ColladaType<typename Vector::Type>::fromString(data.mid(*from, to-*from));
-        *from = (to == -1 ? data.size() : to+1);
+        const std::size_t begin = data.find_first_not_of(" \t\r\n", *from);
+        if(begin == std::string::npos) {
+            *from = data.size();
+            break;
+        }
+
+        const std::size_t end = data.find_first_of(" \t\r\n", begin);
+        output[j] = ColladaType<typename Vector::Type>::fromString(data.substr(begin, end - begin));
+        *from = (end == std::string::npos ? data.size() : end + 1);
     }
 
     return output;
 }
 
-template<class Single> std::vector<Single> Utility::parseArray(const QString& data, std::size_t count) {
+template<class Single> std::vector<Single> Utility::parseArray(const std::string& data, std::size_t count) {
     std::vector<Single> output;
-    output.reserve(count);
-
-    int from = 0;
-    int to;
-    for(std::size_t i = 0; i != count; ++i) {
-        to = data.indexOf(' ', from);
-        while(to == from)
-            to = data.indexOf(' ', ++from);
-        output.push_back(ColladaType<Single>::fromString(data.mid(from, to-from)));
-        from = (to == -1 ? data.size() : to+1);
-    }
-
+    parseArray({data.data(), data.size()}, output, count, 1);
     return output;
 }
 
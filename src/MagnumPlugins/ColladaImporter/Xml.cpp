@@ -0,0 +1,359 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "Xml.h"
+
+#include <cstring>
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+namespace {
+
+inline bool isWhitespace(const char c) {
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+inline bool isNameEnd(const char c) {
+    return isWhitespace(c) || c == '/' || c == '>' || c == '=';
+}
+
+inline bool equals(const Containers::ArrayView<const char> a, const char* const b) {
+    const std::size_t size = std::strlen(b);
+    return a.size() == size && std::memcmp(a.data(), b, size) == 0;
+}
+
+inline bool equals(const Containers::ArrayView<const char> a, const Containers::ArrayView<const char> b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size()) == 0;
+}
+
+inline bool startsWith(const char* const begin, const char* const end, const char* const prefix) {
+    const std::size_t size = std::strlen(prefix);
+    return std::size_t(end - begin) >= size && std::memcmp(begin, prefix, size) == 0;
+}
+
+/* Returns end if the character is not found */
+inline const char* find(const char* const begin, const char* const end, const char c) {
+    const void* const found = std::memchr(begin, c, end - begin);
+    return found ? static_cast<const char*>(found) : end;
+}
+
+/* Returns end if the string is not found */
+const char* find(const char* begin, const char* const end, const char* const what) {
+    const std::size_t size = std::strlen(what);
+    while(std::size_t(end - begin) >= size) {
+        begin = find(begin, end - size + 1, what[0]);
+        if(begin == end - size + 1) break;
+        if(std::memcmp(begin, what, size) == 0) return begin;
+        ++begin;
+    }
+
+    return end;
+}
+
+const char* skipWhitespace(const char* i, const char* const end) {
+    while(i != end && isWhitespace(*i)) ++i;
+    return i;
+}
+
+const char* parseName(const char* i, const char* const end) {
+    while(i != end && !isNameEnd(*i)) ++i;
+    return i;
+}
+
+/* Parses attributes and end of the start tag, returns position after it or
+   nullptr on error */
+const char* parseAttributes(const char* i, const char* const end, std::vector<XmlDocument::Attribute>& attributes, bool& empty) {
+    for(;;) {
+        i = skipWhitespace(i, end);
+        if(i == end) return nullptr;
+
+        /* End of the start tag */
+        if(*i == '>') {
+            empty = false;
+            return i + 1;
+        }
+        if(*i == '/') {
+            if(i + 1 == end || i[1] != '>') return nullptr;
+            empty = true;
+            return i + 2;
+        }
+
+        /* Attribute name */
+        const char* const nameBegin = i;
+        i = parseName(i, end);
+        if(i == nameBegin) return nullptr;
+        const char* const nameEnd = i;
+
+        /* Quoted attribute value */
+        i = skipWhitespace(i, end);
+        if(i == end || *i != '=') return nullptr;
+        i = skipWhitespace(i + 1, end);
+        if(i == end || (*i != '"' && *i != '\'')) return nullptr;
+        const char* const valueBegin = i + 1;
+        const char* const valueEnd = find(valueBegin, end, *i);
+        if(valueEnd == end) return nullptr;
+
+        attributes.push_back({{nameBegin, std::size_t(nameEnd - nameBegin)}, {valueBegin, std::size_t(valueEnd - valueBegin)}});
+        i = valueEnd + 1;
+    }
+}
+
+void appendUtf8(std::string& out, const unsigned long codepoint) {
+    if(codepoint < 0x80) {
+        out += char(codepoint);
+    } else if(codepoint < 0x800) {
+        out += char(0xc0|(codepoint >> 6));
+        out += char(0x80|(codepoint & 0x3f));
+    } else if(codepoint < 0x10000) {
+        out += char(0xe0|(codepoint >> 12));
+        out += char(0x80|((codepoint >> 6) & 0x3f));
+        out += char(0x80|(codepoint & 0x3f));
+    } else {
+        out += char(0xf0|(codepoint >> 18));
+        out += char(0x80|((codepoint >> 12) & 0x3f));
+        out += char(0x80|((codepoint >> 6) & 0x3f));
+        out += char(0x80|(codepoint & 0x3f));
+    }
+}
+
+/* Decodes a numeric character reference without the leading &# and trailing
+   semicolon, returns false if it's not valid */
+bool decodeCharacterReference(const Containers::ArrayView<const char> entity, unsigned long& codepoint) {
+    const bool hexadecimal = !entity.empty() && (entity[0] == 'x' || entity[0] == 'X');
+    if(entity.size() == std::size_t(hexadecimal) || entity.size() > 8) return false;
+
+    codepoint = 0;
+    for(std::size_t i = hexadecimal; i != entity.size(); ++i) {
+        const char c = entity[i];
+        if(c >= '0' && c <= '9') codepoint = codepoint*(hexadecimal ? 16 : 10) + (c - '0');
+        else if(hexadecimal && c >= 'a' && c <= 'f') codepoint = codepoint*16 + (c - 'a' + 10);
+        else if(hexadecimal && c >= 'A' && c <= 'F') codepoint = codepoint*16 + (c - 'A' + 10);
+        else return false;
+    }
+
+    return codepoint <= 0x10ffff;
+}
+
+}
+
+std::string XmlDocument::string(const Containers::ArrayView<const char> data) {
+    const char* begin = data.begin();
+    const char* end = data.end();
+    begin = skipWhitespace(begin, end);
+    while(end != begin && isWhitespace(*(end - 1))) --end;
+
+    std::string out;
+    out.reserve(end - begin);
+    while(begin != end) {
+        const char* const ampersand = find(begin, end, '&');
+        out.append(begin, ampersand);
+        if(ampersand == end) break;
+
+        /* Keep unterminated and unknown entities verbatim */
+        const char* const semicolon = find(ampersand, end, ';');
+        if(semicolon == end) {
+            out.append(ampersand, end);
+            break;
+        }
+
+        const Containers::ArrayView<const char> entity{ampersand + 1, std::size_t(semicolon - ampersand - 1)};
+        unsigned long codepoint;
+        if(equals(entity, "lt")) out += '<';
+        else if(equals(entity, "gt")) out += '>';
+        else if(equals(entity, "amp")) out += '&';
+        else if(equals(entity, "quot")) out += '"';
+        else if(equals(entity, "apos")) out += '\'';
+        else if(!entity.empty() && entity[0] == '#' && decodeCharacterReference(entity.suffix(1), codepoint))
+            appendUtf8(out, codepoint);
+        else out.append(ampersand, semicolon + 1);
+
+        begin = semicolon + 1;
+    }
+
+    return out;
+}
+
+bool XmlDocument::parse(const Containers::ArrayView<const char> data) {
+    _elements.clear();
+    _attributes.clear();
+    _errorLine = 0;
+
+    const char* const begin = data.begin();
+    const char* const end = data.end();
+    const char* i = begin;
+    const char* error = nullptr;
+
+    /* Innermost open element */
+    std::size_t current = NoElement;
+    bool rootClosed = false;
+
+    while(i != end) {
+        /* Text, which was already attached to the element when parsing its
+           start tag */
+        if(*i != '<') {
+            i = find(i, end, '<');
+
+        /* Processing instruction, including the XML declaration */
+        } else if(startsWith(i, end, "<?")) {
+            const char* const e = find(i + 2, end, "?>");
+            if(e == end) {
+                error = i;
+                break;
+            }
+            i = e + 2;
+
+        /* Comment */
+        } else if(startsWith(i, end, "<!--")) {
+            const char* const e = find(i + 4, end, "-->");
+            if(e == end) {
+                error = i;
+                break;
+            }
+            i = e + 3;
+
+        /* CDATA section */
+        } else if(startsWith(i, end, "<![CDATA[")) {
+            const char* const e = find(i + 9, end, "]]>");
+            if(e == end) {
+                error = i;
+                break;
+            }
+            i = e + 3;
+
+        /* DOCTYPE declaration, possibly with an internal subset */
+        } else if(startsWith(i, end, "<!")) {
+            const char* e = find(i + 2, end, '>');
+            const char* const bracket = find(i + 2, e, '[');
+            if(bracket != e) e = find(find(bracket, end, ']'), end, '>');
+            if(e == end) {
+                error = i;
+                break;
+            }
+            i = e + 1;
+
+        /* End tag, has to match the innermost open element */
+        } else if(startsWith(i, end, "</")) {
+            const char* const nameEnd = parseName(i + 2, end);
+            const char* const e = skipWhitespace(nameEnd, end);
+            if(current == NoElement || e == end || *e != '>' || !equals(_elements[current].name, {i + 2, std::size_t(nameEnd - i - 2)})) {
+                error = i;
+                break;
+            }
+
+            _elements[current].end = _elements.size();
+            current = _elements[current].parent;
+            if(current == NoElement) rootClosed = true;
+            i = e + 1;
+
+        /* Start tag */
+        } else {
+            const char* const nameEnd = parseName(i + 1, end);
+            if(rootClosed || nameEnd == i + 1) {
+                error = i;
+                break;
+            }
+
+            Element element;
+            element.name = {i + 1, std::size_t(nameEnd - i - 1)};
+            element.parent = current;
+            element.attributeBegin = _attributes.size();
+
+            bool empty;
+            const char* const e = parseAttributes(nameEnd, end, _attributes, empty);
+            if(!e) {
+                error = i;
+                break;
+            }
+            element.attributeEnd = _attributes.size();
+            i = e;
+
+            /* Empty element has no contents, otherwise take the text up to
+               the next markup */
+            const std::size_t id = _elements.size();
+            if(empty) {
+                element.end = id + 1;
+                if(current == NoElement) rootClosed = true;
+            } else {
+                element.text = {i, std::size_t(find(i, end, '<') - i)};
+                current = id;
+            }
+
+            _elements.push_back(element);
+        }
+    }
+
+    /* Unclosed elements or no element at all */
+    if(!error && (current != NoElement || _elements.empty()))
+        error = end;
+
+    if(error) {
+        _errorLine = 1;
+        for(const char* j = begin; j != error; ++j)
+            if(*j == '\n') ++_errorLine;
+        _elements.clear();
+        _attributes.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool XmlDocument::is(const std::size_t element, const char* const name) const {
+    return equals(_elements[element].name, name);
+}
+
+std::size_t XmlDocument::firstChild(const std::size_t element, const char* const name) const {
+    if(element == NoElement) return NoElement;
+
+    for(std::size_t i = element + 1; i < _elements[element].end; i = _elements[i].end)
+        if(!name || equals(_elements[i].name, name)) return i;
+
+    return NoElement;
+}
+
+std::size_t XmlDocument::nextSibling(const std::size_t element, const char* const name) const {
+    const std::size_t parent = _elements[element].parent;
+    const std::size_t end = parent == NoElement ? _elements.size() : _elements[parent].end;
+    for(std::size_t i = _elements[element].end; i < end; i = _elements[i].end)
+        if(!name || equals(_elements[i].name, name)) return i;
+
+    return NoElement;
+}
+
+std::size_t XmlDocument::child(std::size_t element, const std::initializer_list<const char*> path) const {
+    for(const char* const name: path)
+        element = firstChild(element, name);
+
+    return element;
+}
+
+Containers::ArrayView<const char> XmlDocument::attribute(const std::size_t element, const char* const name) const {
+    for(std::size_t i = _elements[element].attributeBegin; i != _elements[element].attributeEnd; ++i)
+        if(equals(_attributes[i].name, name)) return _attributes[i].value;
+
+    return nullptr;
+}
+
+}}}
@@ -0,0 +1,119 @@
+#ifndef Magnum_Trade_Implementation_Xml_h
+#define Magnum_Trade_Implementation_Xml_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstddef>
+#include <initializer_list>
+#include <string>
+#include <vector>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/Magnum.h>
+
+namespace Magnum { namespace Trade { namespace Implementation {
+
+/*
+Minimal non-validating XML parser
+
+Parses the whole document in a single pass, storing only ranges pointing into
+the original data, so the data need to stay in scope for the whole lifetime
+of the document. Elements are stored depth-first, each element knows the
+index one past its last descendant, so children can be iterated without any
+additional storage. Processing instructions, comments, DOCTYPE declarations
+and CDATA sections are skipped, entities are decoded only on request using
+string().
+*/
+class XmlDocument {
+    public:
+        /* Returned when no element is found */
+        enum: std::size_t { NoElement = ~std::size_t{} };
+
+        struct Attribute {
+            Containers::ArrayView<const char> name, value;
+        };
+
+        struct Element {
+            Containers::ArrayView<const char> name;
+
+            /* Text between the start tag and first child element or end
+               tag, not decoded */
+            Containers::ArrayView<const char> text;
+
+            std::size_t parent, end;
+            std::size_t attributeBegin, attributeEnd;
+        };
+
+        /* Decode entities and strip leading and trailing whitespace */
+        static std::string string(Containers::ArrayView<const char> data);
+
+        /* Parse the document. Returns false and clears the contents on
+           error. */
+        bool parse(Containers::ArrayView<const char> data);
+
+        /* Line on which the last parse error occured */
+        std::size_t errorLine() const { return _errorLine; }
+
+        std::size_t elementCount() const { return _elements.size(); }
+
+        const Element& element(std::size_t id) const { return _elements[id]; }
+
+        /* Whether the element has given name */
+        bool is(std::size_t element, const char* name) const;
+
+        /* First child of given element with given name or any child if name
+           is nullptr. Returns NoElement if there's no such element or if
+           the element itself is NoElement. */
+        std::size_t firstChild(std::size_t element, const char* name = nullptr) const;
+
+        /* Next sibling with given name or any sibling if name is nullptr */
+        std::size_t nextSibling(std::size_t element, const char* name = nullptr) const;
+
+        /* Descendant reachable through given path of child names, for
+           example {"technique_common", "accessor"}. Returns NoElement if
+           there's no such element. */
+        std::size_t child(std::size_t element, std::initializer_list<const char*> path) const;
+
+        /* Raw attribute value, nullptr view if there's no such attribute */
+        Containers::ArrayView<const char> attribute(std::size_t element, const char* name) const;
+
+        /* Decoded attribute value, empty if there's no such attribute */
+        std::string attributeString(std::size_t element, const char* name) const {
+            return string(attribute(element, name));
+        }
+
+        /* Decoded text of the element */
+        std::string text(std::size_t element) const {
+            return string(_elements[element].text);
+        }
+
+    private:
+        std::vector<Element> _elements;
+        std::vector<Attribute> _attributes;
+        std::size_t _errorLine{};
+};
+
+}}}
+
+#endif
@@ -31,7 +31,7 @@
 
 #include <string>
 #include <vector>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/Optional.h>
 
 #include "MagnumPlugins/OpenGexImporter/visibility.h"
@@ -53,9 +53,7 @@ struct CharacterLiteral: Containers::ArrayView<const char> {
 };
 
 namespace Implementation {
-    template<Type> struct ExtractDataListItem;
-    template<class> struct ExtractIntegralDataListItem;
-    template<class> struct ExtractFloatingPointDataListItem;
+    struct DocumentDataOutput;
     enum class ParseErrorType: UnsignedInt;
     struct ParseError;
     class StructureList;
@@ -77,7 +75,9 @@ flat arrays. When traversing the parsed document, all @ref Structure and
 @ref Property objects are just tiny wrappers around references to the internal
 data of the originating document, thus you must ensure that the document is
 available for whole lifetime of these instances. On the other hand this allows
-you to copy and store these instances without worrying about performance.
+you to copy and store these instances without worrying about performance. If
+you need to go through the file just once without keeping it in memory, use
+@ref Reader instead.
 
 ## Usage
 
@@ -272,9 +272,7 @@ Containers::ArrayView<const Float> data = vertexArray.firstChild().asArray<Float
 class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Document {
     friend Property;
     friend Structure;
-    template<Type> friend struct Implementation::ExtractDataListItem;
-    template<class> friend struct Implementation::ExtractIntegralDataListItem;
-    template<class> friend struct Implementation::ExtractFloatingPointDataListItem;
+    friend Implementation::DocumentDataOutput;
 
     public:
         /**
@@ -298,11 +296,65 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Document {
         /** @brief Moving is disabled */
         Document& operator=(Document&&) = delete;
 
+        /** @brief Lazy parsing threshold */
+        std::size_t lazyParsingThreshold() const { return _lazyParsingThreshold; }
+
+        /**
+         * @brief Set lazy parsing threshold
+         * @return Reference to self (for method chaining)
+         *
+         * If set to non-zero value, data lists of numeric primitive
+         * structures that are at least @p size bytes long are not converted
+         * during @ref parse(). Only their size is calculated and the
+         * conversion is done on first call to @ref Structure::as(),
+         * @ref Structure::asArray() or @ref Structure::parseData(). Opening a
+         * large document just to inspect its hierarchy is then significantly
+         * faster. Boolean, string, reference and type data lists are always
+         * parsed immediately. Default is @cpp 0 @ce, i.e. everything is
+         * parsed immediately.
+         *
+         * The data passed to @ref parse() have to stay valid for the whole
+         * document lifetime and, because the data access modifies the
+         * document, it's not safe to access data of one document from
+         * multiple threads at once. Lazily parsed document can't be
+         * serialized using @ref serialize().
+         */
+        Document& setLazyParsingThreshold(std::size_t size) {
+            _lazyParsingThreshold = size;
+            return *this;
+        }
+
+        /** @brief Whether the storage is sized upfront */
+        bool presizeStorage() const { return _presizeStorage; }
+
+        /**
+         * @brief Size the storage upfront
+         * @return Reference to self (for method chaining)
+         *
+         * If enabled, @ref parse() first scans the data to count the
+         * structures, properties, strings and data list items of each type
+         * and allocates the storage for them at once, instead of growing it
+         * during parsing. That reduces peak memory usage of documents with
+         * large data lists to roughly a half, but the additional scan makes
+         * the parsing slower --- by less than ten percent for documents
+         * dominated by large data lists, but up to 1.5 times for documents
+         * made of many small structures. Ignored if lazy parsing is
+         * enabled, see @ref setLazyParsingThreshold(). Default is
+         * @cpp false @ce.
+         */
+        Document& setPresizeStorage(bool enabled) {
+            _presizeStorage = enabled;
+            return *this;
+        }
+
         /**
          * @brief Parse data
          * @param data                      Document data
          * @param structureIdentifiers      Structure identifiers
          * @param propertyIdentifiers       Property identifiers
+         * @param threadCount               Count of threads to parse the
+         *      data with. @cpp 0 @ce means the count is chosen based on
+         *      hardware concurrency.
          * @return Whether the parsing succeeded
          *
          * The data are appended to already parsed data. Each identifier from
@@ -310,15 +362,64 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Document {
          * list. If the parsing results in error, detailed info is printed on
          * error output and the document has undefined contents.
          *
+         * If @p threadCount is not @cpp 1 @ce, top-level structures are split
+         * into roughly equally-sized chunks which are parsed in parallel and
+         * then merged together. The resulting document is the same as when
+         * parsed on a single thread. If the data can't be split or there is
+         * an error, the data are parsed again on a single thread so the
+         * diagnostic is the same as well. Ignored on
+         * @ref CORRADE_TARGET_EMSCRIPTEN "Emscripten".
+         *
          * After parsing, all references to structure data are valid until next
          * parse call.
          */
         /** @todo some sane way to ensure that the initializer lists are valid for whole Document lifetime */
-        bool parse(Containers::ArrayView<const char> data, std::initializer_list<CharacterLiteral> structureIdentifiers, std::initializer_list<CharacterLiteral> propertyIdentifiers);
+        bool parse(Containers::ArrayView<const char> data, std::initializer_list<CharacterLiteral> structureIdentifiers, std::initializer_list<CharacterLiteral> propertyIdentifiers, UnsignedInt threadCount = 1);
+
+        /**
+         * @brief Serialize the document into a binary blob
+         *
+         * The blob can be loaded back using @ref deserialize() much faster
+         * than parsing the original text. The data are stored in native
+         * byte order, so the blob can be loaded only on a platform with the
+         * same endianness and pointer size. It also records a hash of the
+         * identifier lists the document was parsed with. Expects that the
+         * document is not lazily parsed.
+         * @see @ref setLazyParsingThreshold()
+         */
+        Containers::Array<char> serialize() const;
+
+        /**
+         * @brief Deserialize the document from a binary blob
+         * @param data                      Blob created with @ref serialize()
+         * @param structureIdentifiers      Structure identifiers
+         * @param propertyIdentifiers       Property identifiers
+         * @return Whether the deserialization succeeded
+         *
+         * Expects that the document is empty. The identifier lists have to
+         * be the same as the ones the serialized document was parsed with.
+         * The blob contents are checked so a corrupted or incompatible blob
+         * results in an error instead of a crash. If deserialization fails,
+         * detailed info is printed on error output and the document has
+         * undefined contents. All data are copied into the document, so
+         * @p data doesn't need to stay valid afterwards. This also means the
+         * time and memory needed for deserialization grows with the document
+         * size, the document can't be used directly over a memory-mapped
+         * blob.
+         */
+        bool deserialize(Containers::ArrayView<const char> data, std::initializer_list<CharacterLiteral> structureIdentifiers, std::initializer_list<CharacterLiteral> propertyIdentifiers);
 
         /** @brief Whether the document is empty */
         bool isEmpty() { return _structures.empty(); }
 
+        /**
+         * @brief Count of all structures in the document
+         *
+         * Includes also nested structures.
+         * @see @ref Structure::index()
+         */
+        std::size_t structureCount() const { return _structures.size(); }
+
         /**
          * @brief Find first top-level structure in the document
          *
@@ -415,21 +516,36 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Document {
          * expected structure so you can use @ref firstChildOf(),
          * @ref Structure::firstChildOf(), @ref Structure::propertyOf() etc.
          * without additional validation.
+         *
+         * The specification is first converted to lookup tables indexed by
+         * identifier ID and then all structures are checked in a single
+         * linear pass, so the time spent doesn't depend on size of the
+         * specification.
          */
         bool validate(Validation::Structures allowedRootStructures, std::initializer_list<Validation::Structure> structures) const;
 
     private:
         struct PropertyData;
         struct StructureData;
+        struct LazyData;
+
+        /* Open-addressing hash table of structure name hashes and indices */
+        typedef std::vector<std::pair<std::size_t, std::size_t>> NameIndex;
 
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL void reserveStorage(Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references);
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* parseProperty(Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Int position, Implementation::ParseError& error);
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL std::pair<const char*, std::size_t> parseStructure(std::size_t parent, Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Implementation::ParseError& error);
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* parseStructureList(std::size_t parent, Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Implementation::ParseError& error);
 
-        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL std::size_t dereference(std::size_t originatingStructure, Containers::ArrayView<const char> reference) const;
+        #ifndef CORRADE_TARGET_EMSCRIPTEN
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL bool parseParallel(Containers::ArrayView<const char> data, UnsignedInt threadCount, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references);
+        #endif
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL std::size_t append(Document& other, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, const std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& otherReferences);
 
-        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL bool validateLevel(const Containers::Optional<Structure>& first, Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowedStructures, Containers::ArrayView<const Validation::Structure> structures, std::vector<Int>& counts) const;
-        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL bool validateStructure(Structure structure, const Validation::Structure& validation, Containers::ArrayView<const Validation::Structure> structures, std::vector<Int>& counts) const;
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL bool parseLazyData(const StructureData& data) const;
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* lazyData(const StructureData& data) const;
+
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL std::size_t dereference(const NameIndex& names, std::size_t originatingStructure, Containers::ArrayView<const char> reference) const;
 
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* structureName(Int identifier) const;
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* propertyName(Int identifier) const;
@@ -449,7 +565,7 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Document {
         std::vector<Long> _longs;
         std::vector<UnsignedLong> _unsignedLongs;
         #endif
-        /** @todo Half */
+        std::vector<Half> _halves;
         std::vector<Float> _floats;
         std::vector<Double> _doubles;
         std::vector<std::string> _strings;
@@ -459,8 +575,19 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Document {
         std::vector<PropertyData> _properties;
         std::vector<StructureData> _structures;
 
+        bool _presizeStorage{};
+
+        /* Data lists that are parsed on first access, indexed by
+           StructureData::Primitive::begin of lazy structures */
+        std::size_t _lazyParsingThreshold{};
+        Containers::ArrayView<const char> _lazySource;
+        mutable std::vector<LazyData> _lazyData;
+
         Containers::ArrayView<const CharacterLiteral> _structureIdentifiers;
         Containers::ArrayView<const CharacterLiteral> _propertyIdentifiers;
+        /* Hash tables of IDs for the above identifier lists */
+        std::vector<Int> _structureIdentifierTable;
+        std::vector<Int> _propertyIdentifierTable;
 };
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
@@ -478,7 +605,7 @@ _c(Int, _ints)
 _c(UnsignedLong, _unsignedLongs)
 _c(Long, _longs)
 #endif
-/** @todo Half */
+_c(Half, _halves)
 _c(Float, _floats)
 _c(Double, _doubles)
 _c(std::string, _strings)
@@ -500,7 +627,7 @@ _c(Int, Int)
 _c(UnsignedLong, UnsignedLong)
 _c(Long, Long)
 #endif
-/** @todo Half */
+_c(Half, Half)
 _c(Float, Float)
 _c(Double, Double)
 _c(String, std::string)
@@ -522,16 +649,18 @@ struct MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL Document::StructureData {
        replaced with real one */
     explicit StructureData() noexcept: name{}, custom{UnknownIdentifier, 0, 0, 0}, parent{0}, next{0} {}
 
-    explicit StructureData(Type type, std::size_t name, std::size_t subArraySize, std::size_t dataBegin, std::size_t dataSize, std::size_t parent, std::size_t next) noexcept;
+    explicit StructureData(Type type, std::size_t name, std::size_t subArraySize, std::size_t dataBegin, std::size_t dataSize, std::size_t parent, std::size_t next, bool lazy = false) noexcept;
 
     explicit StructureData(Int type, std::size_t name, std::size_t propertyBegin, std::size_t propertySize, std::size_t firstChild, std::size_t parent, std::size_t next) noexcept;
 
     std::size_t name;
 
     struct Primitive {
-        constexpr explicit Primitive(Type type, std::size_t subArraySize, std::size_t begin, std::size_t size) noexcept: type{type}, subArraySize{subArraySize}, begin{begin}, size{size} {}
+        constexpr explicit Primitive(Type type, std::size_t subArraySize, std::size_t begin, std::size_t size, bool lazy) noexcept: type{type}, lazy{lazy}, subArraySize{subArraySize}, begin{begin}, size{size} {}
 
         Type type;
+        /* If set, begin is an index into Document::_lazyData */
+        bool lazy;
         std::size_t subArraySize;
 
         std::size_t begin;
@@ -557,6 +686,16 @@ struct MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL Document::StructureData {
     std::size_t parent;
     std::size_t next;
 };
+
+struct MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL Document::LazyData {
+    /* Whole source data for error reporting and the data list itself */
+    Containers::ArrayView<const char> source;
+    Containers::ArrayView<const char> list;
+
+    /* Converted data, filled with zeros if the parsing failed */
+    Containers::Array<char> data;
+    bool loaded, parsed;
+};
 #endif
 
 namespace Implementation {
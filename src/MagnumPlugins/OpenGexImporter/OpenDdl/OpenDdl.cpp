@@ -24,12 +24,18 @@
 */
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
 #include <tuple>
 #include <memory>
+#include <thread>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Utility/Debug.h>
 
 #include "MagnumPlugins/OpenGexImporter/OpenDdl/Document.h"
 #include "MagnumPlugins/OpenGexImporter/OpenDdl/Property.h"
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Reader.h"
 #include "MagnumPlugins/OpenGexImporter/OpenDdl/Structure.h"
 #include "MagnumPlugins/OpenGexImporter/OpenDdl/Validation.h"
 
@@ -52,7 +58,7 @@ Debug& operator<<(Debug& debug, const Type value) {
         _c(UnsignedLong)
         _c(Long)
         #endif
-        /** @todo Half */
+        _c(Half)
         _c(Float)
         _c(Double)
         _c(String)
@@ -81,7 +87,7 @@ Debug& operator<<(Debug& debug, const PropertyType value) {
         _c(UnsignedLong)
         _c(Long)
         #endif
-        /** @todo Half */
+        _c(Half)
         _c(Float)
         _c(Double)
         _c(String)
@@ -94,6 +100,37 @@ Debug& operator<<(Debug& debug, const PropertyType value) {
     return debug << "OpenDdl::PropertyType(" << Debug::nospace << reinterpret_cast<void*>(UnsignedByte(value)) << Debug::nospace << ")";
 }
 
+Float unpackHalf(const Half value) {
+    const UnsignedInt bits = UnsignedShort(value);
+    const UnsignedInt sign = (bits & 0x8000) << 16;
+    UnsignedInt exponent = (bits >> 10) & 0x1f;
+    UnsignedInt mantissa = bits & 0x3ff;
+
+    UnsignedInt out;
+    /* Infinity and NaN */
+    if(exponent == 0x1f) out = sign | 0x7f800000 | (mantissa << 13);
+
+    /* Normalized value, rebias the exponent */
+    else if(exponent) out = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+
+    /* Zero */
+    else if(!mantissa) out = sign;
+
+    /* Denormal, normalize it as single-precision has enough range */
+    else {
+        exponent = 127 - 15 + 1;
+        while(!(mantissa & 0x400)) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        out = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    }
+
+    Float result;
+    std::memcpy(&result, &out, sizeof(Float));
+    return result;
+}
+
 namespace Implementation {
     Debug& operator<<(Debug& debug, const InternalPropertyType value) {
         switch(value) {
@@ -158,146 +195,525 @@ bool checkReferencePrefix(Containers::Optional<Structure> s, Containers::ArrayVi
     return true;
 }
 
+std::size_t nameHash(const Containers::ArrayView<const char> name) {
+    /* FNV-1a */
+    UnsignedInt hash = 2166136261u;
+    for(const char c: name) {
+        hash ^= UnsignedByte(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Builds an open-addressing hash table with identifier IDs, sized to at most
+   half full so the probe sequences stay short. If an identifier is in the
+   list more than once, the first occurrence wins. */
+void identifierTable(const Containers::ArrayView<const CharacterLiteral> identifiers, std::vector<Int>& table) {
+    std::size_t size = 4;
+    while(size < identifiers.size()*2) size *= 2;
+    table.assign(size, UnknownIdentifier);
+
+    for(std::size_t i = 0; i != identifiers.size(); ++i) {
+        for(std::size_t j = nameHash(identifiers[i]) & (size - 1); ; j = (j + 1) & (size - 1)) {
+            if(table[j] == UnknownIdentifier) {
+                table[j] = i;
+                break;
+            }
+
+            if(Implementation::equals(identifiers[table[j]], identifiers[i])) break;
+        }
+    }
+}
+
+Int identifierId(const Containers::ArrayView<const char> data, const Containers::ArrayView<const CharacterLiteral> identifiers, const std::vector<Int>& table) {
+    for(std::size_t j = nameHash(data) & (table.size() - 1); table[j] != UnknownIdentifier; j = (j + 1) & (table.size() - 1))
+        if(Implementation::equals(data, identifiers[table[j]])) return table[j];
+
+    return UnknownIdentifier;
+}
+
+void printParseError(const char* const function, const Containers::ArrayView<const char> data, const Implementation::ParseError& error) {
+    /* Calculate line number */
+    std::size_t line = 1;
+    for(char c: data.prefix(error.position)) if(c == '\n') ++line;
+
+    Error e;
+    e << function;
+
+    switch(error.error) {
+        case Implementation::ParseErrorType::InvalidEscapeSequence:
+            e << "invalid escape sequence";
+            break;
+        case Implementation::ParseErrorType::InvalidIdentifier:
+            e << "invalid identifier";
+            break;
+        case Implementation::ParseErrorType::InvalidName:
+            e << "invalid name";
+            break;
+        case Implementation::ParseErrorType::InvalidCharacterLiteral:
+            e << "invalid character literal";
+            break;
+        case Implementation::ParseErrorType::InvalidPropertyValue:
+            e << "invalid property value";
+            break;
+        case Implementation::ParseErrorType::InvalidSubArraySize:
+            e << "invalid subarray size";
+            break;
+        case Implementation::ParseErrorType::LiteralOutOfRange:
+            e << (error.type == Type::String ? "unterminated string literal" : "numeric literal out of range");
+            break;
+        case Implementation::ParseErrorType::ExpectedIdentifier:
+            e << "expected identifier";
+            break;
+        case Implementation::ParseErrorType::ExpectedName:
+            e << "expected name";
+            break;
+        case Implementation::ParseErrorType::ExpectedSeparator:
+            e << "expected , character";
+            break;
+        case Implementation::ParseErrorType::ExpectedListStart:
+            e << "expected { character";
+            break;
+        case Implementation::ParseErrorType::ExpectedListEnd:
+            e << "expected } character";
+            break;
+        case Implementation::ParseErrorType::ExpectedArraySizeEnd:
+            e << "expected ] character";
+            break;
+        case Implementation::ParseErrorType::ExpectedPropertyValue:
+            e << "expected property value";
+            break;
+        case Implementation::ParseErrorType::ExpectedPropertyAssignment:
+            e << "expected = character";
+            break;
+        case Implementation::ParseErrorType::ExpectedPropertyListEnd:
+            e << "expected ) character";
+            break;
+
+        case Implementation::ParseErrorType::InvalidLiteral:
+        case Implementation::ParseErrorType::ExpectedLiteral: {
+            e << (error.error == Implementation::ParseErrorType::InvalidLiteral ? "invalid" : "expected");
+
+            switch(error.type) {
+                #define _c(type, identifier) \
+                    case Type::type: e << #identifier; break;
+                _c(Bool, bool)
+                _c(Byte, int8)
+                _c(UnsignedByte, unsigned_int8)
+                _c(Short, int16)
+                _c(UnsignedShort, unsigned_int16)
+                _c(Int, int32)
+                _c(UnsignedInt, unsigned_int32)
+                #ifndef MAGNUM_TARGET_WEBGL
+                _c(Long, int64)
+                _c(UnsignedLong, unsigned_int64)
+                #endif
+                _c(Half, half)
+                _c(Float, float)
+                _c(Double, double)
+                _c(String, string)
+                _c(Reference, ref)
+                _c(Type, type)
+                #undef _c
+                case Type::Custom:
+                    CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            }
+
+            e << "literal";
+
+            break;
+        }
+
+        case Implementation::ParseErrorType::NoError:
+            CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+
+    e << "on line" << line;
+}
+
 }
 
-std::size_t Document::dereference(const std::size_t originatingStructure, const Containers::ArrayView<const char> reference) const {
+std::size_t Document::dereference(const NameIndex& names, const std::size_t originatingStructure, const Containers::ArrayView<const char> reference) const {
     CORRADE_INTERNAL_ASSERT(!reference.empty());
 
+    /* The structures were put into the table in order, so when following the
+       probe sequence the first match is also the first in the document */
     const Containers::ArrayView<const char> leafName = reference.suffix(Implementation::findLastOf(reference, "$%"));
+    const std::size_t hash = nameHash(leafName);
+    const std::size_t mask = names.size() - 1;
 
-    /* If the reference is a single local name, try to find in in siblings first */
+    /* If the reference is a single local name, try to find in in siblings
+       first */
     if(leafName.begin() == reference.begin() && reference[0] == '%') {
         const std::size_t parentIndex = _structures[originatingStructure].parent;
-        std::size_t i = parentIndex == NoParent ? 0 : _structures[parentIndex].custom.firstChild;
-        for(Containers::Optional<Structure> s{Structure{*this, _structures[i]}}; s; i = s->_data.get().next, s = s->findNext())
-            if(Implementation::equals(leafName, {s->name().data(), s->name().size()})) return i;
+        for(std::size_t i = hash & mask; names[i].second != NullReference; i = (i + 1) & mask) {
+            if(names[i].first != hash || _structures[names[i].second].parent != parentIndex) continue;
+
+            const Structure s{*this, _structures[names[i].second]};
+            if(Implementation::equals(leafName, {s.name().data(), s.name().size()}))
+                return names[i].second;
+        }
     }
 
     /* The element which has leaf name is the result if also the rest of the
        reference prefix matches in parent structures */
     const Containers::ArrayView<const char> referencePrefix = reference.prefix(leafName.begin());
-    for(std::size_t i = 0; i != _structures.size(); ++i) {
-        const Structure s{*this, _structures[i]};
-        if(s.hasName() && Implementation::equals(leafName, {s.name().data(), s.name().size()}) && checkReferencePrefix(s.parent(), referencePrefix))
-            return i;
+    for(std::size_t i = hash & mask; names[i].second != NullReference; i = (i + 1) & mask) {
+        if(names[i].first != hash) continue;
+
+        const Structure s{*this, _structures[names[i].second]};
+        if(Implementation::equals(leafName, {s.name().data(), s.name().size()}) && checkReferencePrefix(s.parent(), referencePrefix))
+            return names[i].second;
     }
 
     return NullReference;
 }
 
-bool Document::parse(Containers::ArrayView<const char> data, const std::initializer_list<CharacterLiteral> structureIdentifiers, const std::initializer_list<CharacterLiteral> propertyIdentifiers) {
-    _structureIdentifiers = {structureIdentifiers.begin(), structureIdentifiers.size()};
-    _propertyIdentifiers = {propertyIdentifiers.begin(), propertyIdentifiers.size()};
+namespace {
 
-    Implementation::ParseError error;
-    std::string buffer;
+/* Storage needed for a document, indexed by Type for the data */
+struct StorageSize {
+    std::size_t structures, properties, strings;
+    std::size_t data[std::size_t(Type::Custom)];
+};
+
+/* Skips a string or character literal, returns pointer to the closing quote
+   or nullptr if the literal is not terminated */
+const char* literalEnd(const char* i, const char* const end) {
+    const char quote = *i;
+    for(++i; i != end && *i != quote; ++i)
+        if(*i == '\\' && i + 1 != end) ++i;
+    return i == end ? nullptr : i;
+}
 
+/* Calculates storage needed for a structure list without parsing any values,
+   returning pointer to the end of the list. The structure is only loosely
+   checked, on failure nullptr is returned and the parser reports the
+   error. */
+const char* storageSize(const Containers::ArrayView<const char> data, StorageSize& size) {
+    Implementation::ParseError error;
+    const char* const end = data.end();
     const char* i = Implementation::whitespace(data);
-    std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>> references;
-    i = parseStructureList(NoParent, data.suffix(i), references, buffer, error);
+    while(i != end && *i != '}') {
+        const char* const identifier = Implementation::identifier(data.suffix(i), error);
+        if(!identifier) return nullptr;
+        ++size.structures;
 
-    if(!i) {
-        /* Calculate line number */
-        std::size_t line = 1;
-        for(char c: data.prefix(error.position)) if(c == '\n') ++line;
+        const char* primitive;
+        Type type;
+        std::tie(primitive, type) = Implementation::possiblyTypeLiteral(data.slice(i, identifier));
+        i = Implementation::whitespace(data.suffix(identifier));
 
-        Error e;
-        e << "OpenDdl::Document::parse():";
+        /* Array size */
+        std::size_t subArraySize = 0;
+        if(primitive && i != end && *i == '[') {
+            i = Implementation::whitespace(data.suffix(i + 1));
+            std::tie(i, subArraySize, std::ignore) = Implementation::integralLiteral<std::size_t>(data.suffix(i), error);
+            if(!i) return nullptr;
+            i = Implementation::whitespace(data.suffix(i));
+            if(i == end || *i != ']') return nullptr;
+            i = Implementation::whitespace(data.suffix(i + 1));
+        }
 
-        switch(error.error) {
-            case Implementation::ParseErrorType::InvalidEscapeSequence:
-                e << "invalid escape sequence";
-                break;
-            case Implementation::ParseErrorType::InvalidIdentifier:
-                e << "invalid identifier";
-                break;
-            case Implementation::ParseErrorType::InvalidName:
-                e << "invalid name";
-                break;
-            case Implementation::ParseErrorType::InvalidCharacterLiteral:
-                e << "invalid character literal";
-                break;
-            case Implementation::ParseErrorType::InvalidPropertyValue:
-                e << "invalid property value";
-                break;
-            case Implementation::ParseErrorType::InvalidSubArraySize:
-                e << "invalid subarray size";
-                break;
-            case Implementation::ParseErrorType::LiteralOutOfRange:
-                e << (error.type == Type::String ? "unterminated string literal" : "numeric literal out of range");
-                break;
-            case Implementation::ParseErrorType::ExpectedIdentifier:
-                e << "expected identifier";
-                break;
-            case Implementation::ParseErrorType::ExpectedName:
-                e << "expected name";
-                break;
-            case Implementation::ParseErrorType::ExpectedSeparator:
-                e << "expected , character";
-                break;
-            case Implementation::ParseErrorType::ExpectedListStart:
-                e << "expected { character";
+        /* Name */
+        if(i != end && (*i == '%' || *i == '$')) {
+            i = Implementation::identifier(data.suffix(i + 1), error);
+            if(!i) return nullptr;
+            ++size.strings;
+            i = Implementation::whitespace(data.suffix(i));
+        }
+
+        /* Property list, each property has exactly one assignment and string
+           values are stored separately */
+        if(!primitive && i != end && *i == '(') {
+            for(++i; i != end && *i != ')'; ++i) switch(*i) {
+                case '=':
+                    ++size.properties;
+                    break;
+                case '"':
+                    ++size.strings;
+                    if(!(i = literalEnd(i, end))) return nullptr;
+                    break;
+                case '\'':
+                    if(!(i = literalEnd(i, end))) return nullptr;
+                    break;
+            }
+            if(i == end) return nullptr;
+            i = Implementation::whitespace(data.suffix(i + 1));
+        }
+
+        if(i == end || *i != '{') return nullptr;
+
+        /* Data list */
+        if(primitive) {
+            const std::pair<const char*, std::size_t> listSize = Implementation::dataListSize(data.suffix(i + 1), subArraySize);
+            if(!listSize.first) return nullptr;
+            size.data[std::size_t(type)] += listSize.second;
+            i = listSize.first;
+
+        /* Substructures */
+        } else {
+            i = storageSize(data.suffix(i + 1), size);
+            if(!i || i == end) return nullptr;
+        }
+
+        i = Implementation::whitespace(data.suffix(i + 1));
+    }
+
+    return i;
+}
+
+}
+
+void Document::reserveStorage(const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references) {
+    /* If the data can't be scanned, the storage grows as usual */
+    StorageSize size{};
+    if(!storageSize(data, size)) return;
+
+    _structures.reserve(_structures.size() + size.structures);
+    _properties.reserve(_properties.size() + size.properties);
+    _strings.reserve(_strings.size() + size.strings + size.data[std::size_t(Type::String)]);
+    references.reserve(references.size() + size.data[std::size_t(Type::Reference)]);
+
+    #define _c(type, T) \
+        this->data<T>().reserve(this->data<T>().size() + size.data[std::size_t(Type::type)]);
+    _c(Bool, bool)
+    _c(UnsignedByte, UnsignedByte)
+    _c(Byte, Byte)
+    _c(UnsignedShort, UnsignedShort)
+    _c(Short, Short)
+    _c(UnsignedInt, UnsignedInt)
+    _c(Int, Int)
+    #ifndef MAGNUM_TARGET_WEBGL
+    _c(UnsignedLong, UnsignedLong)
+    _c(Long, Long)
+    #endif
+    _c(Half, Half)
+    _c(Float, Float)
+    _c(Double, Double)
+    _c(Type, Type)
+    #undef _c
+}
+
+#ifndef CORRADE_TARGET_EMSCRIPTEN
+bool Document::parseParallel(const Containers::ArrayView<const char> data, const UnsignedInt threadCount, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references) {
+    /* Find top-level structure boundaries and split the data into roughly
+       equally-sized chunks, at most one for each thread. If the boundaries
+       can't be found, bail out and let the sequential parser report the
+       error. */
+    std::vector<Containers::ArrayView<const char>> chunks;
+    const std::size_t chunkSize = data.size()/threadCount;
+    const char* chunkBegin = data;
+    for(const char* i = data; i != data.end(); ) {
+        const char* const end = Implementation::structureEnd(data.suffix(i));
+        if(!end) return false;
+
+        i = Implementation::whitespace(data.suffix(end));
+        if(i == data.end() || (std::size_t(i - chunkBegin) >= chunkSize && chunks.size() + 1 < threadCount)) {
+            chunks.push_back(data.slice(chunkBegin, i));
+            chunkBegin = i;
+        }
+    }
+
+    /* Not worth it */
+    if(chunks.size() < 2) return false;
+
+    /* Parse each chunk into a separate document, the first one on this
+       thread */
+    struct Chunk {
+        Document document;
+        std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>> references;
+        bool parsed;
+    };
+    std::vector<Chunk> parsed(chunks.size());
+    auto parseChunk = [this, &chunks, &parsed](const std::size_t id) {
+        Document& document = parsed[id].document;
+        document._structureIdentifiers = _structureIdentifiers;
+        document._propertyIdentifiers = _propertyIdentifiers;
+        document._structureIdentifierTable = _structureIdentifierTable;
+        document._propertyIdentifierTable = _propertyIdentifierTable;
+        document._lazyParsingThreshold = _lazyParsingThreshold;
+        document._lazySource = _lazySource;
+
+        if(_presizeStorage && !_lazyParsingThreshold)
+            document.reserveStorage(chunks[id], parsed[id].references);
+
+        Implementation::ParseError error;
+        std::string buffer;
+        parsed[id].parsed = document.parseStructureList(NoParent, chunks[id], parsed[id].references, buffer, error) == chunks[id].end();
+    };
+    std::vector<std::thread> threads;
+    threads.reserve(chunks.size() - 1);
+    for(std::size_t i = 1; i != chunks.size(); ++i)
+        threads.emplace_back(parseChunk, i);
+    parseChunk(0);
+    for(std::thread& thread: threads) thread.join();
+
+    for(const Chunk& chunk: parsed) if(!chunk.parsed) return false;
+
+    /* Merge the chunks, connecting last top-level structure of each chunk to
+       the first one of the next */
+    std::size_t last = append(parsed[0].document, references, parsed[0].references);
+    for(std::size_t i = 1; i != parsed.size(); ++i) {
+        const std::size_t first = _structures.size();
+        _structures[last].next = first;
+        last = append(parsed[i].document, references, parsed[i].references);
+    }
+
+    return true;
+}
+#endif
+
+std::size_t Document::append(Document& other, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, const std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& otherReferences) {
+    const std::size_t structureOffset = _structures.size();
+    const std::size_t propertyOffset = _properties.size();
+    const std::size_t lazyDataOffset = _lazyData.size();
+    /* First string is reserved for empty names in both documents */
+    const std::size_t stringOffset = _strings.size() - 1;
+
+    /* Offsets of primitive data, indexed by type */
+    std::size_t dataOffsets[UnsignedInt(Type::Custom)];
+    #define _c(type, T) \
+        dataOffsets[UnsignedInt(Type::type)] = dataPosition<Type::type>(); \
+        data<T>().insert(data<T>().end(), other.data<T>().begin(), other.data<T>().end());
+    _c(Bool, bool)
+    _c(UnsignedByte, UnsignedByte)
+    _c(Byte, Byte)
+    _c(UnsignedShort, UnsignedShort)
+    _c(Short, Short)
+    _c(UnsignedInt, UnsignedInt)
+    _c(Int, Int)
+    #ifndef MAGNUM_TARGET_WEBGL
+    _c(UnsignedLong, UnsignedLong)
+    _c(Long, Long)
+    #endif
+    _c(Half, Half)
+    _c(Float, Float)
+    _c(Double, Double)
+    _c(Type, Type)
+    #undef _c
+    dataOffsets[UnsignedInt(Type::String)] = stringOffset;
+    dataOffsets[UnsignedInt(Type::Reference)] = references.size();
+    _strings.insert(_strings.end(), std::make_move_iterator(other._strings.begin() + 1), std::make_move_iterator(other._strings.end()));
+    _lazyData.insert(_lazyData.end(), std::make_move_iterator(other._lazyData.begin()), std::make_move_iterator(other._lazyData.end()));
+
+    /* References are resolved only after everything is merged */
+    references.reserve(references.size() + otherReferences.size());
+    for(const std::pair<std::size_t, Containers::ArrayView<const char>>& reference: otherReferences)
+        references.emplace_back(reference.first + structureOffset, reference.second);
+
+    _properties.reserve(_properties.size() + other._properties.size());
+    for(PropertyData property: other._properties) {
+        switch(property.type) {
+            case Implementation::InternalPropertyType::Bool:
+                property.position += dataOffsets[UnsignedInt(Type::Bool)];
                 break;
-            case Implementation::ParseErrorType::ExpectedListEnd:
-                e << "expected } character";
+            case Implementation::InternalPropertyType::Binary:
+            case Implementation::InternalPropertyType::Character:
+            case Implementation::InternalPropertyType::Integral:
+                property.position += dataOffsets[UnsignedInt(Type::Int)];
                 break;
-            case Implementation::ParseErrorType::ExpectedArraySizeEnd:
-                e << "expected ] character";
+            case Implementation::InternalPropertyType::Float:
+                property.position += dataOffsets[UnsignedInt(Type::Float)];
                 break;
-            case Implementation::ParseErrorType::ExpectedPropertyValue:
-                e << "expected property value";
+            case Implementation::InternalPropertyType::String:
+                property.position += dataOffsets[UnsignedInt(Type::String)];
                 break;
-            case Implementation::ParseErrorType::ExpectedPropertyAssignment:
-                e << "expected = character";
+            case Implementation::InternalPropertyType::Reference:
+                property.position += dataOffsets[UnsignedInt(Type::Reference)];
                 break;
-            case Implementation::ParseErrorType::ExpectedPropertyListEnd:
-                e << "expected ) character";
+            case Implementation::InternalPropertyType::Type:
+                property.position += dataOffsets[UnsignedInt(Type::Type)];
                 break;
+        }
 
-            case Implementation::ParseErrorType::InvalidLiteral:
-            case Implementation::ParseErrorType::ExpectedLiteral: {
-                e << (error.error == Implementation::ParseErrorType::InvalidLiteral ? "invalid" : "expected");
-
-                switch(error.type) {
-                    #define _c(type, identifier) \
-                        case Type::type: e << #identifier; break;
-                    _c(Bool, bool)
-                    _c(Byte, int8)
-                    _c(UnsignedByte, unsigned_int8)
-                    _c(Short, int16)
-                    _c(UnsignedShort, unsigned_int16)
-                    _c(Int, int32)
-                    _c(UnsignedInt, unsigned_int32)
-                    #ifndef MAGNUM_TARGET_WEBGL
-                    _c(Long, int64)
-                    _c(UnsignedLong, unsigned_int64)
-                    #endif
-                    /** @todo Half */
-                    _c(Float, float)
-                    _c(Double, double)
-                    _c(String, string)
-                    _c(Reference, ref)
-                    _c(Type, type)
-                    #undef _c
-                    case Type::Custom:
-                        CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
-                }
-
-                e << "literal";
+        _properties.push_back(property);
+    }
 
-                break;
-            }
+    /* Zero name, first child and next mean there's none */
+    _structures.reserve(_structures.size() + other._structures.size());
+    for(StructureData structure: other._structures) {
+        if(structure.name) structure.name += stringOffset;
+        if(structure.parent != NoParent) structure.parent += structureOffset;
+        if(structure.next) structure.next += structureOffset;
 
-            case Implementation::ParseErrorType::NoError:
-                CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        if(structure.primitive.type < Type::Custom)
+            structure.primitive.begin += structure.primitive.lazy ? lazyDataOffset : dataOffsets[UnsignedInt(structure.primitive.type)];
+        else {
+            structure.custom.propertiesBegin += propertyOffset;
+            if(structure.custom.firstChild) structure.custom.firstChild += structureOffset;
         }
 
-        e << "on line" << line;
+        _structures.push_back(structure);
+    }
+
+    /* Return the last top-level structure */
+    std::size_t last = structureOffset;
+    while(_structures[last].next) last = _structures[last].next;
+    return last;
+}
+
+bool Document::parse(Containers::ArrayView<const char> data, const std::initializer_list<CharacterLiteral> structureIdentifiers, const std::initializer_list<CharacterLiteral> propertyIdentifiers, UnsignedInt threadCount) {
+    _structureIdentifiers = {structureIdentifiers.begin(), structureIdentifiers.size()};
+    _propertyIdentifiers = {propertyIdentifiers.begin(), propertyIdentifiers.size()};
+    identifierTable(_structureIdentifiers, _structureIdentifierTable);
+    identifierTable(_propertyIdentifiers, _propertyIdentifierTable);
+    _lazySource = data;
+
+    Implementation::ParseError error;
+    std::string buffer;
 
+    const char* i = Implementation::whitespace(data);
+    std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>> references;
+
+    /* Parse in parallel, if requested. If that fails, the document is left
+       untouched and the sequential parser below reports the error. */
+    bool parsed = false;
+    #ifndef CORRADE_TARGET_EMSCRIPTEN
+    if(!threadCount) threadCount = std::thread::hardware_concurrency();
+    if(threadCount > 1) parsed = parseParallel(data.suffix(i), threadCount, references);
+    #else
+    static_cast<void>(threadCount);
+    #endif
+
+    /* Otherwise parse on a single thread. If requested, size the storage
+       upfront so it doesn't need to be reallocated during parsing. Not done
+       with lazy parsing, as the large lists would be scanned twice and
+       they're stored separately anyway. */
+    if(!parsed) {
+        if(_presizeStorage && !_lazyParsingThreshold)
+            reserveStorage(data.suffix(i), references);
+        i = parseStructureList(NoParent, data.suffix(i), references, buffer, error);
+    }
+
+    if(!i) {
+        printParseError("OpenDdl::Document::parse():", data, error);
         return false;
     }
 
-    /* Everything parsed, dereference references */
+    /* Everything parsed, index structure names so the references can be
+       resolved without going through all structures every time */
+    NameIndex names;
+    if(!references.empty()) {
+        std::size_t count = 0;
+        for(const StructureData& structure: _structures) if(structure.name) ++count;
+
+        /* At most half full, so the probe sequences stay short */
+        std::size_t size = 4;
+        while(size < count*2) size *= 2;
+        names.assign(size, {0, NullReference});
+
+        for(std::size_t i = 0; i != _structures.size(); ++i) if(_structures[i].name) {
+            const std::string& name = _strings[_structures[i].name];
+            const std::size_t hash = nameHash({name.data(), name.size()});
+            std::size_t j = hash & (size - 1);
+            while(names[j].second != NullReference) j = (j + 1) & (size - 1);
+            names[j] = {hash, i};
+        }
+    }
+
+    /* Dereference references */
+    _references.reserve(_references.size() + references.size());
     for(const std::pair<std::size_t, Containers::ArrayView<const char>> reference: references) {
         /* Null reference */
         if(reference.second.empty())
@@ -305,7 +721,7 @@ bool Document::parse(Containers::ArrayView<const char> data, const std::initiali
 
         /* Non-null, try to dereference */
         else {
-            std::size_t r = dereference(reference.first, reference.second);
+            std::size_t r = dereference(names, reference.first, reference.second);
             if(r == NullReference) {
                 Error() << "OpenDdl::Document::parse(): reference" << std::string{reference.second, reference.second.size()} << "was not found";
                 return false;
@@ -317,6 +733,409 @@ bool Document::parse(Containers::ArrayView<const char> data, const std::initiali
     return true;
 }
 
+namespace {
+
+/* The serialized document is a header followed by arrays in the order given
+   by SerializedArray, each padded to a multiple of eight bytes. Indices and
+   sizes are stored as 64-bit values, properties as three and structures as
+   seven of them. Everything is in native byte order, the header has enough
+   info to reject blobs from incompatible platforms. */
+enum class SerializedArray: UnsignedInt {
+    Bools, UnsignedBytes, Bytes, UnsignedShorts, Shorts, UnsignedInts, Ints,
+    UnsignedLongs, Longs, Halves, Floats, Doubles, Types, References, Properties,
+    Structures, StringSizes, StringData
+};
+
+enum: std::size_t {
+    SerializedArrayCount = std::size_t(SerializedArray::StringData) + 1
+};
+
+/* Size of one item in each array */
+constexpr std::size_t SerializedItemSizes[SerializedArrayCount]{1, 1, 1, 2, 2, 4, 4, 8, 8, 2, 4, 8, 4, 8, 3*8, 7*8, 8, 1};
+static_assert(sizeof(Type) == 4, "unexpected size of the type enum");
+static_assert(sizeof(Half) == 2, "unexpected size of the half type");
+
+struct SerializedHeader {
+    char signature[8];
+    UnsignedInt version;
+    UnsignedInt byteOrder;
+    UnsignedInt sizeTypeSize;
+    UnsignedInt typeCount;
+    std::uint64_t identifierHash;
+    std::uint64_t counts[SerializedArrayCount];
+};
+
+constexpr char SerializedSignature[]{'O', 'D', 'D', 'L', 'B', 'L', 'O', 'B'};
+
+enum: UnsignedInt {
+    SerializedVersion = 2,
+    SerializedByteOrder = 0x01020304
+};
+
+std::uint64_t identifierHash(const Containers::ArrayView<const CharacterLiteral> structureIdentifiers, const Containers::ArrayView<const CharacterLiteral> propertyIdentifiers) {
+    /* 64-bit FNV-1a, identifiers are delimited with zero bytes and the two
+       lists with an additional one */
+    std::uint64_t hash = 14695981039346656037ull;
+    auto add = [&hash](const char c) {
+        hash ^= UnsignedByte(c);
+        hash *= 1099511628211ull;
+    };
+    for(const Containers::ArrayView<const CharacterLiteral> identifiers: {structureIdentifiers, propertyIdentifiers}) {
+        for(const CharacterLiteral identifier: identifiers) {
+            for(const char c: identifier) add(c);
+            add('\0');
+        }
+        add('\0');
+    }
+    return hash;
+}
+
+inline std::size_t serializedArraySize(const std::size_t count, const std::size_t itemSize) {
+    return (count*itemSize + 7) & ~std::size_t{7};
+}
+
+inline void putSerialized(char*& out, const std::uint64_t value) {
+    std::memcpy(out, &value, 8);
+    out += 8;
+}
+
+inline std::size_t getSerialized(const char*& in) {
+    std::uint64_t value;
+    std::memcpy(&value, in, 8);
+    in += 8;
+    return std::size_t(value);
+}
+
+}
+
+Containers::Array<char> Document::serialize() const {
+    CORRADE_ASSERT(_lazyData.empty(),
+        "OpenDdl::Document::serialize(): can't serialize a lazily parsed document", {});
+
+    SerializedHeader header{};
+    std::memcpy(header.signature, SerializedSignature, sizeof(SerializedSignature));
+    header.version = SerializedVersion;
+    header.byteOrder = SerializedByteOrder;
+    header.sizeTypeSize = sizeof(std::size_t);
+    header.typeCount = UnsignedInt(Type::Custom);
+    header.identifierHash = identifierHash(_structureIdentifiers, _propertyIdentifiers);
+
+    #define _c(array, member) \
+        header.counts[UnsignedInt(SerializedArray::array)] = member.size();
+    _c(Bools, _bools)
+    _c(UnsignedBytes, _unsignedBytes)
+    _c(Bytes, _bytes)
+    _c(UnsignedShorts, _unsignedShorts)
+    _c(Shorts, _shorts)
+    _c(UnsignedInts, _unsignedInts)
+    _c(Ints, _ints)
+    #ifndef MAGNUM_TARGET_WEBGL
+    _c(UnsignedLongs, _unsignedLongs)
+    _c(Longs, _longs)
+    #endif
+    _c(Halves, _halves)
+    _c(Floats, _floats)
+    _c(Doubles, _doubles)
+    _c(Types, _types)
+    _c(References, _references)
+    _c(Properties, _properties)
+    _c(Structures, _structures)
+    _c(StringSizes, _strings)
+    #undef _c
+    for(const std::string& string: _strings)
+        header.counts[UnsignedInt(SerializedArray::StringData)] += string.size();
+
+    std::size_t size = sizeof(SerializedHeader);
+    for(std::size_t i = 0; i != SerializedArrayCount; ++i)
+        size += serializedArraySize(header.counts[i], SerializedItemSizes[i]);
+
+    Containers::Array<char> out{Containers::ValueInit, size};
+    std::memcpy(out, &header, sizeof(SerializedHeader));
+    char* o = out + sizeof(SerializedHeader);
+    auto pad = [&out, &o]() {
+        o = out + ((o - out + 7) & ~std::size_t{7});
+    };
+
+    for(const bool value: _bools) *o++ = value;
+    pad();
+
+    #define _c(member) \
+        if(!member.empty()) std::memcpy(o, member.data(), member.size()*sizeof(member[0])); \
+        o += member.size()*sizeof(member[0]);                               \
+        pad();
+    _c(_unsignedBytes)
+    _c(_bytes)
+    _c(_unsignedShorts)
+    _c(_shorts)
+    _c(_unsignedInts)
+    _c(_ints)
+    #ifndef MAGNUM_TARGET_WEBGL
+    _c(_unsignedLongs)
+    _c(_longs)
+    #endif
+    _c(_halves)
+    _c(_floats)
+    _c(_doubles)
+    _c(_types)
+    #undef _c
+
+    for(const std::size_t reference: _references) putSerialized(o, reference);
+
+    for(const PropertyData& property: _properties) {
+        putSerialized(o, UnsignedInt(property.identifier));
+        putSerialized(o, UnsignedByte(property.type));
+        putSerialized(o, property.position);
+    }
+
+    for(const StructureData& structure: _structures) {
+        putSerialized(o, structure.name);
+        if(structure.primitive.type < Type::Custom) {
+            putSerialized(o, UnsignedInt(structure.primitive.type));
+            putSerialized(o, structure.primitive.subArraySize);
+            putSerialized(o, structure.primitive.begin);
+            putSerialized(o, structure.primitive.size);
+        } else {
+            putSerialized(o, UnsignedInt(structure.custom.identifier));
+            putSerialized(o, structure.custom.propertiesBegin);
+            putSerialized(o, structure.custom.propertiesSize);
+            putSerialized(o, structure.custom.firstChild);
+        }
+        putSerialized(o, structure.parent);
+        putSerialized(o, structure.next);
+    }
+
+    for(const std::string& string: _strings) putSerialized(o, string.size());
+    for(const std::string& string: _strings) {
+        std::memcpy(o, string.data(), string.size());
+        o += string.size();
+    }
+    pad();
+
+    CORRADE_INTERNAL_ASSERT(o == out.end());
+    return out;
+}
+
+bool Document::deserialize(const Containers::ArrayView<const char> data, const std::initializer_list<CharacterLiteral> structureIdentifiers, const std::initializer_list<CharacterLiteral> propertyIdentifiers) {
+    CORRADE_ASSERT(_structures.empty() && _strings.size() == 1,
+        "OpenDdl::Document::deserialize(): the document is not empty", false);
+
+    _structureIdentifiers = {structureIdentifiers.begin(), structureIdentifiers.size()};
+    _propertyIdentifiers = {propertyIdentifiers.begin(), propertyIdentifiers.size()};
+    identifierTable(_structureIdentifiers, _structureIdentifierTable);
+    identifierTable(_propertyIdentifiers, _propertyIdentifierTable);
+
+    if(data.size() < sizeof(SerializedHeader)) {
+        Error() << "OpenDdl::Document::deserialize(): expected at least" << sizeof(SerializedHeader) << "bytes, got" << data.size();
+        return false;
+    }
+
+    SerializedHeader header;
+    std::memcpy(&header, data, sizeof(SerializedHeader));
+    if(std::memcmp(header.signature, SerializedSignature, sizeof(SerializedSignature)) != 0) {
+        Error() << "OpenDdl::Document::deserialize(): invalid signature";
+        return false;
+    }
+    if(header.version != SerializedVersion) {
+        Error() << "OpenDdl::Document::deserialize(): unsupported version" << header.version;
+        return false;
+    }
+    if(header.byteOrder != SerializedByteOrder || header.sizeTypeSize != sizeof(std::size_t) || header.typeCount != UnsignedInt(Type::Custom)) {
+        Error() << "OpenDdl::Document::deserialize(): the data were created on an incompatible platform";
+        return false;
+    }
+    if(header.identifierHash != identifierHash(_structureIdentifiers, _propertyIdentifiers)) {
+        Error() << "OpenDdl::Document::deserialize(): the data were created with different identifier lists";
+        return false;
+    }
+
+    /* Each item takes at least one byte, so checking the count against data
+       size first avoids overflow in the size calculation */
+    std::size_t size = sizeof(SerializedHeader);
+    for(std::size_t i = 0; i != SerializedArrayCount && size <= data.size(); ++i) {
+        if(header.counts[i] > data.size()) size = ~std::size_t{};
+        else size += serializedArraySize(header.counts[i], SerializedItemSizes[i]);
+    }
+    if(size != data.size()) {
+        Error() << "OpenDdl::Document::deserialize(): size mismatch, got" << data.size() << "bytes";
+        return false;
+    }
+
+    auto count = [&header](const SerializedArray array) {
+        return std::size_t(header.counts[UnsignedInt(array)]);
+    };
+    const std::size_t referenceCount = count(SerializedArray::References);
+    const std::size_t propertyCount = count(SerializedArray::Properties);
+    const std::size_t structureCount = count(SerializedArray::Structures);
+    const std::size_t stringCount = count(SerializedArray::StringSizes);
+
+    const char* i = data + sizeof(SerializedHeader);
+    auto pad = [&data, &i]() {
+        i = data + ((i - data + 7) & ~std::size_t{7});
+    };
+
+    _bools.resize(count(SerializedArray::Bools));
+    for(std::size_t j = 0; j != _bools.size(); ++j) _bools[j] = *i++;
+    pad();
+
+    #define _c(array, member) \
+        member.resize(count(SerializedArray::array));                       \
+        if(!member.empty()) std::memcpy(&member[0], i, member.size()*sizeof(member[0])); \
+        i += member.size()*sizeof(member[0]);                               \
+        pad();
+    _c(UnsignedBytes, _unsignedBytes)
+    _c(Bytes, _bytes)
+    _c(UnsignedShorts, _unsignedShorts)
+    _c(Shorts, _shorts)
+    _c(UnsignedInts, _unsignedInts)
+    _c(Ints, _ints)
+    #ifndef MAGNUM_TARGET_WEBGL
+    _c(UnsignedLongs, _unsignedLongs)
+    _c(Longs, _longs)
+    #else
+    /* The type count check above would fail if there were any */
+    CORRADE_INTERNAL_ASSERT(!count(SerializedArray::UnsignedLongs) && !count(SerializedArray::Longs));
+    #endif
+    _c(Halves, _halves)
+    _c(Floats, _floats)
+    _c(Doubles, _doubles)
+    _c(Types, _types)
+    #undef _c
+
+    for(const Type type: _types) if(type >= Type::Custom) {
+        Error() << "OpenDdl::Document::deserialize(): invalid type data";
+        return false;
+    }
+
+    _references.resize(referenceCount);
+    for(std::size_t& reference: _references) {
+        reference = getSerialized(i);
+        if(reference != NullReference && reference >= structureCount) {
+            Error() << "OpenDdl::Document::deserialize(): invalid reference data";
+            return false;
+        }
+    }
+
+    _properties.reserve(propertyCount);
+    for(std::size_t j = 0; j != propertyCount; ++j) {
+        const std::size_t identifier = getSerialized(i);
+        const std::size_t type = getSerialized(i);
+        const std::size_t position = getSerialized(i);
+
+        std::size_t positionCount;
+        switch(Implementation::InternalPropertyType(type)) {
+            case Implementation::InternalPropertyType::Bool:
+                positionCount = _bools.size();
+                break;
+            case Implementation::InternalPropertyType::Binary:
+            case Implementation::InternalPropertyType::Character:
+            case Implementation::InternalPropertyType::Integral:
+                positionCount = _ints.size();
+                break;
+            case Implementation::InternalPropertyType::Float:
+                positionCount = _floats.size();
+                break;
+            case Implementation::InternalPropertyType::String:
+                positionCount = stringCount;
+                break;
+            case Implementation::InternalPropertyType::Reference:
+                positionCount = referenceCount;
+                break;
+            case Implementation::InternalPropertyType::Type:
+                positionCount = _types.size();
+                break;
+            default:
+                positionCount = 0;
+        }
+
+        if(type > 0xff || position >= positionCount || (identifier >= _propertyIdentifiers.size() && identifier != std::size_t(UnknownIdentifier))) {
+            Error() << "OpenDdl::Document::deserialize(): invalid property data";
+            return false;
+        }
+
+        _properties.emplace_back(Int(identifier), Implementation::InternalPropertyType(type), position);
+    }
+
+    /* Zero name, first child and next mean there's none. Parents are always
+       before and children and siblings after given structure, which also
+       ensures there are no cycles. */
+    _structures.reserve(structureCount);
+    for(std::size_t j = 0; j != structureCount; ++j) {
+        const std::size_t name = getSerialized(i);
+        const std::size_t kind = getSerialized(i);
+        const std::size_t a = getSerialized(i);
+        const std::size_t b = getSerialized(i);
+        const std::size_t c = getSerialized(i);
+        const std::size_t parent = getSerialized(i);
+        const std::size_t next = getSerialized(i);
+
+        bool valid = name < stringCount && (parent == NoParent || parent < j) && (!next || (next > j && next < structureCount));
+
+        /* Primitive structure, check that the data range is in bounds */
+        if(kind < std::size_t(Type::Custom)) {
+            std::size_t dataCount{};
+            switch(Type(kind)) {
+                #define _c(type) \
+                    case Type::type: dataCount = dataPosition<Type::type>(); break;
+                _c(Bool)
+                _c(UnsignedByte)
+                _c(Byte)
+                _c(UnsignedShort)
+                _c(Short)
+                _c(UnsignedInt)
+                _c(Int)
+                #ifndef MAGNUM_TARGET_WEBGL
+                _c(UnsignedLong)
+                _c(Long)
+                #endif
+                _c(Half)
+                _c(Float)
+                _c(Double)
+                _c(Type)
+                #undef _c
+                case Type::String: dataCount = stringCount; break;
+                case Type::Reference: dataCount = referenceCount; break;
+                case Type::Custom: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+            }
+
+            if(valid && b <= dataCount && c <= dataCount - b) {
+                _structures.emplace_back(Type(kind), name, a, b, c, parent, next);
+                continue;
+            }
+
+        /* Custom structure, check the identifier, properties and children */
+        } else {
+            const std::size_t identifier = kind - std::size_t(Type::Custom);
+            if(valid && (identifier < _structureIdentifiers.size() || identifier == std::size_t(UnknownIdentifier)) && a <= propertyCount && b <= propertyCount - a && (!c || (c > j && c < structureCount))) {
+                _structures.emplace_back(Int(identifier), name, a, b, c, parent, next);
+                continue;
+            }
+        }
+
+        Error() << "OpenDdl::Document::deserialize(): invalid structure data";
+        return false;
+    }
+
+    /* The first string is reserved for empty names and is already there */
+    const char* stringData = i + stringCount*8;
+    std::size_t stringDataSize = 0;
+    for(std::size_t j = 0; j != stringCount; ++j) {
+        const std::size_t stringSize = getSerialized(i);
+        if((!j && stringSize) || stringSize > count(SerializedArray::StringData) - stringDataSize) {
+            Error() << "OpenDdl::Document::deserialize(): invalid string data";
+            return false;
+        }
+
+        if(j) _strings.emplace_back(stringData + stringDataSize, stringSize);
+        stringDataSize += stringSize;
+    }
+    if(!stringCount || stringDataSize != count(SerializedArray::StringData)) {
+        Error() << "OpenDdl::Document::deserialize(): invalid string data";
+        return false;
+    }
+
+    return true;
+}
+
 const char* Document::parseProperty(const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, const Int identifier, Implementation::ParseError& error) {
     bool boolValue;
     Int integerValue;
@@ -349,7 +1168,7 @@ const char* Document::parseProperty(const Containers::ArrayView<const char> data
             break;
         case Implementation::InternalPropertyType::String:
             position = _strings.size();
-            _strings.push_back(stringValue);
+            _strings.push_back(std::move(stringValue));
             break;
         case Implementation::InternalPropertyType::Reference:
             position = references.size();
@@ -369,23 +1188,27 @@ const char* Document::parseProperty(const Containers::ArrayView<const char> data
 
 namespace Implementation {
 
+/* Tokenizers for a single data list item, shared between Document and
+   Reader. Each returns pointer after the literal (or nullptr on error) and
+   the value. */
+template<Type> struct ExtractDataListItem;
+
 template<> struct ExtractDataListItem<Type::Bool> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string&, Implementation::ParseError& error) {
-        const char* i;
-        bool value;
-        std::tie(i, value) = Implementation::boolLiteral(data, error);
-        document.data<bool>().push_back(value);
-        return i;
+    typedef bool ValueType;
+
+    static std::pair<const char*, bool> extract(const Containers::ArrayView<const char> data, std::string&, Implementation::ParseError& error) {
+        return Implementation::boolLiteral(data, error);
     }
 };
 
 template<class T> struct ExtractIntegralDataListItem {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string& buffer, Implementation::ParseError& error) {
+    typedef T ValueType;
+
+    static std::pair<const char*, T> extract(const Containers::ArrayView<const char> data, std::string&, Implementation::ParseError& error) {
         const char* i;
         T value;
-        std::tie(i, value, std::ignore) = Implementation::integralLiteral<T>(data, buffer, error);
-        document.data<T>().push_back(value);
-        return i;
+        std::tie(i, value, std::ignore) = Implementation::integralLiteral<T>(data, error);
+        return {i, value};
     }
 };
 #define _c(T) \
@@ -403,58 +1226,64 @@ _c(Long)
 #undef _c
 
 template<class T> struct ExtractFloatingPointDataListItem {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string& buffer, Implementation::ParseError& error) {
-        const char* i;
-        T value;
-        std::tie(i, value) = Implementation::floatingPointLiteral<T>(data, buffer, error);
-        document.data<T>().push_back(value);
-        return i;
+    typedef T ValueType;
+
+    static std::pair<const char*, T> extract(const Containers::ArrayView<const char> data, std::string& buffer, Implementation::ParseError& error) {
+        return Implementation::floatingPointLiteral<T>(data, buffer, error);
     }
 };
 #define _c(T) \
     template<> struct ExtractDataListItem<Type::T>: ExtractFloatingPointDataListItem<T> {};
-/** @todo Half */
+_c(Half)
 _c(Float)
 _c(Double)
 #undef _c
 
 template<> struct ExtractDataListItem<Type::String> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string&, Implementation::ParseError& error) {
-        const char* i;
-        std::string value;
-        std::tie(i, value) = Implementation::stringLiteral(data, error);
-        document.data<std::string>().push_back(std::move(value));
-        return i;
+    typedef std::string ValueType;
+
+    static std::pair<const char*, std::string> extract(const Containers::ArrayView<const char> data, std::string&, Implementation::ParseError& error) {
+        return Implementation::stringLiteral(data, error);
     }
 };
 
 template<> struct ExtractDataListItem<Type::Reference> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string&, Implementation::ParseError& error) {
-        const char* i;
-        Containers::ArrayView<const char> value;
-        std::tie(i, value) = Implementation::referenceLiteral(data, error);
-        /* Containing structure will be put into the vector after its data are
-           parsed */
-        references.emplace_back(document._structures.size(), value);
-        return i;
+    typedef Containers::ArrayView<const char> ValueType;
+
+    static std::pair<const char*, Containers::ArrayView<const char>> extract(const Containers::ArrayView<const char> data, std::string&, Implementation::ParseError& error) {
+        return Implementation::referenceLiteral(data, error);
     }
 };
 
 template<> struct ExtractDataListItem<Type::Type> {
-    static const char* extract(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>&, std::string&, Implementation::ParseError& error) {
-        const char* i;
-        Type value;
-        std::tie(i, value) = Implementation::typeLiteral(data, error);
-        document.data<Type>().push_back(value);
-        return i;
+    typedef OpenDdl::Type ValueType;
+
+    static std::pair<const char*, OpenDdl::Type> extract(const Containers::ArrayView<const char> data, std::string&, Implementation::ParseError& error) {
+        return Implementation::typeLiteral(data, error);
     }
 };
 
+/* Puts parsed data list items into a document */
+struct DocumentDataOutput {
+    template<class T> void operator()(T value) {
+        document.data<T>().push_back(std::move(value));
+    }
+
+    void operator()(const Containers::ArrayView<const char> value) {
+        /* Containing structure will be put into the vector after its data are
+           parsed */
+        references.emplace_back(document._structures.size(), value);
+    }
+
+    Document& document;
+    std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references;
+};
+
 }
 
 namespace {
 
-template<Type type> std::pair<const char*, std::size_t> dataList(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Implementation::ParseError& error) {
+template<Type type, class Output> std::pair<const char*, std::size_t> dataList(const Containers::ArrayView<const char> data, Output& output, std::string& buffer, Implementation::ParseError& error) {
     const char* i = data;
     std::size_t j = 0;
     for(; i && i != data.end() && *i != '}'; ) {
@@ -467,9 +1296,10 @@ template<Type type> std::pair<const char*, std::size_t> dataList(const Container
             i = Implementation::whitespace(data.suffix(i + 1));
         }
 
-        i = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), document, references, buffer, error);
+        std::pair<const char*, typename Implementation::ExtractDataListItem<type>::ValueType> item = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), buffer, error);
+        output(std::move(item.second));
 
-        i = Implementation::whitespace(data.suffix(i));
+        i = Implementation::whitespace(data.suffix(item.first));
 
         ++j;
     }
@@ -477,8 +1307,8 @@ template<Type type> std::pair<const char*, std::size_t> dataList(const Container
     return {i, j};
 }
 
-template<Type type> std::pair<const char*, std::size_t> dataArrayList(const Containers::ArrayView<const char> data, Document& document, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, const std::size_t subArraySize, Implementation::ParseError& error) {
-    if(!subArraySize) return dataList<type>(data, document, references, buffer, error);
+template<Type type, class Output> std::pair<const char*, std::size_t> dataArrayList(const Containers::ArrayView<const char> data, Output& output, std::string& buffer, const std::size_t subArraySize, Implementation::ParseError& error) {
+    if(!subArraySize) return dataList<type>(data, output, buffer, error);
 
     const char* i = data;
     std::size_t j = 0;
@@ -509,9 +1339,10 @@ template<Type type> std::pair<const char*, std::size_t> dataArrayList(const Cont
                 i = Implementation::whitespace(data.suffix(i + 1));
             }
 
-            i = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), document, references, buffer, error);
+            std::pair<const char*, typename Implementation::ExtractDataListItem<type>::ValueType> item = Implementation::ExtractDataListItem<type>::extract(data.suffix(i), buffer, error);
+            output(std::move(item.second));
 
-            i = Implementation::whitespace(data.suffix(i));
+            i = Implementation::whitespace(data.suffix(item.first));
         }
 
         if(!i) return {};
@@ -529,16 +1360,6 @@ template<Type type> std::pair<const char*, std::size_t> dataArrayList(const Cont
     return {i, j*subArraySize};
 }
 
-Int identifierId(const Containers::ArrayView<const char> data, Containers::ArrayView<const CharacterLiteral> identifiers) {
-    Int i = 0;
-    for(const Containers::ArrayView<const char> identifier: identifiers) {
-        if(Implementation::equals(data, identifier)) return i;
-        ++i;
-    }
-
-    return UnknownIdentifier;
-}
-
 }
 
 std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t parent, const Containers::ArrayView<const char> data, std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>>& references, std::string& buffer, Implementation::ParseError& error) {
@@ -560,7 +1381,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
         if(i != data.end() && *i == '[') {
             i = Implementation::whitespace(data.suffix(i + 1));
 
-            std::tie(i, subArraySize, std::ignore) = Implementation::integralLiteral<std::size_t>(data.suffix(i), buffer, error);
+            std::tie(i, subArraySize, std::ignore) = Implementation::integralLiteral<std::size_t>(data.suffix(i), error);
 
             if(subArraySize == 0) {
                 error = {Implementation::ParseErrorType::InvalidSubArraySize, i};
@@ -601,12 +1422,26 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
 
         i = Implementation::whitespace(data.suffix(i + 1));
 
+        /* If the list is large enough, only calculate its size and parse it
+           on first access. Not done for types that aren't stored as-is or
+           need to be resolved after parsing. If the list end can't be found,
+           the regular parsing below reports the error. */
+        if(_lazyParsingThreshold && std::size_t(data.end() - i) >= _lazyParsingThreshold && type != Type::Bool && type != Type::String && type != Type::Reference && type != Type::Type) {
+            const std::pair<const char*, std::size_t> listSize = Implementation::dataListSize(data.suffix(i), subArraySize);
+            if(listSize.first && std::size_t(listSize.first - i) >= _lazyParsingThreshold) {
+                _lazyData.push_back(LazyData{_lazySource, data.slice(i, listSize.first + 1), nullptr, false, false});
+                _structures.emplace_back(type, name, subArraySize, _lazyData.size() - 1, listSize.second, parent, _structures.size() + 1, true);
+                return {listSize.first + 1, _structures.size() - 1};
+            }
+        }
+
         std::size_t dataBegin = 0, dataSize = 0;
+        Implementation::DocumentDataOutput output{*this, references};
         switch(type) {
             #define _c(type) \
             case Type::type: \
                 dataBegin = dataPosition<Type::type>(); \
-                std::tie(i, dataSize) = dataArrayList<Type::type>(data.suffix(i), *this, references, buffer, subArraySize, error); break;
+                std::tie(i, dataSize) = dataArrayList<Type::type>(data.suffix(i), output, buffer, subArraySize, error); break;
             _c(Bool)
             _c(UnsignedByte)
             _c(Byte)
@@ -618,7 +1453,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
             _c(UnsignedLong)
             _c(Long)
             #endif
-            /** @todo Half */
+            _c(Half)
             _c(Float)
             _c(Double)
             _c(String)
@@ -626,7 +1461,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
             #undef _c
             case Type::Reference:
                 dataBegin = references.size();
-                std::tie(i, dataSize) = dataArrayList<Type::Reference>(data.suffix(i), *this, references, buffer, subArraySize, error);
+                std::tie(i, dataSize) = dataArrayList<Type::Reference>(data.suffix(i), output, buffer, subArraySize, error);
                 break;
             case Type::Custom:
                 CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
@@ -647,7 +1482,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
 
     /* Custom structure */
     } else {
-        const Int structureIdentifierId = identifierId(data.prefix(structureIdentifier), _structureIdentifiers);
+        const Int structureIdentifierId = identifierId(data.prefix(structureIdentifier), _structureIdentifiers, _structureIdentifierTable);
 
         i = Implementation::whitespace(data.suffix(structureIdentifier));
 
@@ -682,7 +1517,7 @@ std::pair<const char*, std::size_t> Document::parseStructure(const std::size_t p
                 const char* const propertyIdentifier = Implementation::identifier(data.suffix(i), error);
                 if(!propertyIdentifier) return {};
 
-                const Int propertyIdentifierId = identifierId(data.slice(i, propertyIdentifier), _propertyIdentifiers);
+                const Int propertyIdentifierId = identifierId(data.slice(i, propertyIdentifier), _propertyIdentifiers, _propertyIdentifierTable);
 
                 /* Propagate errors */
                 if(!i) return {};
@@ -769,140 +1604,314 @@ const char* Document::parseStructureList(const std::size_t parent, const Contain
     return i;
 }
 
-bool Document::validate(const Validation::Structures allowedRootStructures, const std::initializer_list<Validation::Structure> structures) const {
-    std::vector<Int> countsBuffer;
-    countsBuffer.reserve(structures.size());
+bool Document::parseLazyData(const StructureData& structure) const {
+    LazyData& lazy = _lazyData[structure.primitive.begin];
+    if(lazy.loaded) return lazy.parsed;
 
-    /* Check that there are no primitive structures in root */
-    for(const Structure s: children()) if(!s.isCustom()) {
-        Error() << "OpenDdl::Document::validate(): unexpected primitive structure in root";
-        return false;
+    /* Parse the list into a temporary document the same way as in
+       parseStructure() and take the data out of it */
+    Document document;
+    std::vector<std::pair<std::size_t, Containers::ArrayView<const char>>> references;
+    std::string buffer;
+    Implementation::DocumentDataOutput output{document, references};
+    Implementation::ParseError error;
+    const char* i{};
+    std::size_t size{};
+    Containers::ArrayView<const char> data;
+    std::size_t typeSize{};
+    switch(structure.primitive.type) {
+        #define _c(type, T) \
+            case Type::type: \
+                document.data<T>().reserve(structure.primitive.size); \
+                std::tie(i, size) = dataArrayList<Type::type>(lazy.list, output, buffer, structure.primitive.subArraySize, error); \
+                data = {reinterpret_cast<const char*>(document.data<T>().data()), document.data<T>().size()*sizeof(T)}; \
+                typeSize = sizeof(T);                                   \
+                break;
+        _c(UnsignedByte, UnsignedByte)
+        _c(Byte, Byte)
+        _c(UnsignedShort, UnsignedShort)
+        _c(Short, Short)
+        _c(UnsignedInt, UnsignedInt)
+        _c(Int, Int)
+        #ifndef MAGNUM_TARGET_WEBGL
+        _c(UnsignedLong, UnsignedLong)
+        _c(Long, Long)
+        #endif
+        _c(Half, Half)
+        _c(Float, Float)
+        _c(Double, Double)
+        #undef _c
+        default: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
     }
 
-    /* Check custom structures */
-    return validateLevel(findFirstChild(), {allowedRootStructures.begin(), allowedRootStructures.size()}, {structures.begin(), structures.size()}, countsBuffer);
+    /* On failure fill the data with zeros so the views returned from
+       Structure::asArray() are still valid. The list end was found before,
+       so the size can differ only if there's an error, but better be
+       sure. */
+    lazy.data = Containers::Array<char>{Containers::ValueInit, structure.primitive.size*typeSize};
+    lazy.loaded = true;
+    if(!i) printParseError("OpenDdl::Structure::parseData():", lazy.source, error);
+    else if(size != structure.primitive.size) {
+        Error() << "OpenDdl::Structure::parseData(): expected" << structure.primitive.size << "values but got" << size;
+    } else {
+        std::copy(data.begin(), data.end(), lazy.data.begin());
+        lazy.parsed = true;
+    }
+
+    return lazy.parsed;
 }
 
-bool Document::validateLevel(const Containers::Optional<Structure>& first, const Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowedStructures, const Containers::ArrayView<const Validation::Structure> structures, std::vector<Int>& counts) const {
-    counts.assign(allowedStructures.size(), 0);
+const char* Document::lazyData(const StructureData& structure) const {
+    parseLazyData(structure);
+    return _lazyData[structure.primitive.begin].data;
+}
 
-    /* Count number of custom structures in this level */
-    for(Containers::Optional<Structure> it = first; it; it = it->findNext()) {
-        const Structure s = *it;
+namespace {
 
-        if(!s.isCustom() || s.identifier() == UnknownIdentifier) continue;
+/* Validation specification compiled into dense tables indexed by
+   identifier ID, so checking a structure or property is a single lookup
+   instead of a linear search through the specification. The allowed root
+   structures are treated as an additional specification at the end. */
+struct ValidationTables {
+    explicit ValidationTables(Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowedRootStructures, Containers::ArrayView<const Validation::Structure> structures, std::size_t structureIdentifierCount, std::size_t propertyIdentifierCount);
 
-        /* Verify that the structure is allowed (ignoring unknown ones) */
-        auto found = std::find_if(allowedStructures.begin(), allowedStructures.end(), [s](const std::pair<Int, std::pair<Int, Int>>& v){ return v.first == s.identifier(); });
-        if(found == allowedStructures.end()) {
-            Error() << "OpenDdl::Document::validate(): unexpected structure" << structureName(s.identifier());
-            return false;
+    Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowedStructures(std::size_t specification) const {
+        return specification == root ? allowedRootStructures : structures[specification].structures();
+    }
+
+    Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowedRootStructures;
+    Containers::ArrayView<const Validation::Structure> structures;
+    std::size_t root, structureIdentifierCount, propertyIdentifierCount;
+
+    /* Specification index for each structure identifier, -1 if there's none */
+    std::vector<Int> specifications;
+    /* Index into allowed sub-structures for each specification and
+       identifier, -1 if not allowed */
+    std::vector<Int> structureSlots;
+    /* Index into allowed properties for each specification and identifier,
+       -1 if not allowed */
+    std::vector<Int> propertySlots;
+    /* Bitmask of allowed primitive types for each specification */
+    std::vector<UnsignedInt> primitiveTypes;
+};
+
+static_assert(UnsignedInt(Type::Custom) <= 32, "primitive types don't fit into the bitmask");
+
+/* The tables are wide enough for both the identifiers used in the document
+   and in the specification */
+std::size_t structureIdentifierCountFor(const Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowedRootStructures, const Containers::ArrayView<const Validation::Structure> structures, std::size_t count) {
+    for(const std::pair<Int, std::pair<Int, Int>>& allowed: allowedRootStructures)
+        count = std::max(count, std::size_t(allowed.first) + 1);
+    for(const Validation::Structure& structure: structures) {
+        count = std::max(count, std::size_t(structure.identifier()) + 1);
+        for(const std::pair<Int, std::pair<Int, Int>>& allowed: structure.structures())
+            count = std::max(count, std::size_t(allowed.first) + 1);
+    }
+    return count;
+}
+
+std::size_t propertyIdentifierCountFor(const Containers::ArrayView<const Validation::Structure> structures, std::size_t count) {
+    for(const Validation::Structure& structure: structures)
+        for(const Validation::Property& property: structure.properties())
+            count = std::max(count, std::size_t(property.identifier()) + 1);
+    return count;
+}
+
+ValidationTables::ValidationTables(const Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowedRootStructures, const Containers::ArrayView<const Validation::Structure> structures, const std::size_t structureIdentifierCount, const std::size_t propertyIdentifierCount): allowedRootStructures{allowedRootStructures}, structures{structures}, root{structures.size()}, structureIdentifierCount{structureIdentifierCountFor(allowedRootStructures, structures, structureIdentifierCount)}, propertyIdentifierCount{propertyIdentifierCountFor(structures, propertyIdentifierCount)}, specifications(this->structureIdentifierCount, -1), structureSlots((structures.size() + 1)*this->structureIdentifierCount, -1), propertySlots(structures.size()*this->propertyIdentifierCount, -1), primitiveTypes(structures.size(), 0) {
+    /* If there are duplicates, the first one wins, same as with a linear
+       search */
+    for(std::size_t i = 0; i != structures.size() + 1; ++i) {
+        const Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowed = allowedStructures(i);
+        for(std::size_t j = 0; j != allowed.size(); ++j) {
+            CORRADE_INTERNAL_ASSERT(allowed[j].second.first >= 0 && (allowed[j].second.second == 0 || allowed[j].second.second >= allowed[j].second.first));
+            Int& slot = structureSlots[i*this->structureIdentifierCount + allowed[j].first];
+            if(slot == -1) slot = j;
         }
+    }
 
-        /* Verify that we don't exceed allowed count */
-        const std::size_t i = found - allowedStructures.begin();
-        if(++counts[i] > found->second.second && found->second.second) {
-            Error() << "OpenDdl::Document::validate(): too many" << structureName(s.identifier()) << "structures, got" << counts[i] << "but expected max" << found->second.second;
-            return false;
+    for(std::size_t i = 0; i != structures.size(); ++i) {
+        const Validation::Structure& structure = structures[i];
+        if(specifications[structure.identifier()] == -1)
+            specifications[structure.identifier()] = i;
+
+        for(std::size_t j = 0; j != structure.properties().size(); ++j) {
+            Int& slot = propertySlots[i*this->propertyIdentifierCount + structure.properties()[j].identifier()];
+            if(slot == -1) slot = j;
         }
+
+        for(const Type type: structure.primitives())
+            primitiveTypes[i] |= 1u << UnsignedInt(type);
     }
+}
 
-    /* Verify that all required structures are there */
-    {
-        std::size_t i = 0;
-        for(const std::pair<Int, std::pair<Int, Int>> allowedStructure: allowedStructures) {
-            CORRADE_INTERNAL_ASSERT(allowedStructure.second.first >= 0 && (allowedStructure.second.second == 0 || allowedStructure.second.second >= allowedStructure.second.first));
+}
+
+bool Document::validate(const Validation::Structures allowedRootStructures, const std::initializer_list<Validation::Structure> structures) const {
+    /* Check that there are no primitive structures in root */
+    for(const Structure s: children()) if(!s.isCustom()) {
+        Error() << "OpenDdl::Document::validate(): unexpected primitive structure in root";
+        return false;
+    }
+
+    const ValidationTables tables{{allowedRootStructures.begin(), allowedRootStructures.size()}, {structures.begin(), structures.size()}, _structureIdentifiers.size(), _propertyIdentifiers.size()};
+
+    /* The structures are stored in depth-first order with parents always
+       before their children, so a single linear sweep is enough. For each
+       validated custom structure there's its specification index (or -1 if
+       it and its children are not validated) and an offset into the count
+       array. Each count block has the primitive sub-structure count first,
+       followed by counts of each allowed custom sub-structure. The root is
+       the first block. */
+    std::vector<std::pair<Int, std::size_t>> state(_structures.size(), {-1, 0});
+    std::vector<Int> counts(1 + allowedRootStructures.size(), 0);
+    std::vector<Int> propertyCounts;
+    Int missingSpecification = UnknownIdentifier;
+
+    for(std::size_t i = 0; i != _structures.size(); ++i) {
+        const StructureData& data = _structures[i];
+
+        /* Skip children of structures that are not validated */
+        std::size_t parentSpecification = tables.root;
+        std::size_t parentCounts = 0;
+        if(data.parent != NoParent) {
+            if(state[data.parent].first == -1) continue;
+            parentSpecification = state[data.parent].first;
+            parentCounts = state[data.parent].second;
+        }
 
-            if(allowedStructure.second.first > counts[i]) {
-                Error() << "OpenDdl::Document::validate(): too little" << structureName(allowedStructure.first) << "structures, got" << counts[i] << "but expected min" << allowedStructure.second.first;
+        const Structure structure{*this, data};
+
+        /* Primitive structure, check that it's allowed in the parent with
+           given type and size. Primitive structures in root were checked
+           above. */
+        if(!structure.isCustom()) {
+            const Validation::Structure& validation = structures.begin()[parentSpecification];
+            const Int parentIdentifier = _structures[data.parent].custom.identifier - Int(Type::Custom);
+
+            /* Error if there are no primitive sub-structures allowed or there
+               is requirement on primitive count and we exceeded that
+               requirement */
+            if(!validation.primitives().size() || (++counts[parentCounts] > Int(validation.primitiveCount()) && validation.primitiveCount())) {
+                Error() << "OpenDdl::Document::validate(): expected exactly" << validation.primitiveCount() << "primitive sub-structures in structure" << structureName(parentIdentifier);
                 return false;
             }
 
-            ++i;
-        }
-    }
+            /* Verify that the primitive sub-structure has one of allowed types */
+            if(!(tables.primitiveTypes[parentSpecification] & (1u << UnsignedInt(structure.type())))) {
+                Error() << "OpenDdl::Document::validate(): unexpected sub-structure of type" << structure.type() << "in structure" << structureName(parentIdentifier);
+                return false;
+            }
 
-    /* Descend into substructures (breadth-first) */
-    for(Containers::Optional<Structure> it = first; it; it = it->findNext()) {
-        const Structure s = *it;
+            /* Verify that the primitive sub-structure has required size */
+            if(validation.primitiveArraySize() != 0 && structure.arraySize() != validation.primitiveArraySize()) {
+                Error() << "OpenDdl::Document::validate(): expected exactly" << validation.primitiveArraySize() << "values in" << structureName(parentIdentifier) << "sub-structure";
+                return false;
+            }
+
+            continue;
+        }
 
-        if(!s.isCustom() || s.identifier() == UnknownIdentifier) continue;
+        /* Ignore unknown custom structures including their children */
+        const Int identifier = structure.identifier();
+        if(identifier == UnknownIdentifier) continue;
 
-        auto found = std::find_if(structures.begin(), structures.end(), [s](const Validation::Structure& v){ return v.identifier() == s.identifier(); });
-        CORRADE_ASSERT(found != structures.end(), "OpenDdl::Document::validate(): missing specification for structure" << structureName(s.identifier()), false);
-        if(!validateStructure(s, *found, structures, counts))
+        /* Verify that the structure is allowed and that we don't exceed
+           allowed count */
+        const Int slot = tables.structureSlots[parentSpecification*tables.structureIdentifierCount + identifier];
+        if(slot == -1) {
+            Error() << "OpenDdl::Document::validate(): unexpected structure" << structureName(identifier);
             return false;
-    }
+        }
+        const std::pair<Int, std::pair<Int, Int>>& allowed = tables.allowedStructures(parentSpecification)[slot];
+        Int& count = counts[parentCounts + 1 + slot];
+        if(++count > allowed.second.second && allowed.second.second) {
+            Error() << "OpenDdl::Document::validate(): too many" << structureName(identifier) << "structures, got" << count << "but expected max" << allowed.second.second;
+            return false;
+        }
 
-    return true;
-}
+        /* A missing specification is a programmer error, but it's reported
+           only after everything else is checked, as other errors may be the
+           reason why the structure is there */
+        const Int specification = tables.specifications[identifier];
+        if(specification == -1) {
+            if(missingSpecification == UnknownIdentifier)
+                missingSpecification = identifier;
+            continue;
+        }
+        const Validation::Structure& validation = structures.begin()[specification];
+
+        /* Verify that there is no unexpected property (ignoring unknown ones) */
+        propertyCounts.assign(validation.properties().size(), 0);
+        for(const Property p: structure.properties()) {
+            if(p.identifier() == UnknownIdentifier) continue;
 
-bool Document::validateStructure(const Structure structure, const Validation::Structure& validation, const Containers::ArrayView<const Validation::Structure> structures, std::vector<Int>& counts) const {
-    counts.assign(validation.properties().size(), 0);
+            const Int propertySlot = tables.propertySlots[specification*tables.propertyIdentifierCount + p.identifier()];
+            if(propertySlot == -1) {
+                Error() << "OpenDdl::Document::validate(): unexpected property" << propertyName(p.identifier()) << "in structure" << structureName(identifier);
+                return false;
+            }
 
-    /* Verify that there is no unexpected property (ignoring unknown ones) */
-    for(const Property p: structure.properties()) {
-        if(p.identifier() == UnknownIdentifier) continue;
+            const Validation::Property& property = validation.properties()[propertySlot];
+            if(!p.isTypeCompatibleWith(property.type())) {
+                Error() << "OpenDdl::Document::validate(): unexpected type of property" << propertyName(p.identifier()) << ", expected" << property.type();
+                return false;
+            }
 
-        auto found = std::find_if(validation.properties().begin(), validation.properties().end(), [p](const Validation::Property& v){ return v.identifier() == p.identifier(); });
-        if(found == validation.properties().end()) {
-            Error() << "OpenDdl::Document::validate(): unexpected property" << propertyName(p.identifier()) << "in structure" << structureName(structure.identifier());
-            return false;
+            propertyCounts[propertySlot] = 1;
         }
 
-        if(!p.isTypeCompatibleWith(found->type())) {
-            Error() << "OpenDdl::Document::validate(): unexpected type of property" << propertyName(p.identifier()) << ", expected" << found->type();
-            return false;
+        /* Verify that all required properties are there */
+        for(std::size_t j = 0; j != validation.properties().size(); ++j) {
+            const Validation::Property& p = validation.properties()[j];
+            if(propertyCounts[j] == 0 && p.isRequired()) {
+                Error() << "OpenDdl::Document::validate(): expected property" << propertyName(p.identifier()) << "in structure" << structureName(identifier);
+                return false;
+            }
         }
 
-        counts[found - validation.properties().begin()] = 1;
-    }
-
-    /* Verify that all required properties are there */
-    {
-        std::size_t i = 0;
-        for(const Validation::Property& p: validation.properties()) if(counts[i++] == 0 && p.isRequired()) {
-            Error() << "OpenDdl::Document::validate(): expected property" << propertyName(p.identifier()) << "in structure" << structureName(structure.identifier());
-            return false;
-        }
+        /* Children are checked against this specification */
+        state[i] = {specification, counts.size()};
+        counts.resize(counts.size() + 1 + validation.structures().size(), 0);
     }
 
-    /* Check that there are only primitive sub-structures with required type
-       and size and in required amount */
-    Int remainingPrimitiveCountAllowed = validation.primitiveCount();
-    for(const Structure s: structure.children()) {
-        if(s.isCustom()) continue;
-
-        /* Error if there are no primitive sub-structures allowed or there is requirement on
-           primitive count and we exceeded that requirement */
-        if(!validation.primitives().size() || (validation.primitiveCount() && --remainingPrimitiveCountAllowed < 0)) {
-            Error() << "OpenDdl::Document::validate(): expected exactly" << validation.primitiveCount() << "primitive sub-structures in structure" << structureName(structure.identifier());
-            return false;
+    /* Verify that all required custom and primitive sub-structures are there,
+       now that everything is counted */
+    for(std::size_t i = 0, end = _structures.size() + 1; i != end; ++i) {
+        std::size_t specification, offset;
+        Int identifier;
+        if(i == 0) {
+            specification = tables.root;
+            offset = 0;
+            identifier = UnknownIdentifier;
+        } else {
+            if(state[i - 1].first == -1) continue;
+            specification = state[i - 1].first;
+            offset = state[i - 1].second;
+            identifier = _structures[i - 1].custom.identifier - Int(Type::Custom);
         }
 
-        /* Verify that the primitive sub-structure has one of allowed types */
-        auto found = std::find(validation.primitives().begin(), validation.primitives().end(), s.type());
-        if(found == validation.primitives().end()) {
-            Error() << "OpenDdl::Document::validate(): unexpected sub-structure of type" << s.type() << "in structure" << structureName(structure.identifier());
-            return false;
+        const Containers::ArrayView<const std::pair<Int, std::pair<Int, Int>>> allowed = tables.allowedStructures(specification);
+        for(std::size_t j = 0; j != allowed.size(); ++j) {
+            if(allowed[j].second.first > counts[offset + 1 + j]) {
+                Error() << "OpenDdl::Document::validate(): too little" << structureName(allowed[j].first) << "structures, got" << counts[offset + 1 + j] << "but expected min" << allowed[j].second.first;
+                return false;
+            }
         }
 
-        /* Verify that the primitive sub-structure has required size */
-        if(validation.primitiveArraySize() != 0 && s.arraySize() != validation.primitiveArraySize()) {
-            Error() << "OpenDdl::Document::validate(): expected exactly" << validation.primitiveArraySize() << "values in" << structureName(structure.identifier()) << "sub-structure";
-            return false;
+        /* Error if there was requirement on primitive structures count and we
+           had less primitive structures */
+        if(specification != tables.root) {
+            const Validation::Structure& validation = structures.begin()[specification];
+            if(validation.primitiveCount() && counts[offset] < Int(validation.primitiveCount())) {
+                Error() << "OpenDdl::Document::validate(): expected exactly" << validation.primitiveCount() << "primitive sub-structures in structure" << structureName(identifier);
+                return false;
+            }
         }
     }
 
-    /* Error if there was requirement on primitive structures count and we had
-       less primitive structures */
-    if(validation.primitiveCount() && remainingPrimitiveCountAllowed > 0) {
-        Error() << "OpenDdl::Document::validate(): expected exactly" << validation.primitiveCount() << "primitive sub-structures in structure" << structureName(structure.identifier());
-        return false;
-    }
+    CORRADE_ASSERT(missingSpecification == UnknownIdentifier, "OpenDdl::Document::validate(): missing specification for structure" << structureName(missingSpecification), false);
 
-    /* Check also custom substructures */
-    return validateLevel(structure.findFirstChild(), validation.structures(), structures, counts);
+    return true;
 }
 
 const char* Document::structureName(const Int identifier) const {
@@ -918,7 +1927,7 @@ const char* Document::propertyName(const Int identifier) const {
 }
 
 #ifndef DOXYGEN_GENERATING_OUTPUT
-Document::StructureData::StructureData(const Type type, const std::size_t name, const std::size_t subArraySize, const std::size_t dataBegin, const std::size_t dataSize, const std::size_t parent, const std::size_t next) noexcept: name{name}, primitive{type, subArraySize, dataBegin, dataSize}, parent{parent}, next{next} {
+Document::StructureData::StructureData(const Type type, const std::size_t name, const std::size_t subArraySize, const std::size_t dataBegin, const std::size_t dataSize, const std::size_t parent, const std::size_t next, const bool lazy) noexcept: name{name}, primitive{type, subArraySize, dataBegin, dataSize, lazy}, parent{parent}, next{next} {
     CORRADE_INTERNAL_ASSERT(type < Type::Custom);
 }
 
@@ -983,11 +1992,20 @@ Int Structure::identifier() const {
     return Int(_data.get().primitive.type) - Int(Type::Custom);
 }
 
+std::size_t Structure::index() const {
+    return &_data.get() - _document.get()._structures.data();
+}
+
 std::size_t Structure::arraySize() const {
     CORRADE_ASSERT(!isCustom(), "OpenDdl::Structure::arraySize(): not a primitive structure", {});
     return _data.get().primitive.size;
 }
 
+bool Structure::parseData() const {
+    CORRADE_ASSERT(!isCustom(), "OpenDdl::Structure::parseData(): not a primitive structure", {});
+    return !_data.get().primitive.lazy || _document.get().parseLazyData(_data.get());
+}
+
 std::size_t Structure::subArraySize() const {
     CORRADE_ASSERT(!isCustom(), "OpenDdl::Structure::subArraySize(): not a primitive structure", {});
     return _data.get().primitive.subArraySize;
@@ -1005,9 +2023,11 @@ Containers::Array<Containers::Optional<Structure>> Structure::asReferenceArray()
     CORRADE_ASSERT(type() == Type::Reference, "OpenDdl::Structure::asReferenceArray(): not of reference type", nullptr);
 
     Containers::Array<Containers::Optional<Structure>> out(_data.get().primitive.size);
-    for(std::size_t i = 0; i != _data.get().primitive.size; ++i)
-        if(const std::size_t reference = _document.get()._references[_data.get().primitive.begin + i])
+    for(std::size_t i = 0; i != _data.get().primitive.size; ++i) {
+        const std::size_t reference = _document.get()._references[_data.get().primitive.begin + i];
+        if(reference != NullReference)
             out[i] = Structure{_document, _document.get()._structures[reference]};
+    }
 
     return out;
 }
@@ -1124,7 +2144,9 @@ Implementation::StructureOfList<1> Structure::childrenOf(Int identifier) const {
     return Implementation::StructureOfList<1>{findFirstChildOf(identifier), identifier};
 }
 
-bool Property::isTypeCompatibleWith(PropertyType type) const {
+namespace {
+
+bool isPropertyTypeCompatible(const Implementation::InternalPropertyType internalType, const PropertyType type) {
     switch(type) {
         case PropertyType::UnsignedByte:
         case PropertyType::Byte:
@@ -1136,26 +2158,32 @@ bool Property::isTypeCompatibleWith(PropertyType type) const {
         case PropertyType::UnsignedLong:
         case PropertyType::Long:
         #endif
-            return _data.get().type == Implementation::InternalPropertyType::Integral ||
-                   _data.get().type == Implementation::InternalPropertyType::Binary ||
-                   _data.get().type == Implementation::InternalPropertyType::Character;
+            return internalType == Implementation::InternalPropertyType::Integral ||
+                   internalType == Implementation::InternalPropertyType::Binary ||
+                   internalType == Implementation::InternalPropertyType::Character;
 
-        /** @todo Half */
+        case PropertyType::Half:
         case PropertyType::Float:
         case PropertyType::Double:
             /** @todo Implement extracting float properties from binary */
-            return _data.get().type == Implementation::InternalPropertyType::Float;
+            return internalType == Implementation::InternalPropertyType::Float;
 
         case PropertyType::Bool:
         case PropertyType::String:
         case PropertyType::Reference:
         case PropertyType::Type:
-            return _data.get().type == Implementation::InternalPropertyType(UnsignedByte(type));
+            return internalType == Implementation::InternalPropertyType(UnsignedByte(type));
     }
 
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
+}
+
+bool Property::isTypeCompatibleWith(PropertyType type) const {
+    return isPropertyTypeCompatible(_data.get().type, type);
+}
+
 Containers::Optional<Structure> Property::asReference() const {
     CORRADE_ASSERT(isTypeCompatibleWith(PropertyType::Reference), "OpenDdl::Property::asReference(): not of reference type", {});
     const std::size_t reference = _document.get()._references[_data.get().position];
@@ -1163,6 +2191,341 @@ Containers::Optional<Structure> Property::asReference() const {
         Containers::optional(Structure{_document, _document.get()._structures[reference]});
 }
 
+Reader::Reader(): _chunkSize{4096} {}
+
+Reader::~Reader() = default;
+
+Reader& Reader::setChunkSize(const std::size_t size) {
+    CORRADE_ASSERT(size, "OpenDdl::Reader::setChunkSize(): the size must not be zero", *this);
+    _chunkSize = size;
+    return *this;
+}
+
+void Reader::structureBeginEvent(const StructureEvent&) {}
+
+void Reader::structureEndEvent(const StructureEvent&) {}
+
+void Reader::propertyEvent(const PropertyEvent&) {}
+
+void Reader::dataEvent(const DataEvent&) {}
+
+/* Collects parsed data list items into chunks which are then passed to
+   dataEvent() */
+template<class T> struct Reader::DataOutput {
+    void operator()(T value) {
+        data[size++] = std::move(value);
+        if(size == capacity) flush();
+    }
+
+    void flush() {
+        if(!size) return;
+        reader.dataEvent(DataEvent{type, subArraySize, offset, size, data});
+        offset += size;
+        size = 0;
+    }
+
+    Reader& reader;
+    Type type;
+    std::size_t subArraySize;
+    T* data;
+    std::size_t capacity, offset, size;
+};
+
+namespace {
+
+template<class T> T* chunkStorage(Containers::Array<char>& chunk, std::vector<std::string>&, const std::size_t size) {
+    if(chunk.size() < size*sizeof(T))
+        chunk = Containers::Array<char>{Containers::NoInit, size*sizeof(T)};
+    return reinterpret_cast<T*>(chunk.data());
+}
+
+template<> std::string* chunkStorage<std::string>(Containers::Array<char>&, std::vector<std::string>& chunk, const std::size_t size) {
+    if(chunk.size() < size) chunk.resize(size);
+    return chunk.data();
+}
+
+}
+
+bool Reader::parse(const Containers::ArrayView<const char> data, const std::initializer_list<CharacterLiteral> structureIdentifiers, const std::initializer_list<CharacterLiteral> propertyIdentifiers) {
+    _structureIdentifiers = {structureIdentifiers.begin(), structureIdentifiers.size()};
+    _propertyIdentifiers = {propertyIdentifiers.begin(), propertyIdentifiers.size()};
+    identifierTable(_structureIdentifiers, _structureIdentifierTable);
+    identifierTable(_propertyIdentifiers, _propertyIdentifierTable);
+
+    Implementation::ParseError error;
+    std::string buffer;
+
+    const char* i = Implementation::whitespace(data);
+    i = parseStructureList(0, data.suffix(i), buffer, error);
+
+    if(!i) {
+        printParseError("OpenDdl::Reader::parse():", data, error);
+        return false;
+    }
+
+    return true;
+}
+
+const char* Reader::parseProperty(const Containers::ArrayView<const char> data, std::string& buffer, const Int identifier, Implementation::ParseError& error) {
+    PropertyEvent event{identifier};
+
+    const char* i;
+    std::tie(i, event._type) = Implementation::propertyValue(data, event._boolValue, event._integerValue, event._floatValue, event._stringValue, event._referenceValue, event._typeValue, buffer, error);
+
+    if(!i) return nullptr;
+
+    /* References are compatible with strings, so make them available as
+       such as well */
+    if(event._type == Implementation::InternalPropertyType::Reference)
+        event._stringValue.assign(event._referenceValue.data(), event._referenceValue.size());
+
+    propertyEvent(event);
+    return i;
+}
+
+template<Type type, class T> const char* Reader::parseDataList(StructureEvent& event, const Containers::ArrayView<const char> data, std::string& buffer, Implementation::ParseError& error) {
+    /* Split the list only on subarray boundaries */
+    const std::size_t capacity = event._subArraySize ?
+        std::max(event._subArraySize, _chunkSize - _chunkSize % event._subArraySize) : _chunkSize;
+    DataOutput<T> output{*this, type, event._subArraySize, chunkStorage<T>(_chunk, _stringChunk, capacity), capacity, 0, 0};
+
+    const char* i;
+    std::tie(i, event._arraySize) = dataArrayList<type>(data, output, buffer, event._subArraySize, error);
+
+    /* Report the remaining data */
+    if(i) output.flush();
+
+    return i;
+}
+
+const char* Reader::parseStructure(const std::size_t depth, const Containers::ArrayView<const char> data, std::string& buffer, Implementation::ParseError& error) {
+    /* Identifier */
+    const char* const structureIdentifier = Implementation::identifier(data, error);
+    if(!structureIdentifier) return {};
+
+    StructureEvent event{depth};
+
+    /* Decide whether primitive or custom */
+    const char* i;
+    std::tie(i, event._type) = Implementation::possiblyTypeLiteral(data.prefix(structureIdentifier));
+
+    /* Primitive */
+    if(i) {
+        i = Implementation::whitespace(data.suffix(structureIdentifier));
+
+        /* Array */
+        if(i != data.end() && *i == '[') {
+            i = Implementation::whitespace(data.suffix(i + 1));
+
+            std::tie(i, event._subArraySize, std::ignore) = Implementation::integralLiteral<std::size_t>(data.suffix(i), error);
+
+            if(event._subArraySize == 0) {
+                error = {Implementation::ParseErrorType::InvalidSubArraySize, i};
+                return {};
+            }
+
+            if(!i) return {};
+
+            i = Implementation::whitespace(data.suffix(i));
+
+            if(i == data.end() || *i != ']') {
+                error = {Implementation::ParseErrorType::ExpectedArraySizeEnd, i};
+                return {};
+            }
+
+            i = Implementation::whitespace(data.suffix(i + 1));
+        }
+
+        /* Name */
+        if(i && i != data.end() && (*i == '%' || *i == '$')) {
+            std::tie(i, event._name) = Implementation::nameLiteral(data.suffix(i), error);
+            i = Implementation::whitespace(data.suffix(i));
+        }
+
+        /* Propagate errors */
+        if(!i) return {};
+
+        /* Data list */
+        if(i == data.end() || *i != '{') {
+            error = {Implementation::ParseErrorType::ExpectedListStart, i};
+            return {};
+        }
+
+        i = Implementation::whitespace(data.suffix(i + 1));
+
+        structureBeginEvent(event);
+
+        switch(event._type) {
+            #define _c(type, T) \
+            case Type::type: \
+                i = parseDataList<Type::type, T>(event, data.suffix(i), buffer, error); \
+                break;
+            _c(Bool, bool)
+            _c(UnsignedByte, UnsignedByte)
+            _c(Byte, Byte)
+            _c(UnsignedShort, UnsignedShort)
+            _c(Short, Short)
+            _c(UnsignedInt, UnsignedInt)
+            _c(Int, Int)
+            #ifndef MAGNUM_TARGET_WEBGL
+            _c(UnsignedLong, UnsignedLong)
+            _c(Long, Long)
+            #endif
+            _c(Half, Half)
+            _c(Float, Float)
+            _c(Double, Double)
+            _c(String, std::string)
+            _c(Reference, Containers::ArrayView<const char>)
+            _c(Type, Type)
+            #undef _c
+            case Type::Custom:
+                CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
+
+        /* Propagate errors */
+        if(!i) return {};
+
+        i = Implementation::whitespace(data.suffix(i));
+
+        if(i == data.end() || *i != '}') {
+            error = {Implementation::ParseErrorType::ExpectedListEnd, i};
+            return {};
+        }
+
+        structureEndEvent(event);
+        return i + 1;
+
+    /* Custom structure */
+    } else {
+        event._type = Type::Custom;
+        event._identifier = identifierId(data.prefix(structureIdentifier), _structureIdentifiers, _structureIdentifierTable);
+
+        i = Implementation::whitespace(data.suffix(structureIdentifier));
+
+        /* Name */
+        if(i && i != data.end() && (*i == '%' || *i == '$')) {
+            std::tie(i, event._name) = Implementation::nameLiteral(data.suffix(i), error);
+            i = Implementation::whitespace(data.suffix(i));
+        }
+
+        /* Propagate errors */
+        if(!i) return {};
+
+        structureBeginEvent(event);
+
+        /* Property list */
+        if(i != data.end() && *i == '(') {
+            i = Implementation::whitespace(data.suffix(i + 1));
+
+            std::size_t propertyCount = 0;
+            while(i && i != data.end() && *i != ')') {
+                if(propertyCount) {
+                    if(*i != ',') {
+                        error = {Implementation::ParseErrorType::ExpectedSeparator, i};
+                        return {};
+                    }
+
+                    i = Implementation::whitespace(data.suffix(i + 1));
+                }
+
+                const char* const propertyIdentifier = Implementation::identifier(data.suffix(i), error);
+                if(!propertyIdentifier) return {};
+
+                const Int propertyIdentifierId = identifierId(data.slice(i, propertyIdentifier), _propertyIdentifiers, _propertyIdentifierTable);
+
+                i = Implementation::whitespace(data.suffix(propertyIdentifier));
+
+                if(i == data.end() || *i != '=') {
+                    error = {Implementation::ParseErrorType::ExpectedPropertyAssignment, i};
+                    return {};
+                }
+
+                i = Implementation::whitespace(data.suffix(i + 1));
+
+                i = parseProperty(data.suffix(i), buffer, propertyIdentifierId, error);
+
+                i = Implementation::whitespace(data.suffix(i));
+
+                ++propertyCount;
+            }
+
+            /* Propagate errors */
+            if(!i) return {};
+
+            if(i == data.end() || *i != ')') {
+                error = {Implementation::ParseErrorType::ExpectedPropertyListEnd, i};
+                return {};
+            }
+
+            i = Implementation::whitespace(data.suffix(i + 1));
+        }
+
+        /* Structure start */
+        if(i == data.end() || *i != '{') {
+            error = {Implementation::ParseErrorType::ExpectedListStart, i};
+            return {};
+        }
+
+        i = Implementation::whitespace(data.suffix(i + 1));
+
+        /* Substructures */
+        i = parseStructureList(depth + 1, data.suffix(i), buffer, error);
+
+        /* Propagate errors */
+        if(!i) return {};
+
+        i = Implementation::whitespace(data.suffix(i));
+
+        /* Structure end */
+        if(i == data.end() || *i != '}') {
+            error = {Implementation::ParseErrorType::ExpectedListEnd, i};
+            return {};
+        }
+
+        structureEndEvent(event);
+        return i + 1;
+    }
+}
+
+const char* Reader::parseStructureList(const std::size_t depth, const Containers::ArrayView<const char> data, std::string& buffer, Implementation::ParseError& error) {
+    const char* i = data;
+    while(i && i != data.end() && *i != '}') {
+        i = parseStructure(depth, data.suffix(i), buffer, error);
+        i = Implementation::whitespace(data.suffix(i));
+    }
+
+    return i;
+}
+
+Int Reader::StructureEvent::identifier() const {
+    CORRADE_ASSERT(isCustom(), "OpenDdl::Reader::StructureEvent::identifier(): not a custom structure", {});
+    return _identifier;
+}
+
+std::size_t Reader::StructureEvent::arraySize() const {
+    CORRADE_ASSERT(!isCustom(), "OpenDdl::Reader::StructureEvent::arraySize(): not a primitive structure", {});
+    return _arraySize;
+}
+
+std::size_t Reader::StructureEvent::subArraySize() const {
+    CORRADE_ASSERT(!isCustom(), "OpenDdl::Reader::StructureEvent::subArraySize(): not a primitive structure", {});
+    return _subArraySize;
+}
+
+bool Reader::PropertyEvent::isTypeCompatibleWith(const PropertyType type) const {
+    return isPropertyTypeCompatible(_type, type);
+}
+
+Containers::ArrayView<const char> Reader::PropertyEvent::asReference() const {
+    CORRADE_ASSERT(isTypeCompatibleWith(PropertyType::Reference), "OpenDdl::Reader::PropertyEvent::asReference(): not of reference type", {});
+    return _referenceValue;
+}
+
+Containers::ArrayView<const Containers::ArrayView<const char>> Reader::DataEvent::asReferenceArray() const {
+    CORRADE_ASSERT(_type == Type::Reference, "OpenDdl::Reader::DataEvent::asReferenceArray(): not of reference type", nullptr);
+    return {static_cast<const Containers::ArrayView<const char>*>(_data), _size};
+}
+
 namespace Validation {
 
 Structure::Structure(Int identifier, Properties properties, Primitives primitives, std::size_t primitiveCount, std::size_t primitiveArraySize, Structures structures):
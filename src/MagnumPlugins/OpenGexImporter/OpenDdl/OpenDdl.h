@@ -35,7 +35,9 @@ namespace Magnum { namespace OpenDdl {
 
 struct CharacterLiteral;
 class Document;
+enum class Half: UnsignedShort;
 class Property;
+class Reader;
 class Structure;
 enum class Type: UnsignedInt;
 
@@ -114,6 +114,9 @@ namespace Implementation {
     template<> constexpr bool isPropertyType<std::string>(InternalPropertyType type) {
         return type == InternalPropertyType::String || type == InternalPropertyType::Reference;
     }
+    template<> constexpr bool isPropertyType<Type>(InternalPropertyType type) {
+        return type == InternalPropertyType::Type;
+    }
 }
 
 template<class T>
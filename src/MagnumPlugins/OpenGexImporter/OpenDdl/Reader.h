@@ -0,0 +1,452 @@
+#ifndef Magnum_OpenDdl_Reader_h
+#define Magnum_OpenDdl_Reader_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::OpenDdl::Reader
+ */
+
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Document.h"
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Property.h"
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Structure.h"
+
+namespace Magnum { namespace OpenDdl {
+
+/**
+@brief Streaming OpenDDL reader
+
+Unlike @ref Document, which keeps the whole parsed file in memory, the reader
+goes through the file just once and reports its contents via virtual event
+functions, so memory use doesn't depend on file size. Useful for example for
+converting OpenDDL-based files into a different format. The reader shares the
+tokenizer with @ref Document, so the accepted syntax and error diagnostics are
+the same.
+
+## Usage
+
+Subclass the reader and implement the events you're interested in, all of them
+do nothing by default. The structure and property identifier lists are the
+same as in @ref Document::parse():
+@code
+// Counts all values in vertex arrays
+class VertexDataCounter: public OpenDdl::Reader {
+    public:
+        std::size_t count{};
+
+    private:
+        void structureBeginEvent(const StructureEvent& event) override {
+            if(event.isCustom() && event.identifier() == OpenGex::VertexArray)
+                _inVertexArray = true;
+        }
+
+        void structureEndEvent(const StructureEvent& event) override {
+            if(event.isCustom() && event.identifier() == OpenGex::VertexArray)
+                _inVertexArray = false;
+        }
+
+        void dataEvent(const DataEvent& event) override {
+            if(_inVertexArray) count += event.size();
+        }
+
+        bool _inVertexArray{};
+};
+
+VertexDataCounter counter;
+bool parsed = counter.parse(data, OpenGex::structures, OpenGex::properties);
+@endcode
+
+For a custom structure, @ref structureBeginEvent() is followed by one
+@ref propertyEvent() for each property, then by events for all substructures
+and finally by @ref structureEndEvent(). For a primitive structure,
+@ref structureBeginEvent() is followed by zero or more @ref dataEvent() calls
+and @ref structureEndEvent(). Data lists are delivered in chunks of at most
+@ref chunkSize() values, so a large array never needs to be in memory at once.
+References are not resolved and are reported as the reference text instead.
+
+If the file has syntax errors, @ref parse() returns `false` and prints
+detailed diagnostics on @ref Corrade::Utility::Error output. Events for the
+part of the file before the error are already reported at that point.
+
+@requires_gl On OpenGL ES and WebGL the `double` type is not recognized.
+    Additionally, due to JavaScript limitations, on WebGL the `unsigned_int64`
+    and `int64` types are not recognized.
+*/
+class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Reader {
+    public:
+        class StructureEvent;
+        class PropertyEvent;
+        class DataEvent;
+
+        /** @brief Constructor */
+        explicit Reader();
+
+        /** @brief Copying is disabled */
+        Reader(const Reader&) = delete;
+
+        /** @brief Moving is disabled */
+        Reader(Reader&&) = delete;
+
+        virtual ~Reader();
+
+        /** @brief Copying is disabled */
+        Reader& operator=(const Reader&) = delete;
+
+        /** @brief Moving is disabled */
+        Reader& operator=(Reader&&) = delete;
+
+        /** @brief Maximal count of values in one data chunk */
+        std::size_t chunkSize() const { return _chunkSize; }
+
+        /**
+         * @brief Set maximal count of values in one data chunk
+         * @return Reference to self (for method chaining)
+         *
+         * Data lists with subarrays are split only on subarray boundaries,
+         * thus if the subarray size is larger than @p size, each chunk
+         * contains exactly one subarray. The size must not be zero. Default
+         * is @cpp 4096 @ce.
+         * @see @ref dataEvent()
+         */
+        Reader& setChunkSize(std::size_t size);
+
+        /**
+         * @brief Parse data
+         * @param data                      Document data
+         * @param structureIdentifiers      Structure identifiers
+         * @param propertyIdentifiers       Property identifiers
+         * @return Whether the parsing succeeded
+         *
+         * Each identifier from the lists is converted to ID corresponding to
+         * its position in the list, identifiers not in the lists are reported
+         * with @ref UnknownIdentifier ID. The events are called from within
+         * this function, in the order the data are in the file.
+         */
+        bool parse(Containers::ArrayView<const char> data, std::initializer_list<CharacterLiteral> structureIdentifiers, std::initializer_list<CharacterLiteral> propertyIdentifiers);
+
+    #ifdef DOXYGEN_GENERATING_OUTPUT
+    protected:
+    #else
+    private:
+    #endif
+        /**
+         * @brief Structure begin event
+         *
+         * Called after the structure identifier and name are parsed. Default
+         * implementation does nothing.
+         */
+        virtual void structureBeginEvent(const StructureEvent& event);
+
+        /**
+         * @brief Structure end event
+         *
+         * Called after all properties, substructures or data of given
+         * structure were reported. Default implementation does nothing.
+         */
+        virtual void structureEndEvent(const StructureEvent& event);
+
+        /**
+         * @brief Property event
+         *
+         * Called for each property of a custom structure. Default
+         * implementation does nothing.
+         */
+        virtual void propertyEvent(const PropertyEvent& event);
+
+        /**
+         * @brief Data event
+         *
+         * Called for each chunk of a primitive structure data list. Empty
+         * data lists don't produce any data events. Default implementation
+         * does nothing.
+         * @see @ref setChunkSize()
+         */
+        virtual void dataEvent(const DataEvent& event);
+
+    private:
+        template<class> struct DataOutput;
+
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* parseStructure(std::size_t depth, Containers::ArrayView<const char> data, std::string& buffer, Implementation::ParseError& error);
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* parseStructureList(std::size_t depth, Containers::ArrayView<const char> data, std::string& buffer, Implementation::ParseError& error);
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* parseProperty(Containers::ArrayView<const char> data, std::string& buffer, Int identifier, Implementation::ParseError& error);
+        template<Type type, class T> MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL const char* parseDataList(StructureEvent& event, Containers::ArrayView<const char> data, std::string& buffer, Implementation::ParseError& error);
+
+        std::size_t _chunkSize;
+
+        /* Chunk storage, the first is for trivially copyable types, the
+           second for strings */
+        Containers::Array<char> _chunk;
+        std::vector<std::string> _stringChunk;
+
+        Containers::ArrayView<const CharacterLiteral> _structureIdentifiers;
+        Containers::ArrayView<const CharacterLiteral> _propertyIdentifiers;
+        /* Hash tables of IDs for the above identifier lists */
+        std::vector<Int> _structureIdentifierTable;
+        std::vector<Int> _propertyIdentifierTable;
+};
+
+/**
+@brief Structure event
+
+See @ref Reader for more information.
+@see @ref Reader::structureBeginEvent(), @ref Reader::structureEndEvent()
+*/
+class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Reader::StructureEvent {
+    public:
+        /** @brief Copying is disabled */
+        StructureEvent(const StructureEvent&) = delete;
+
+        /** @brief Copying is disabled */
+        StructureEvent& operator=(const StructureEvent&) = delete;
+
+        /**
+         * @brief Whether the structure is custom
+         *
+         * @see @ref type(), @ref identifier()
+         */
+        bool isCustom() const { return _type == Type::Custom; }
+
+        /**
+         * @brief Structure type
+         *
+         * @see @ref isCustom(), @ref identifier()
+         */
+        Type type() const { return _type; }
+
+        /**
+         * @brief Custom structure identifier
+         *
+         * The structure must be custom.
+         * @see @ref isCustom(), @ref UnknownIdentifier
+         */
+        Int identifier() const;
+
+        /**
+         * @brief Structure depth
+         *
+         * @cpp 0 @ce for top-level structures.
+         */
+        std::size_t depth() const { return _depth; }
+
+        /** @brief Whether the structure has a name */
+        bool hasName() const { return !_name.empty(); }
+
+        /**
+         * @brief Structure name
+         *
+         * @see @ref hasName()
+         */
+        const std::string& name() const { return _name; }
+
+        /**
+         * @brief Array size
+         *
+         * The structure must not be custom. As the data are not known yet in
+         * @ref Reader::structureBeginEvent(), @cpp 0 @ce is returned there.
+         * @see @ref isCustom()
+         */
+        std::size_t arraySize() const;
+
+        /**
+         * @brief Subarray size
+         *
+         * The structure must not be custom. If the array has no subarrays,
+         * @cpp 0 @ce is returned.
+         * @see @ref isCustom()
+         */
+        std::size_t subArraySize() const;
+
+    private:
+        friend Reader;
+
+        explicit StructureEvent(std::size_t depth) noexcept: _type{}, _identifier{UnknownIdentifier}, _depth{depth}, _arraySize{}, _subArraySize{} {}
+
+        Type _type;
+        Int _identifier;
+        std::size_t _depth, _arraySize, _subArraySize;
+        std::string _name;
+};
+
+/**
+@brief Property event
+
+See @ref Reader for more information.
+@see @ref Reader::propertyEvent()
+*/
+class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Reader::PropertyEvent {
+    public:
+        /** @brief Copying is disabled */
+        PropertyEvent(const PropertyEvent&) = delete;
+
+        /** @brief Copying is disabled */
+        PropertyEvent& operator=(const PropertyEvent&) = delete;
+
+        /**
+         * @brief Property identifier
+         *
+         * @see @ref UnknownIdentifier
+         */
+        Int identifier() const { return _identifier; }
+
+        /** @brief Whether property type is compatible with given type */
+        bool isTypeCompatibleWith(PropertyType type) const;
+
+        /**
+         * @brief Property data
+         *
+         * The property type must be compatible with desired type.
+         * @see @ref isTypeCompatibleWith(), @ref asReference()
+         */
+        template<class T>
+        #ifndef DOXYGEN_GENERATING_OUTPUT
+        typename Implementation::ReturnTypeFor<T>::Type
+        #else
+        const T&
+        #endif
+        as() const;
+
+        /**
+         * @brief Reference property data
+         *
+         * The property type must be @ref Type::Reference. As references are
+         * not resolved by the reader, returns the reference text, which is
+         * empty if the reference is `null`. The view is valid only for the
+         * lifetime of the data passed to @ref Reader::parse().
+         * @see @ref isTypeCompatibleWith()
+         */
+        Containers::ArrayView<const char> asReference() const;
+
+    private:
+        friend Reader;
+
+        explicit PropertyEvent(Int identifier) noexcept: _identifier{identifier}, _type{}, _boolValue{}, _integerValue{}, _floatValue{}, _typeValue{} {}
+
+        /* The type is checked in as() */
+        template<class T> typename Implementation::ReturnTypeFor<T>::Type value() const;
+
+        Int _identifier;
+        Implementation::InternalPropertyType _type;
+        bool _boolValue;
+        Int _integerValue;
+        Float _floatValue;
+        Type _typeValue;
+        std::string _stringValue;
+        Containers::ArrayView<const char> _referenceValue;
+};
+
+/**
+@brief Data event
+
+See @ref Reader for more information.
+@see @ref Reader::dataEvent()
+*/
+class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Reader::DataEvent {
+    public:
+        /** @brief Copying is disabled */
+        DataEvent(const DataEvent&) = delete;
+
+        /** @brief Copying is disabled */
+        DataEvent& operator=(const DataEvent&) = delete;
+
+        /** @brief Data type */
+        Type type() const { return _type; }
+
+        /**
+         * @brief Subarray size
+         *
+         * If the array has no subarrays, @cpp 0 @ce is returned. The chunk
+         * always contains whole subarrays.
+         */
+        std::size_t subArraySize() const { return _subArraySize; }
+
+        /** @brief Offset of the first value in the chunk in the whole list */
+        std::size_t offset() const { return _offset; }
+
+        /** @brief Count of values in the chunk */
+        std::size_t size() const { return _size; }
+
+        /**
+         * @brief Chunk data
+         *
+         * The data must be of corresponding type. The view is valid only
+         * until the event returns.
+         * @see @ref type(), @ref asReferenceArray()
+         */
+        template<class T> Containers::ArrayView<const T> asArray() const;
+
+        /**
+         * @brief Reference chunk data
+         *
+         * The data must be of @ref Type::Reference type. Returns the
+         * reference text for each item, which is empty if the reference is
+         * `null`. The outer view is valid only until the event returns, the
+         * inner views for the lifetime of the data passed to
+         * @ref Reader::parse().
+         * @see @ref type(), @ref asArray()
+         */
+        Containers::ArrayView<const Containers::ArrayView<const char>> asReferenceArray() const;
+
+    private:
+        friend Reader;
+
+        explicit DataEvent(Type type, std::size_t subArraySize, std::size_t offset, std::size_t size, const void* data) noexcept: _type{type}, _subArraySize{subArraySize}, _offset{offset}, _size{size}, _data{data} {}
+
+        Type _type;
+        std::size_t _subArraySize, _offset, _size;
+        const void* _data;
+};
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#define _c(T, member) \
+    template<> inline Implementation::ReturnTypeFor<T>::Type Reader::PropertyEvent::value<T>() const { return member; }
+_c(bool, _boolValue)
+_c(Int, _integerValue)
+_c(Float, _floatValue)
+_c(std::string, _stringValue)
+_c(Type, _typeValue)
+#undef _c
+#endif
+
+template<class T>
+#ifndef DOXYGEN_GENERATING_OUTPUT
+typename Implementation::ReturnTypeFor<T>::Type
+#else
+const T&
+#endif
+Reader::PropertyEvent::as() const {
+    CORRADE_ASSERT(Implementation::isPropertyType<T>(_type),
+        "OpenDdl::Reader::PropertyEvent::as(): not compatible with given type", value<T>());
+    return value<T>();
+}
+
+template<class T> Containers::ArrayView<const T> Reader::DataEvent::asArray() const {
+    CORRADE_ASSERT(Implementation::isStructureType<T>(_type),
+        "OpenDdl::Reader::DataEvent::asArray(): not of given type", nullptr);
+    return {static_cast<const T*>(_data), _size};
+}
+
+}}
+
+#endif
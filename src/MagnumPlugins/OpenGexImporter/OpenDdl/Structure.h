@@ -93,6 +93,15 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Structure {
          */
         Int identifier() const;
 
+        /**
+         * @brief Structure index
+         *
+         * Unique for each structure in the document and less than
+         * @ref Document::structureCount(), useful for associating additional
+         * data with the structures.
+         */
+        std::size_t index() const;
+
         /** @brief Whether the structure has a name */
         bool hasName() const { return _data.get().name != 0; }
 
@@ -164,6 +173,20 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Structure {
          */
         Containers::Array<Containers::Optional<Structure>> asReferenceArray() const;
 
+        /**
+         * @brief Parse structure data
+         * @return Whether the data are parsed successfully
+         *
+         * The structure must not be custom. If the data were deferred by
+         * @ref Document::setLazyParsingThreshold() and weren't parsed yet,
+         * parses them, otherwise just returns the result of previous parsing.
+         * This is done implicitly by @ref as() and @ref asArray(), call it
+         * explicitly to check for errors --- if the parsing fails, detailed
+         * info is printed on error output, the function returns
+         * @cpp false @ce and the data are filled with zeros.
+         */
+        bool parseData() const;
+
         /**
          * @brief Parent structure
          *
@@ -371,6 +394,7 @@ namespace Implementation {
     template<> inline bool isStructureType<std::string>(Type type) {
         return type == Type::String;
     }
+    template<> inline bool isStructureType<Type>(Type type) { return type == Type::Type; }
     #ifndef DOXYGEN_GENERATING_OUTPUT
     #define _c(T) \
         template<> inline bool isStructureType<T>(Type type) { return type == Type::T; }
@@ -384,7 +408,7 @@ namespace Implementation {
     _c(UnsignedLong)
     _c(Long)
     #endif
-    /** @todo Half */
+    _c(Half)
     _c(Float)
     _c(Double)
     #undef _c
@@ -402,12 +426,16 @@ Structure::as() const {
         "OpenDdl::Structure::as(): not a single value", _document.get().data<T>().front());
     CORRADE_ASSERT(Implementation::isStructureType<T>(type()),
         "OpenDdl::Structure::as(): not of given type", _document.get().data<T>().front());
+    if(_data.get().primitive.lazy)
+        return *reinterpret_cast<const T*>(_document.get().lazyData(_data.get()));
     return _document.get().data<T>()[_data.get().primitive.begin];
 }
 
 template<class T> Containers::ArrayView<const T> Structure::asArray() const {
     CORRADE_ASSERT(Implementation::isStructureType<T>(type()),
         "OpenDdl::Structure::asArray(): not of given type", nullptr);
+    if(_data.get().primitive.lazy)
+        return {reinterpret_cast<const T*>(_document.get().lazyData(_data.get())), _data.get().primitive.size};
     return {_document.get().data<T>().data() + _data.get().primitive.begin, _data.get().primitive.size};
 }
 
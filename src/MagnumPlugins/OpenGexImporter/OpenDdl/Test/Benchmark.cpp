@@ -0,0 +1,349 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstdio>
+#include <string>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Document.h"
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Reader.h"
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Validation.h"
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/parsers.h"
+
+namespace Magnum { namespace OpenDdl { namespace Test {
+
+struct Benchmark: TestSuite::Tester {
+    explicit Benchmark();
+
+    void whitespace();
+    void parseIndented();
+    void parseFloats();
+    void parseReferences();
+    void parseGeometry();
+    void parseGeometryParallel();
+    void parseGeometryLazy();
+    void readGeometry();
+    void deserializeGeometry();
+    void validateIndented();
+
+    private:
+        /* The documents are generated on first use, so running only some of
+           the benchmarks doesn't need to generate all of them */
+        const std::string& indentedData();
+        const std::string& floatData();
+        const std::string& referenceData();
+        const std::string& geometryData();
+        Containers::ArrayView<const char> serializedGeometryData();
+        const Document& parsedIndented();
+
+        std::string _indented, _floats, _references, _geometry;
+        Containers::Array<char> _serializedGeometry;
+        Document _indentedDocument;
+        bool _indentedDocumentParsed{};
+};
+
+namespace {
+
+enum: Int {
+    Node,
+    Transform,
+    VertexArray
+};
+
+const std::initializer_list<CharacterLiteral> structureIdentifiers{
+    "Node",
+    "Transform",
+    "VertexArray"
+};
+
+enum: Int {
+    id
+};
+
+const std::initializer_list<CharacterLiteral> propertyIdentifiers{
+    "id"
+};
+
+/* Deeply indented document with lots of comments, similar to what exporters
+   produce */
+std::string indentedDocument(const std::size_t count) {
+    std::string out;
+    for(std::size_t i = 0; i != count; ++i) {
+        const std::string indent(4*(i % 16), ' ');
+        out += indent + "// Node number " + std::to_string(i) + "\n";
+        out += indent + "Node (id = " + std::to_string(i) + ") {\n";
+        out += indent + "    /* Identity transformation,\n";
+        out += indent + "       stored explicitly */\n";
+        out += indent + "    Transform {\n";
+        out += indent + "        float[16] {\n";
+        out += indent + "            {1.0, 0.0, 0.0, 0.0,\n";
+        out += indent + "             0.0, 1.0, 0.0, 0.0,\n";
+        out += indent + "             0.0, 0.0, 1.0, 0.0,\n";
+        out += indent + "             0.0, 0.0, 0.0, 1.0}\n";
+        out += indent + "        }\n";
+        out += indent + "    }\n";
+        out += indent + "}\n\n";
+    }
+    return out;
+}
+
+/* Vertex array with values formatted the way exporters usually do */
+std::string floatDocument(const std::size_t count) {
+    std::string out = "VertexArray {\n    float[3] {\n";
+    char value[32];
+    for(std::size_t i = 0; i != count; ++i) {
+        out += i ? ",\n        {" : "        {";
+        for(std::size_t j = 0; j != 3; ++j) {
+            std::snprintf(value, sizeof(value), "%s%.6f", j ? ", " : "", (Float((i*3 + j)*7919 % 20011) - 10005.0f)/1234.5f);
+            out += value;
+        }
+        out += "}";
+    }
+    out += "\n    }\n}\n";
+    return out;
+}
+
+/* Flat scene where each node references some other node by a global name,
+   similarly to ObjectRef/MaterialRef in OpenGEX */
+std::string referenceDocument(const std::size_t count) {
+    std::string out;
+    for(std::size_t i = 0; i != count; ++i)
+        out += "Node $node" + std::to_string(i) + " { ref { $node" + std::to_string(i*7919 % count) + " } }\n";
+    return out;
+}
+
+}
+
+Benchmark::Benchmark() {
+    addBenchmarks({&Benchmark::whitespace,
+                   &Benchmark::parseIndented,
+                   &Benchmark::parseFloats,
+                   &Benchmark::parseReferences,
+                   &Benchmark::parseGeometry,
+                   &Benchmark::parseGeometryParallel,
+                   &Benchmark::parseGeometryLazy,
+                   &Benchmark::readGeometry,
+                   &Benchmark::deserializeGeometry,
+                   &Benchmark::validateIndented}, 10);
+}
+
+const std::string& Benchmark::indentedData() {
+    if(_indented.empty()) _indented = indentedDocument(10000);
+    return _indented;
+}
+
+const std::string& Benchmark::floatData() {
+    if(_floats.empty()) _floats = floatDocument(100000);
+    return _floats;
+}
+
+const std::string& Benchmark::referenceData() {
+    if(_references.empty()) _references = referenceDocument(100000);
+    return _references;
+}
+
+const std::string& Benchmark::geometryData() {
+    /* Many independent top-level vertex arrays */
+    if(_geometry.empty()) {
+        const std::string vertexArray = floatDocument(10000);
+        for(std::size_t i = 0; i != 64; ++i) _geometry += vertexArray;
+    }
+    return _geometry;
+}
+
+Containers::ArrayView<const char> Benchmark::serializedGeometryData() {
+    if(!_serializedGeometry) {
+        Document document;
+        CORRADE_INTERNAL_ASSERT_OUTPUT(document.parse({geometryData().data(), geometryData().size()}, structureIdentifiers, propertyIdentifiers));
+        _serializedGeometry = document.serialize();
+    }
+    return _serializedGeometry;
+}
+
+const Document& Benchmark::parsedIndented() {
+    if(!_indentedDocumentParsed) {
+        CORRADE_INTERNAL_ASSERT_OUTPUT(_indentedDocument.parse({indentedData().data(), indentedData().size()}, structureIdentifiers, propertyIdentifiers));
+        _indentedDocumentParsed = true;
+    }
+    return _indentedDocument;
+}
+
+void Benchmark::whitespace() {
+    const Containers::ArrayView<const char> data{indentedData().data(), indentedData().size()};
+
+    /* Skip whitespace and comments, then everything that isn't a whitespace
+       character, until the end */
+    std::size_t count = 0;
+    CORRADE_BENCHMARK(1) {
+        const char* i = data;
+        while(i != data.end()) {
+            i = Implementation::whitespace(data.suffix(i));
+            while(i != data.end() && *i > 32) ++i;
+            ++count;
+        }
+    }
+
+    CORRADE_VERIFY(count);
+}
+
+void Benchmark::parseIndented() {
+    const Containers::ArrayView<const char> data{indentedData().data(), indentedData().size()};
+
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        Document d;
+        parsed = d.parse(data, structureIdentifiers, propertyIdentifiers);
+    }
+
+    CORRADE_VERIFY(parsed);
+}
+
+void Benchmark::parseFloats() {
+    const Containers::ArrayView<const char> data{floatData().data(), floatData().size()};
+
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        Document d;
+        parsed = d.parse(data, structureIdentifiers, propertyIdentifiers);
+    }
+
+    CORRADE_VERIFY(parsed);
+}
+
+void Benchmark::parseReferences() {
+    const Containers::ArrayView<const char> data{referenceData().data(), referenceData().size()};
+
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        Document d;
+        parsed = d.parse(data, structureIdentifiers, propertyIdentifiers);
+    }
+
+    CORRADE_VERIFY(parsed);
+}
+
+void Benchmark::parseGeometry() {
+    const Containers::ArrayView<const char> data{geometryData().data(), geometryData().size()};
+
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        Document d;
+        parsed = d.parse(data, structureIdentifiers, propertyIdentifiers);
+    }
+
+    CORRADE_VERIFY(parsed);
+}
+
+void Benchmark::parseGeometryParallel() {
+    const Containers::ArrayView<const char> data{geometryData().data(), geometryData().size()};
+
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        Document d;
+        parsed = d.parse(data, structureIdentifiers, propertyIdentifiers, 0);
+    }
+
+    CORRADE_VERIFY(parsed);
+}
+
+void Benchmark::parseGeometryLazy() {
+    const Containers::ArrayView<const char> data{geometryData().data(), geometryData().size()};
+
+    /* Only the hierarchy is parsed, the vertex data are not accessed */
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        Document d;
+        d.setLazyParsingThreshold(4096);
+        parsed = d.parse(data, structureIdentifiers, propertyIdentifiers);
+    }
+
+    CORRADE_VERIFY(parsed);
+}
+
+namespace {
+
+struct FloatCounter: Reader {
+    void dataEvent(const DataEvent& event) override {
+        count += event.asArray<Float>().size();
+    }
+
+    std::size_t count{};
+};
+
+}
+
+void Benchmark::readGeometry() {
+    const Containers::ArrayView<const char> data{geometryData().data(), geometryData().size()};
+
+    /* Everything is parsed, but nothing is kept in memory */
+    FloatCounter counter;
+    bool parsed = false;
+    CORRADE_BENCHMARK(1) {
+        parsed = counter.parse(data, structureIdentifiers, propertyIdentifiers);
+    }
+
+    CORRADE_VERIFY(parsed);
+    CORRADE_VERIFY(counter.count);
+}
+
+void Benchmark::deserializeGeometry() {
+    const Containers::ArrayView<const char> data = serializedGeometryData();
+
+    bool deserialized = false;
+    CORRADE_BENCHMARK(1) {
+        Document d;
+        deserialized = d.deserialize(data, structureIdentifiers, propertyIdentifiers);
+    }
+
+    CORRADE_VERIFY(deserialized);
+}
+
+void Benchmark::validateIndented() {
+    using namespace Validation;
+
+    const Document& document = parsedIndented();
+
+    bool valid = false;
+    CORRADE_BENCHMARK(1) {
+        valid = document.validate(
+            Structures{{Node, {}}},
+            {
+                {Node,
+                    Properties{{id, PropertyType::UnsignedInt, RequiredProperty}},
+                    Structures{{Transform, {1, 1}}}},
+                {Transform,
+                    Primitives{Type::Float}, 1, 16},
+                {VertexArray,
+                    Primitives{Type::Float}, 1, 0}
+            });
+    }
+
+    CORRADE_VERIFY(valid);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::OpenDdl::Test::Benchmark)
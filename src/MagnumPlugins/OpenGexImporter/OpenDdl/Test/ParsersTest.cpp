@@ -23,6 +23,7 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <cmath>
 #include <tuple>
 #include <Corrade/TestSuite/Tester.h>
 
@@ -40,6 +41,10 @@ struct ParsersTest: TestSuite::Tester {
     void whitespace();
     void onelineComment();
     void multilineComment();
+    void structureEnd();
+    void structureEndInvalid();
+    void dataListSize();
+    void dataListSizeInvalid();
 
     void escapedCharInvalid();
     void escapedChar();
@@ -66,8 +71,14 @@ struct ParsersTest: TestSuite::Tester {
 
     void floatLiteralInvalid();
     void floatLiteral();
+    void floatLiteralRounding();
     void floatLiteralBinary();
 
+    void halfLiteralInvalid();
+    void halfLiteral();
+    void halfLiteralRounding();
+    void halfLiteralBinary();
+
     void stringLiteralInvalid();
     void stringLiteralEmpty();
     void stringLiteral();
@@ -102,6 +113,10 @@ ParsersTest::ParsersTest() {
               &ParsersTest::whitespace,
               &ParsersTest::onelineComment,
               &ParsersTest::multilineComment,
+              &ParsersTest::structureEnd,
+              &ParsersTest::structureEndInvalid,
+              &ParsersTest::dataListSize,
+              &ParsersTest::dataListSizeInvalid,
 
               &ParsersTest::escapedCharInvalid,
               &ParsersTest::escapedChar,
@@ -128,8 +143,14 @@ ParsersTest::ParsersTest() {
 
               &ParsersTest::floatLiteralInvalid,
               &ParsersTest::floatLiteral,
+              &ParsersTest::floatLiteralRounding,
               &ParsersTest::floatLiteralBinary,
 
+              &ParsersTest::halfLiteralInvalid,
+              &ParsersTest::halfLiteral,
+              &ParsersTest::halfLiteralRounding,
+              &ParsersTest::halfLiteralBinary,
+
               &ParsersTest::stringLiteralInvalid,
               &ParsersTest::stringLiteralEmpty,
               &ParsersTest::stringLiteral,
@@ -202,6 +223,15 @@ void ParsersTest::whitespace() {
     CharacterLiteral c{" \b \t \n  X"};
     auto ci = Implementation::whitespace(c);
     VERIFY_PARSED(Implementation::ParseError{}, c, ci, " \b \t \n  ");
+
+    /* Long runs of whitespace, processed in blocks on some platforms */
+    CharacterLiteral d{"\n                                 \t\t\t\t    \r\n  \tX     "};
+    auto di = Implementation::whitespace(d);
+    VERIFY_PARSED(Implementation::ParseError{}, d, di, "\n                                 \t\t\t\t    \r\n  \t");
+
+    CharacterLiteral e{"                X"};
+    auto ei = Implementation::whitespace(e);
+    VERIFY_PARSED(Implementation::ParseError{}, e, ei, "                ");
 }
 
 void ParsersTest::onelineComment() {
@@ -212,6 +242,16 @@ void ParsersTest::onelineComment() {
     CharacterLiteral b{" \b \t // comment /* other comment \n*/ \nX"};
     auto bi = Implementation::whitespace(b);
     VERIFY_PARSED(Implementation::ParseError{}, b, bi, " \b \t // comment /* other comment \n");
+
+    /* Comment until the end of data */
+    CharacterLiteral c{" // comment"};
+    auto ci = Implementation::whitespace(c);
+    VERIFY_PARSED(Implementation::ParseError{}, c, ci, " // comment");
+
+    /* Slash that's not a comment */
+    CharacterLiteral d{"  /X"};
+    auto di = Implementation::whitespace(d);
+    VERIFY_PARSED(Implementation::ParseError{}, d, di, "  ");
 }
 
 void ParsersTest::multilineComment() {
@@ -222,6 +262,74 @@ void ParsersTest::multilineComment() {
     CharacterLiteral b{" \b \t /* comment \n // bla \n comment */X"};
     auto bi = Implementation::whitespace(b);
     VERIFY_PARSED(Implementation::ParseError{}, b, bi, " \b \t /* comment \n // bla \n comment */");
+
+    CharacterLiteral c{" /** comment * / **/  /**/ X"};
+    auto ci = Implementation::whitespace(c);
+    VERIFY_PARSED(Implementation::ParseError{}, c, ci, " /** comment * / **/  /**/ ");
+
+    /* Unterminated comment spans until the end of data */
+    CharacterLiteral d{" /* comment *"};
+    auto di = Implementation::whitespace(d);
+    VERIFY_PARSED(Implementation::ParseError{}, d, di, " /* comment *");
+}
+
+void ParsersTest::structureEnd() {
+    CharacterLiteral a{"Root { int8 { 1 } } Root {}"};
+    auto ai = Implementation::structureEnd(a);
+    VERIFY_PARSED(Implementation::ParseError{}, a, ai, "Root { int8 { 1 } }");
+
+    /* Braces in comments, strings and character literals are skipped */
+    CharacterLiteral b{"Root (a = '}') { /* } */ // }\n string { \"}\\\"}\" } }X"};
+    auto bi = Implementation::structureEnd(b);
+    VERIFY_PARSED(Implementation::ParseError{}, b, bi, "Root (a = '}') { /* } */ // }\n string { \"}\\\"}\" } }");
+}
+
+void ParsersTest::structureEndInvalid() {
+    /* No structure */
+    CORRADE_VERIFY(!Implementation::structureEnd(CharacterLiteral{"Root"}));
+
+    /* Unbalanced braces */
+    CORRADE_VERIFY(!Implementation::structureEnd(CharacterLiteral{"} Root {}"}));
+    CORRADE_VERIFY(!Implementation::structureEnd(CharacterLiteral{"Root { {}"}));
+
+    /* Unterminated literal or comment */
+    CORRADE_VERIFY(!Implementation::structureEnd(CharacterLiteral{"Root { string { \"} }"}));
+    CORRADE_VERIFY(!Implementation::structureEnd(CharacterLiteral{"Root { /* } }"}));
+}
+
+void ParsersTest::dataListSize() {
+    CharacterLiteral a{"1, 2, 3 }X"};
+    auto ai = Implementation::dataListSize(a, 0);
+    VERIFY_PARSED(Implementation::ParseError{}, a, ai.first, "1, 2, 3 ");
+    CORRADE_COMPARE(ai.second, 3);
+
+    /* Empty list, comments are not counted */
+    CharacterLiteral b{"/* 1, 2 */ // 3,\n }X"};
+    auto bi = Implementation::dataListSize(b, 0);
+    VERIFY_PARSED(Implementation::ParseError{}, b, bi.first, "/* 1, 2 */ // 3,\n ");
+    CORRADE_COMPARE(bi.second, 0);
+
+    /* Separators in character literals are skipped */
+    CharacterLiteral c{"',', '\\'', '}' }X"};
+    auto ci = Implementation::dataListSize(c, 0);
+    VERIFY_PARSED(Implementation::ParseError{}, c, ci.first, "',', '\\'', '}' ");
+    CORRADE_COMPARE(ci.second, 3);
+
+    /* Subarrays are counted as a whole */
+    CharacterLiteral d{"{1, 2, 3}, {4, 5, 6} /* {} */ }X"};
+    auto di = Implementation::dataListSize(d, 3);
+    VERIFY_PARSED(Implementation::ParseError{}, d, di.first, "{1, 2, 3}, {4, 5, 6} /* {} */ ");
+    CORRADE_COMPARE(di.second, 6);
+}
+
+void ParsersTest::dataListSizeInvalid() {
+    /* No list end */
+    CORRADE_VERIFY(!Implementation::dataListSize(CharacterLiteral{"1, 2"}, 0).first);
+    CORRADE_VERIFY(!Implementation::dataListSize(CharacterLiteral{"{1, 2}, {"}, 2).first);
+
+    /* Unterminated literal or comment */
+    CORRADE_VERIFY(!Implementation::dataListSize(CharacterLiteral{"'} }"}, 0).first);
+    CORRADE_VERIFY(!Implementation::dataListSize(CharacterLiteral{"1 /* }"}, 0).first);
 }
 
 void ParsersTest::escapedCharInvalid() {
@@ -371,39 +479,45 @@ void ParsersTest::characterLiteralEscaped() {
 
 void ParsersTest::integerLiteralInvalid() {
     Implementation::ParseError error;
-    std::string buffer;
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{""}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{""}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::ExpectedLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"+"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"+"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"A"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"A"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"_1"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"_1"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"0b_1"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"0b_1"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"32768"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<Short>(CharacterLiteral{"32768"}, error)));
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedShort>(CharacterLiteral{"-1"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
 
-    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedShort>(CharacterLiteral{"-1"}, buffer, error)));
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedShort>(CharacterLiteral{"0x1_0000"}, error)));
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+
+    #ifndef MAGNUM_TARGET_WEBGL
+    CORRADE_VERIFY(!std::get<0>(Implementation::integralLiteral<UnsignedLong>(CharacterLiteral{"18446744073709551616"}, error)));
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+    #endif
 }
 
 void ParsersTest::integerLiteral() {
     CharacterLiteral a{"-3_7X"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Short value;
     Int base;
-    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, buffer, error);
+    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, error);
     VERIFY_PARSED(error, a, ai, "-3_7");
     CORRADE_COMPARE(value, -37);
     CORRADE_COMPARE(base, 10);
@@ -413,11 +527,10 @@ void ParsersTest::integerLiteralChar() {
     CharacterLiteral a{"+'a'X"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Short value;
     Int base;
-    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, buffer, error);
+    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, error);
     VERIFY_PARSED(error, a, ai, "+'a'");
     CORRADE_COMPARE(value, 'a');
     CORRADE_COMPARE(base, 256);
@@ -427,14 +540,20 @@ void ParsersTest::integerLiteralBinary() {
     CharacterLiteral a{"-0o7_5"};
 
     Implementation::ParseError error;
-    std::string buffer;
     const char* ai;
     Short value;
     Int base;
-    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, buffer, error);
+    std::tie(ai, value, base) = Implementation::integralLiteral<Short>(a, error);
     VERIFY_PARSED(error, a, ai, "-0o7_5");
     CORRADE_COMPARE(value, -075);
     CORRADE_COMPARE(base, 8);
+
+    CharacterLiteral b{"0xfF_Fe"};
+    UnsignedShort valueB;
+    std::tie(ai, valueB, base) = Implementation::integralLiteral<UnsignedShort>(b, error);
+    VERIFY_PARSED(error, b, ai, "0xfF_Fe");
+    CORRADE_COMPARE(valueB, 0xfffe);
+    CORRADE_COMPARE(base, 16);
 }
 
 void ParsersTest::floatLiteralInvalid() {
@@ -472,6 +591,29 @@ void ParsersTest::floatLiteral() {
     CORRADE_COMPARE(value, -1.0e+5);
 }
 
+void ParsersTest::floatLiteralRounding() {
+    Implementation::ParseError error;
+    std::string buffer;
+
+    /* Comparing exactly, as the results should be correctly rounded both
+       for short literals and for those that don't fit into the fast path */
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"0.1"}, buffer, error).second == 0.1f);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"-0.7071068"}, buffer, error).second == -0.7071068f);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"1.5e-3"}, buffer, error).second == 1.5e-3f);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"3.4028234e38"}, buffer, error).second == 3.4028234e38f);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"123456789012345678901.0"}, buffer, error).second == 123456789012345678901.0f);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"0.30000000000000004"}, buffer, error).second == 0.30000000000000004);
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Double>(CharacterLiteral{"9007199254740993.0"}, buffer, error).second == 9007199254740993.0);
+
+    /* Exactly halfway between two floats, should round to even */
+    CORRADE_VERIFY(Implementation::floatingPointLiteral<Float>(CharacterLiteral{"16777217.0"}, buffer, error).second == 16777216.0f);
+
+    /* Sign of zero is preserved */
+    const Float zero = Implementation::floatingPointLiteral<Float>(CharacterLiteral{"-0.0"}, buffer, error).second;
+    CORRADE_COMPARE(zero, 0.0f);
+    CORRADE_VERIFY(std::signbit(zero));
+}
+
 void ParsersTest::floatLiteralBinary() {
     CharacterLiteral a{"-0xbad_cafe_X"};
 
@@ -485,6 +627,80 @@ void ParsersTest::floatLiteralBinary() {
     CORRADE_COMPARE(value, -reinterpret_cast<Float&>(v));
 }
 
+void ParsersTest::halfLiteralInvalid() {
+    Implementation::ParseError error;
+    std::string buffer;
+
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Half>(CharacterLiteral{""}, buffer, error).first);
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::ExpectedLiteral);
+    CORRADE_COMPARE(error.type, Type::Half);
+
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Half>(CharacterLiteral{"."}, buffer, error).first);
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
+    CORRADE_COMPARE(error.type, Type::Half);
+
+    /* Binary literal not fitting into 16 bits */
+    CORRADE_VERIFY(!Implementation::floatingPointLiteral<Half>(CharacterLiteral{"0x10000"}, buffer, error).first);
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::LiteralOutOfRange);
+}
+
+void ParsersTest::halfLiteral() {
+    CharacterLiteral a{"-1_.5e+1X"};
+
+    Implementation::ParseError error;
+    std::string buffer;
+    const char* ai;
+    Half value;
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Half>(a, buffer, error);
+    VERIFY_PARSED(error, a, ai, "-1_.5e+1");
+    CORRADE_COMPARE(UnsignedShort(value), 0xcb80);
+    CORRADE_COMPARE(unpackHalf(value), -15.0f);
+}
+
+void ParsersTest::halfLiteralRounding() {
+    Implementation::ParseError error;
+    std::string buffer;
+
+    auto parse = [&buffer, &error](const CharacterLiteral& literal) {
+        return UnsignedShort(Implementation::floatingPointLiteral<Half>(literal, buffer, error).second);
+    };
+
+    /* Exactly representable */
+    CORRADE_COMPARE(parse(CharacterLiteral{"1.0009765625"}), 0x3c01);
+    CORRADE_COMPARE(parse(CharacterLiteral{"65504.0"}), 0x7bff);
+    CORRADE_COMPARE(parse(CharacterLiteral{"6.103515625e-5"}), 0x0400);
+    CORRADE_COMPARE(parse(CharacterLiteral{"5.9604644775390625e-8"}), 0x0001);
+
+    /* Exactly halfway, rounding to even */
+    CORRADE_COMPARE(parse(CharacterLiteral{"1.00048828125"}), 0x3c00);
+    CORRADE_COMPARE(parse(CharacterLiteral{"1.00146484375"}), 0x3c02);
+    CORRADE_COMPARE(parse(CharacterLiteral{"2.98023223876953125e-8"}), 0x0000);
+
+    /* Overflow to infinity, underflow to zero, sign is preserved */
+    CORRADE_COMPARE(parse(CharacterLiteral{"65520.0"}), 0x7c00);
+    CORRADE_COMPARE(parse(CharacterLiteral{"-1.0e10"}), 0xfc00);
+    CORRADE_COMPARE(parse(CharacterLiteral{"1.0e-8"}), 0x0000);
+    CORRADE_COMPARE(parse(CharacterLiteral{"-0.0"}), 0x8000);
+
+    /* Unpacking gives back the exact value */
+    CORRADE_COMPARE(unpackHalf(Half(0x3c01)), 1.0009765625f);
+    CORRADE_COMPARE(unpackHalf(Half(0x0001)), 5.9604644775390625e-8f);
+    CORRADE_COMPARE(unpackHalf(Half(0x03ff)), 6.0975551605224609375e-5f);
+    CORRADE_VERIFY(unpackHalf(Half(0x7e00)) != unpackHalf(Half(0x7e00)));
+}
+
+void ParsersTest::halfLiteralBinary() {
+    CharacterLiteral a{"-0x3c_00_X"};
+
+    Implementation::ParseError error;
+    std::string buffer;
+    const char* ai;
+    Half value;
+    std::tie(ai, value) = Implementation::floatingPointLiteral<Half>(a, buffer, error);
+    VERIFY_PARSED(error, a, ai, "-0x3c_00_");
+    CORRADE_COMPARE(UnsignedShort(value), 0xbc00);
+}
+
 void ParsersTest::stringLiteralInvalid() {
     Implementation::ParseError error;
 
@@ -496,6 +712,9 @@ void ParsersTest::stringLiteralInvalid() {
 
     CORRADE_VERIFY(!Implementation::stringLiteral(CharacterLiteral{"\"\n\""}, error).first);
     CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidLiteral);
+
+    CORRADE_VERIFY(!Implementation::stringLiteral(CharacterLiteral{"\"abc\\q\""}, error).first);
+    CORRADE_COMPARE(error.error, Implementation::ParseErrorType::InvalidEscapeSequence);
 }
 
 void ParsersTest::stringLiteralEmpty() {
@@ -623,6 +842,17 @@ void ParsersTest::typeLiteral() {
     std::tie(ai, value) = Implementation::typeLiteral(a, error);
     VERIFY_PARSED(error, a, ai, "unsigned_int16");
     CORRADE_COMPARE(value, Type::UnsignedShort);
+
+    /* Both names of the half type are accepted and not confused with float */
+    CharacterLiteral b{"float16 "};
+    std::tie(ai, value) = Implementation::typeLiteral(b, error);
+    VERIFY_PARSED(error, b, ai, "float16");
+    CORRADE_COMPARE(value, Type::Half);
+
+    CharacterLiteral c{"half}"};
+    std::tie(ai, value) = Implementation::typeLiteral(c, error);
+    VERIFY_PARSED(error, c, ai, "half");
+    CORRADE_COMPARE(value, Type::Half);
 }
 
 void ParsersTest::propertyValueInvalid() {
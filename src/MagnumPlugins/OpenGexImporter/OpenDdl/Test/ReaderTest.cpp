@@ -0,0 +1,329 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <sstream>
+#include <Corrade/TestSuite/Tester.h>
+
+#include "MagnumPlugins/OpenGexImporter/OpenDdl/Reader.h"
+
+namespace Magnum { namespace OpenDdl { namespace Test {
+
+struct ReaderTest: TestSuite::Tester {
+    explicit ReaderTest();
+
+    void primitive();
+    void primitiveEmpty();
+    void primitiveSubArray();
+    void custom();
+    void customProperties();
+    void hierarchy();
+    void chunks();
+    void chunksSubArray();
+    void chunksSubArrayLargerThanChunk();
+    void error();
+};
+
+ReaderTest::ReaderTest() {
+    addTests({&ReaderTest::primitive,
+              &ReaderTest::primitiveEmpty,
+              &ReaderTest::primitiveSubArray,
+              &ReaderTest::custom,
+              &ReaderTest::customProperties,
+              &ReaderTest::hierarchy,
+              &ReaderTest::chunks,
+              &ReaderTest::chunksSubArray,
+              &ReaderTest::chunksSubArrayLargerThanChunk,
+              &ReaderTest::error});
+}
+
+namespace {
+
+enum: Int {
+    SomeStructure,
+    RootStructure
+};
+
+const std::initializer_list<CharacterLiteral> structureIdentifiers {
+    "Some",
+    "Root"
+};
+
+enum: Int {
+    SomeProperty,
+    BooleanProperty
+};
+
+const std::initializer_list<CharacterLiteral> propertyIdentifiers {
+    "some",
+    "boolean"
+};
+
+const char* typeName(const Type type) {
+    switch(type) {
+        case Type::Bool: return "bool";
+        case Type::UnsignedByte: return "unsigned_int8";
+        case Type::Int: return "int32";
+        case Type::Float: return "float";
+        case Type::String: return "string";
+        case Type::Reference: return "ref";
+        case Type::Type: return "type";
+        default: return "?";
+    }
+}
+
+/* Records all events in a textual form */
+struct Recorder: Reader {
+    std::ostringstream out;
+
+    /* Properties and data are indented one level more than the structure
+       they belong to */
+    std::string indent() const { return std::string((depth + 1)*2, ' '); }
+
+    void structureBeginEvent(const StructureEvent& event) override {
+        depth = event.depth();
+        out << std::string(event.depth()*2, ' ');
+        if(event.isCustom())
+            out << "begin " << event.identifier();
+        else
+            out << "begin " << typeName(event.type()) << "[" << event.subArraySize() << "]";
+        if(event.hasName()) out << " " << event.name();
+        out << "\n";
+    }
+
+    void structureEndEvent(const StructureEvent& event) override {
+        out << std::string(event.depth()*2, ' ') << "end";
+        if(!event.isCustom()) out << " size " << event.arraySize();
+        out << "\n";
+    }
+
+    void propertyEvent(const PropertyEvent& event) override {
+        out << indent() << "property " << event.identifier() << "=";
+        if(event.isTypeCompatibleWith(PropertyType::Bool))
+            out << event.as<bool>();
+        else if(event.isTypeCompatibleWith(PropertyType::Int))
+            out << event.as<Int>();
+        else if(event.isTypeCompatibleWith(PropertyType::Float))
+            out << event.as<Float>();
+        else if(event.isTypeCompatibleWith(PropertyType::String))
+            out << event.as<std::string>();
+        else if(event.isTypeCompatibleWith(PropertyType::Reference))
+            out << "->" << std::string{event.asReference(), event.asReference().size()};
+        else if(event.isTypeCompatibleWith(PropertyType::Type))
+            out << typeName(event.as<Type>());
+        out << "\n";
+    }
+
+    void dataEvent(const DataEvent& event) override {
+        out << indent() << "data " << event.offset() << "+" << event.size() << " {";
+        switch(event.type()) {
+            case Type::Bool:
+                for(bool b: event.asArray<bool>()) out << b << ",";
+                break;
+            case Type::UnsignedByte:
+                for(UnsignedByte i: event.asArray<UnsignedByte>()) out << UnsignedInt(i) << ",";
+                break;
+            case Type::Int:
+                for(Int i: event.asArray<Int>()) out << i << ",";
+                break;
+            case Type::Float:
+                for(Float f: event.asArray<Float>()) out << f << ",";
+                break;
+            case Type::String:
+                for(const std::string& string: event.asArray<std::string>()) out << string << ",";
+                break;
+            case Type::Reference:
+                for(Containers::ArrayView<const char> reference: event.asReferenceArray())
+                    out << "->" << std::string{reference, reference.size()} << ",";
+                break;
+            case Type::Type:
+                for(Type type: event.asArray<Type>()) out << typeName(type) << ",";
+                break;
+            default:
+                out << "...";
+        }
+        out << "}\n";
+    }
+
+    std::size_t depth{};
+};
+
+}
+
+void ReaderTest::primitive() {
+    Recorder r;
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"int32 %name { 35, -'\\x0c', 45 } float { 0.5 }"}, {}, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin int32[0] %name\n"
+        "  data 0+3 {35,-12,45,}\n"
+        "end size 3\n"
+        "begin float[0]\n"
+        "  data 0+1 {0.5,}\n"
+        "end size 1\n");
+}
+
+void ReaderTest::primitiveEmpty() {
+    Recorder r;
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"float {} string { }"}, {}, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin float[0]\n"
+        "end size 0\n"
+        "begin string[0]\n"
+        "end size 0\n");
+}
+
+void ReaderTest::primitiveSubArray() {
+    Recorder r;
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"unsigned_int8[2] { {1, 2}, {3, 4} } string { \"hello\", \"world\" } type { float, ref }"}, {}, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin unsigned_int8[2]\n"
+        "  data 0+4 {1,2,3,4,}\n"
+        "end size 4\n"
+        "begin string[0]\n"
+        "  data 0+2 {hello,world,}\n"
+        "end size 2\n"
+        "begin type[0]\n"
+        "  data 0+2 {float,ref,}\n"
+        "end size 2\n");
+}
+
+void ReaderTest::custom() {
+    Recorder r;
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"Root %root { bool { true, false } } Unknown {}"}, structureIdentifiers, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin 1 %root\n"
+        "  begin bool[0]\n"
+        "    data 0+2 {1,0,}\n"
+        "  end size 2\n"
+        "end\n"
+        "begin " + std::to_string(UnknownIdentifier) + "\n"
+        "end\n");
+}
+
+void ReaderTest::customProperties() {
+    Recorder r;
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"Some (some = 15, boolean = true, some = 0.5, some = \"hi\", some = %a%b, some = null, some = float) { ref { $a, null } }"}, structureIdentifiers, propertyIdentifiers));
+    CORRADE_COMPARE(r.out.str(),
+        "begin 0\n"
+        "  property 0=15\n"
+        "  property 1=1\n"
+        "  property 0=0.5\n"
+        "  property 0=hi\n"
+        "  property 0=->%a%b\n"
+        "  property 0=->\n"
+        "  property 0=float\n"
+        "  begin ref[0]\n"
+        "    data 0+2 {->$a,->,}\n"
+        "  end size 2\n"
+        "end\n");
+}
+
+void ReaderTest::hierarchy() {
+    Recorder r;
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"Root { Some { Some { int32 { 1 } } } float {} } Root {}"}, structureIdentifiers, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin 1\n"
+        "  begin 0\n"
+        "    begin 0\n"
+        "      begin int32[0]\n"
+        "        data 0+1 {1,}\n"
+        "      end size 1\n"
+        "    end\n"
+        "  end\n"
+        "  begin float[0]\n"
+        "  end size 0\n"
+        "end\n"
+        "begin 1\n"
+        "end\n");
+}
+
+void ReaderTest::chunks() {
+    Recorder r;
+    r.setChunkSize(4);
+    CORRADE_COMPARE(r.chunkSize(), 4);
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"int32 { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 } int32 { 0, 1, 2, 3 }"}, {}, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin int32[0]\n"
+        "  data 0+4 {0,1,2,3,}\n"
+        "  data 4+4 {4,5,6,7,}\n"
+        "  data 8+2 {8,9,}\n"
+        "end size 10\n"
+        "begin int32[0]\n"
+        "  data 0+4 {0,1,2,3,}\n"
+        "end size 4\n");
+}
+
+void ReaderTest::chunksSubArray() {
+    Recorder r;
+    r.setChunkSize(4);
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"int32[3] { {0, 1, 2}, {3, 4, 5}, {6, 7, 8} }"}, {}, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin int32[3]\n"
+        "  data 0+3 {0,1,2,}\n"
+        "  data 3+3 {3,4,5,}\n"
+        "  data 6+3 {6,7,8,}\n"
+        "end size 9\n");
+}
+
+void ReaderTest::chunksSubArrayLargerThanChunk() {
+    Recorder r;
+    r.setChunkSize(2);
+    CORRADE_VERIFY(r.parse(CharacterLiteral{"string[3] { {\"a\", \"b\", \"c\"}, {\"d\", \"e\", \"f\"} }"}, {}, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin string[3]\n"
+        "  data 0+3 {a,b,c,}\n"
+        "  data 3+3 {d,e,f,}\n"
+        "end size 6\n");
+}
+
+void ReaderTest::error() {
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(Root {
+    int32 { 1, 2 }
+    float { 1.5, 2.5 3.5 }
+})oddl"};
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Everything before the error is reported */
+    Recorder r;
+    r.setChunkSize(1);
+    CORRADE_VERIFY(!r.parse(s, structureIdentifiers, {}));
+    CORRADE_COMPARE(r.out.str(),
+        "begin 1\n"
+        "  begin int32[0]\n"
+        "    data 0+1 {1,}\n"
+        "    data 1+1 {2,}\n"
+        "  end size 2\n"
+        "  begin float[0]\n"
+        "    data 0+1 {1.5,}\n"
+        "    data 1+1 {2.5,}\n");
+    CORRADE_COMPARE(out.str(), "OpenDdl::Reader::parse(): expected , character on line 3\n");
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::OpenDdl::Test::ReaderTest)
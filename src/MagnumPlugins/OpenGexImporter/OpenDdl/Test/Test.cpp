@@ -23,7 +23,10 @@
     DEALINGS IN THE SOFTWARE.
 */
 
+#include <algorithm>
+#include <limits>
 #include <sstream>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Container.h>
 
@@ -38,6 +41,7 @@ struct Test: TestSuite::Tester {
     explicit Test();
 
     void primitive();
+    void primitiveHalf();
     void primitiveEmpty();
     void primitiveName();
     void primitiveExpectedListStart();
@@ -80,6 +84,7 @@ struct Test: TestSuite::Tester {
     void structureProperties();
 
     void structureEquality();
+    void structureIndex();
 
     void validate();
 
@@ -103,11 +108,26 @@ struct Test: TestSuite::Tester {
     void referenceInProperty();
     void referenceNull();
     void referenceChain();
+    void referenceSameName();
     void referenceInvalid();
+
+    void parseParallel();
+    void parseParallelError();
+
+    void parseLazy();
+    void parseLazyError();
+
+    void parsePresized();
+    void parsePresizedError();
+
+    void serialize();
+    void serializeEmpty();
+    void deserializeInvalid();
 };
 
 Test::Test() {
     addTests({&Test::primitive,
+              &Test::primitiveHalf,
               &Test::primitiveEmpty,
               &Test::primitiveName,
               &Test::primitiveExpectedListStart,
@@ -148,6 +168,7 @@ Test::Test() {
               &Test::structureProperties,
 
               &Test::structureEquality,
+              &Test::structureIndex,
 
               &Test::validate,
 
@@ -171,7 +192,21 @@ Test::Test() {
               &Test::referenceInProperty,
               &Test::referenceNull,
               &Test::referenceChain,
-              &Test::referenceInvalid});
+              &Test::referenceSameName,
+              &Test::referenceInvalid,
+
+              &Test::parseParallel,
+              &Test::parseParallelError,
+
+              &Test::parseLazy,
+              &Test::parseLazyError,
+
+              &Test::parsePresized,
+              &Test::parsePresizedError,
+
+              &Test::serialize,
+              &Test::serializeEmpty,
+              &Test::deserializeInvalid});
 }
 
 void Test::primitive() {
@@ -189,6 +224,34 @@ void Test::primitive() {
         TestSuite::Compare::Container);
 }
 
+void Test::primitiveHalf() {
+    Document d;
+    CORRADE_VERIFY(d.parse(CharacterLiteral{"float16 { 1.5, -0.25, 0x7c00 } half[2] { {65504.0, 1.0e-7} }"}, {}, {}));
+
+    Structure s = d.firstChild();
+    CORRADE_COMPARE(s.type(), Type::Half);
+    CORRADE_COMPARE(s.arraySize(), 3);
+    Containers::ArrayView<const Half> data = s.asArray<Half>();
+    CORRADE_COMPARE(data.size(), 3);
+    CORRADE_COMPARE(UnsignedShort(data[0]), 0x3e00);
+    CORRADE_COMPARE(UnsignedShort(data[1]), 0xb400);
+    CORRADE_COMPARE(UnsignedShort(data[2]), 0x7c00);
+    CORRADE_COMPARE(unpackHalf(data[0]), 1.5f);
+    CORRADE_COMPARE(unpackHalf(data[1]), -0.25f);
+    CORRADE_COMPARE(unpackHalf(data[2]), std::numeric_limits<Float>::infinity());
+
+    Structure s2 = *s.findNext();
+    CORRADE_COMPARE(s2.type(), Type::Half);
+    CORRADE_COMPARE(s2.subArraySize(), 2);
+    Containers::ArrayView<const Half> data2 = s2.asArray<Half>();
+    CORRADE_COMPARE(data2.size(), 2);
+    CORRADE_COMPARE(UnsignedShort(data2[0]), 0x7bff);
+    /* Denormal */
+    CORRADE_COMPARE(UnsignedShort(data2[1]), 0x0002);
+    CORRADE_COMPARE(unpackHalf(data2[0]), 65504.0f);
+    CORRADE_COMPARE(unpackHalf(data2[1]), 2.0f/16777216.0f);
+}
+
 void Test::primitiveEmpty() {
     Document d;
     CORRADE_VERIFY(d.parse(CharacterLiteral{"float {}"}, {}, {}));
@@ -779,6 +842,26 @@ Some {}
     CORRADE_VERIFY(a != b && b != a);
 }
 
+void Test::structureIndex() {
+    Document d;
+    CORRADE_COMPARE(d.structureCount(), 0);
+
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{R"oddl(
+Root { Some { int8 {} } }
+Some {}
+    )oddl"};
+    CORRADE_VERIFY(d.parse(s, structureIdentifiers, propertyIdentifiers));
+    CORRADE_COMPARE(d.structureCount(), 4);
+
+    Structure root = d.firstChildOf(RootStructure);
+    Structure some = root.firstChild();
+    CORRADE_COMPARE(root.index(), 0);
+    CORRADE_COMPARE(some.index(), 1);
+    CORRADE_COMPARE(some.firstChild().index(), 2);
+    CORRADE_COMPARE(d.firstChildOf(SomeStructure).index(), 3);
+}
+
 void Test::validate() {
     using namespace Validation;
 
@@ -1151,13 +1234,21 @@ void Test::referenceNull() {
     /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
     auto s = CharacterLiteral{
 R"oddl(
-Root (reference = null) {}
+Root %a (reference = null) {}
 Hierarchic { ref { null } }
+ref { %a, null }
     )oddl"};
     CORRADE_VERIFY(d.parse(s, structureIdentifiers, propertyIdentifiers));
 
     CORRADE_VERIFY(!d.firstChildOf(RootStructure).propertyOf(ReferenceProperty).asReference());
     CORRADE_VERIFY(!d.firstChildOf(HierarchicStructure).firstChild().asReference());
+
+    /* Reference to the first structure is not null */
+    Containers::Array<Containers::Optional<Structure>> array = d.firstChildOf(Type::Reference).asReferenceArray();
+    CORRADE_COMPARE(array.size(), 2);
+    CORRADE_VERIFY(array[0]);
+    CORRADE_COMPARE(array[0]->name(), "%a");
+    CORRADE_VERIFY(!array[1]);
 }
 
 void Test::referenceChain() {
@@ -1240,6 +1331,43 @@ bool %local4 {}
     CORRADE_COMPARE(local[2]->type(), Type::Int);
 }
 
+void Test::referenceSameName() {
+    Document d;
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(
+Root {
+    int8 %a {}
+    ref { %a }
+    Root {
+        int16 %a {}
+    }
+}
+int32 %a {}
+Hierarchic {
+    ref { %a }
+}
+ref { %a }
+    )oddl"};
+    CORRADE_VERIFY(d.parse(s, structureIdentifiers, propertyIdentifiers));
+
+    /* Single name, takes the sibling even though there are others with the
+       same name */
+    Containers::Optional<Structure> a1 = d.firstChildOf(RootStructure).firstChildOf(Type::Reference).asReference();
+    CORRADE_VERIFY(a1);
+    CORRADE_COMPARE(a1->type(), Type::Byte);
+
+    /* No sibling, takes the first one in the document */
+    Containers::Optional<Structure> a2 = d.firstChildOf(HierarchicStructure).firstChild().asReference();
+    CORRADE_VERIFY(a2);
+    CORRADE_COMPARE(a2->type(), Type::Byte);
+
+    /* Top-level sibling */
+    Containers::Optional<Structure> a3 = d.firstChildOf(Type::Reference).asReference();
+    CORRADE_VERIFY(a3);
+    CORRADE_COMPARE(a3->type(), Type::Int);
+}
+
 void Test::referenceInvalid() {
     Document d;
     std::ostringstream out;
@@ -1272,6 +1400,379 @@ Root %root {
         "OpenDdl::Document::parse(): reference %local1%local2 was not found\n");
 }
 
+namespace {
+
+/* Prints everything that's stored in given structure list, together with
+   structure indices so misplaced references and child links show up */
+void dump(std::ostringstream& out, Containers::Optional<Structure> s) {
+    for(; s; s = s->findNext()) {
+        out << s->index() << " " << s->name() << " ";
+
+        if(s->isCustom()) {
+            out << s->identifier() << " (";
+            for(const Property p: s->properties()) {
+                out << p.identifier() << "=";
+                if(p.isTypeCompatibleWith(PropertyType::Bool))
+                    out << p.as<bool>();
+                else if(p.isTypeCompatibleWith(PropertyType::Int))
+                    out << p.as<Int>();
+                else if(p.isTypeCompatibleWith(PropertyType::Float))
+                    out << p.as<Float>();
+                else if(p.isTypeCompatibleWith(PropertyType::String))
+                    out << p.as<std::string>();
+                else if(p.isTypeCompatibleWith(PropertyType::Reference)) {
+                    Containers::Optional<Structure> reference = p.asReference();
+                    out << "->" << (reference ? reference->index() : 0);
+                }
+                out << ",";
+            }
+            out << ") {\n";
+            dump(out, s->findFirstChild());
+            out << "}\n";
+            continue;
+        }
+
+        out << UnsignedInt(s->type()) << " {";
+        switch(s->type()) {
+            case Type::Int:
+                for(Int i: s->asArray<Int>()) out << i << ",";
+                break;
+            case Type::Half:
+                for(Half h: s->asArray<Half>()) out << unpackHalf(h) << ",";
+                break;
+            case Type::Float:
+                for(Float f: s->asArray<Float>()) out << f << ",";
+                break;
+            case Type::String:
+                for(const std::string& string: s->asArray<std::string>()) out << string << ",";
+                break;
+            case Type::Reference:
+                for(const Containers::Optional<Structure>& reference: s->asReferenceArray())
+                    out << (reference ? reference->index() : 0) << ",";
+                break;
+            default:
+                out << s->arraySize();
+        }
+        out << "}\n";
+    }
+}
+
+}
+
+void Test::parseParallel() {
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(
+Root %first (some = 15, boolean = true) {
+    string %a { "hello", "{" }
+    float { 1.5, 2.5 }
+}
+// Braces in comments { and strings are skipped by the splitter
+Hierarchic (reference = %second) {
+    ref { %a, null, $global }
+    Root { int32 { 3, 4, 5 } }
+}
+/* } */
+Root %second (some = "}'") {
+    Some $global { bool { true } }
+}
+Hierarchic (reference = %first%a, some = '{') {
+    ref { %second, %first }
+}
+int32 %a { 6 }
+Root { Some {} Root { float { 7.5 } } }
+Some (some = float) { string { "\"}" } }
+Root %last (boolean = false) { ref { %a } }
+    )oddl"};
+
+    Document sequential;
+    CORRADE_VERIFY(sequential.parse(s, structureIdentifiers, propertyIdentifiers));
+    std::ostringstream expected;
+    dump(expected, sequential.findFirstChild());
+
+    for(UnsignedInt threadCount: {2, 3, 4, 16, 0}) {
+        Document parallel;
+        CORRADE_VERIFY(parallel.parse(s, structureIdentifiers, propertyIdentifiers, threadCount));
+        CORRADE_COMPARE(parallel.structureCount(), sequential.structureCount());
+
+        std::ostringstream actual;
+        dump(actual, parallel.findFirstChild());
+        CORRADE_COMPARE(actual.str(), expected.str());
+    }
+}
+
+void Test::parseParallelError() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* Error in the last top-level structure, the diagnostic should be the
+       same as when parsing sequentially */
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s1 = CharacterLiteral{
+R"oddl(
+Root { int32 { 1, 2, 3 } }
+Root { int32 { 4, 5, 6 } }
+Root { int32 { 7, 8, 9 } }
+Root { int32 { 10 11 } }
+    )oddl"};
+    CORRADE_VERIFY(!Document{}.parse(s1, structureIdentifiers, propertyIdentifiers, 4));
+
+    /* Unterminated structure, can't be split */
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s2 = CharacterLiteral{
+R"oddl(
+Root { int32 { 1, 2, 3 } }
+Root { int32 { 4, 5, 6 }
+    )oddl"};
+    CORRADE_VERIFY(!Document{}.parse(s2, structureIdentifiers, propertyIdentifiers, 4));
+
+    /* Reference into another chunk that doesn't exist */
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s3 = CharacterLiteral{
+R"oddl(
+Root %a { int32 { 1, 2, 3 } }
+Root { ref { %a } }
+Root { ref { %b } }
+    )oddl"};
+    CORRADE_VERIFY(!Document{}.parse(s3, structureIdentifiers, propertyIdentifiers, 4));
+
+    CORRADE_COMPARE(out.str(),
+        "OpenDdl::Document::parse(): expected , character on line 5\n"
+        "OpenDdl::Document::parse(): expected } character on line 4\n"
+        "OpenDdl::Document::parse(): reference %b was not found\n");
+}
+
+void Test::parseLazy() {
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(
+Root %first (some = 15) {
+    float %positions { 1.5, 2.5, 3.5, /* , */ 4.5, 5.5, 6.5 }
+    unsigned_int8[3] { {1, 2, 3}, {4, 5, 6}, {7, 8, 9} }
+    int32 { 'a', ',', '}', 42 }
+    string { "a long string that is never parsed lazily" }
+}
+Hierarchic (reference = %first%positions) {
+    ref { %first }
+    double[2] { {0.25, 0.5}, {0.75, 1.0} }
+    int16 { 1 }
+}
+Root { float { /* just a long comment, no values */ } }
+    )oddl"};
+
+    Document parsed;
+    CORRADE_VERIFY(parsed.parse(s, structureIdentifiers, propertyIdentifiers));
+    std::ostringstream expected;
+    dump(expected, parsed.findFirstChild());
+
+    for(UnsignedInt threadCount: {1, 2}) {
+        Document lazy;
+        lazy.setLazyParsingThreshold(16);
+        CORRADE_VERIFY(lazy.parse(s, structureIdentifiers, propertyIdentifiers, threadCount));
+        CORRADE_COMPARE(lazy.structureCount(), parsed.structureCount());
+
+        /* The size is known before the data are parsed */
+        const Structure positions = lazy.firstChild().firstChild();
+        CORRADE_COMPARE(positions.arraySize(), 6);
+        CORRADE_VERIFY(positions.parseData());
+        CORRADE_COMPARE(positions.asArray<Float>()[3], 4.5f);
+
+        std::ostringstream actual;
+        dump(actual, lazy.findFirstChild());
+        CORRADE_COMPARE(actual.str(), expected.str());
+    }
+}
+
+void Test::parseLazyError() {
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(
+float { 1.5, 2.5,
+    3.5, 4.5 5.5 }
+int32[2] { {1, 2}, {3, 4, 5} }
+float { 7.5 }
+    )oddl"};
+
+    Document d;
+    d.setLazyParsingThreshold(8);
+    CORRADE_VERIFY(d.parse(s, structureIdentifiers, propertyIdentifiers));
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* The data are filled with zeros on error, the error is printed only once */
+    const Structure a = d.firstChild();
+    CORRADE_COMPARE(a.arraySize(), 4);
+    CORRADE_VERIFY(!a.parseData());
+    CORRADE_COMPARE(a.asArray<Float>()[0], 0.0f);
+    CORRADE_VERIFY(!a.parseData());
+
+    const Structure b = *a.findNext();
+    CORRADE_COMPARE(b.arraySize(), 4);
+    CORRADE_COMPARE(b.asArray<Int>()[0], 0);
+
+    /* Short lists are parsed immediately */
+    const Structure c = *b.findNext();
+    CORRADE_VERIFY(c.parseData());
+    CORRADE_COMPARE(c.as<Float>(), 7.5f);
+
+    CORRADE_COMPARE(out.str(),
+        "OpenDdl::Structure::parseData(): expected , character on line 3\n"
+        "OpenDdl::Structure::parseData(): expected } character on line 4\n");
+}
+
+void Test::parsePresized() {
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(
+Root %first (some = 15, boolean = true) {
+    float %positions { 1.5, 2.5, 3.5, /* , */ 4.5, 5.5, 6.5 }
+    unsigned_int8[3] { {1, 2, 3}, {4, 5, 6}, {7, 8, 9} }
+    string %a { "hello", "{", "\"}" }
+    type { float, int32 }
+}
+Hierarchic (reference = %first%positions, some = "}'") {
+    ref { %first, null }
+    double[2] { {0.25, 0.5}, {0.75, 1.0} }
+    Root { int16 { 1 } bool { true, false } }
+}
+Root %second { float { /* just a long comment, no values */ } }
+    )oddl"};
+
+    Document parsed;
+    CORRADE_VERIFY(parsed.parse(s, structureIdentifiers, propertyIdentifiers));
+    std::ostringstream expected;
+    dump(expected, parsed.findFirstChild());
+
+    for(UnsignedInt threadCount: {1, 2}) {
+        Document presized;
+        presized.setPresizeStorage(true);
+        CORRADE_VERIFY(presized.parse(s, structureIdentifiers, propertyIdentifiers, threadCount));
+        CORRADE_COMPARE(presized.structureCount(), parsed.structureCount());
+
+        std::ostringstream actual;
+        dump(actual, presized.findFirstChild());
+        CORRADE_COMPARE(actual.str(), expected.str());
+    }
+}
+
+void Test::parsePresizedError() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    /* The pre-scan gives up on invalid data, the diagnostic should be the
+       same as without it */
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(
+Root { int32 { 1, 2, 3 } }
+Root { int32 { 4, 5 6 } }
+    )oddl"};
+    Document d;
+    d.setPresizeStorage(true);
+    CORRADE_VERIFY(!d.parse(s, structureIdentifiers, propertyIdentifiers));
+
+    CORRADE_COMPARE(out.str(),
+        "OpenDdl::Document::parse(): expected , character on line 3\n");
+}
+
+void Test::serialize() {
+    /* GCC < 4.9 cannot handle multiline raw string literals inside macros */
+    auto s = CharacterLiteral{
+R"oddl(
+Root %first (some = 15, boolean = true) {
+    string %a { "hello", "" }
+    float[2] { {1.5, 2.5}, {3.5, 4.5} }
+}
+Hierarchic (reference = %second, some = 'c') {
+    ref { %a, null, $global }
+    Root { int32 { 3, 4, 5 } unsigned_int8 { 6 } double { 7.5 } }
+    half { 0.5, -16.0 }
+}
+Root %second (some = "text") {
+    Some $global (some = float) { bool { true, false } type { int16 } }
+    Unknown (unknown = 0x1f) { unsigned_int16 { 8 } }
+}
+Root %last (boolean = false, reference = null) { ref { %a } }
+    )oddl"};
+
+    Document parsed;
+    CORRADE_VERIFY(parsed.parse(s, structureIdentifiers, propertyIdentifiers));
+    std::ostringstream expected;
+    dump(expected, parsed.findFirstChild());
+
+    const Containers::Array<char> data = parsed.serialize();
+    CORRADE_COMPARE(data.size() % 8, 0);
+
+    Document deserialized;
+    CORRADE_VERIFY(deserialized.deserialize(data, structureIdentifiers, propertyIdentifiers));
+    CORRADE_COMPARE(deserialized.structureCount(), parsed.structureCount());
+
+    std::ostringstream actual;
+    dump(actual, deserialized.findFirstChild());
+    CORRADE_COMPARE(actual.str(), expected.str());
+
+    /* Serializing again gives the same data */
+    const Containers::Array<char> data2 = deserialized.serialize();
+    CORRADE_COMPARE(std::string(data2, data2.size()), std::string(data, data.size()));
+}
+
+void Test::serializeEmpty() {
+    Document parsed;
+    CORRADE_VERIFY(parsed.parse(CharacterLiteral{"// nothing\n"}, structureIdentifiers, propertyIdentifiers));
+
+    Document deserialized;
+    CORRADE_VERIFY(deserialized.deserialize(parsed.serialize(), structureIdentifiers, propertyIdentifiers));
+    CORRADE_VERIFY(deserialized.isEmpty());
+}
+
+void Test::deserializeInvalid() {
+    Document parsed;
+    CORRADE_VERIFY(parsed.parse(CharacterLiteral{"int32 { 1 }"}, structureIdentifiers, propertyIdentifiers));
+    const Containers::Array<char> data = parsed.serialize();
+
+    /* The single structure is stored just before the eight-byte string size
+       array, as seven 64-bit values: name, type, subarray size, data begin,
+       data size, parent and next */
+    const std::size_t structureOffset = data.size() - 8 - 7*8;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    CORRADE_VERIFY(!Document{}.deserialize(data.prefix(16), structureIdentifiers, propertyIdentifiers));
+    CORRADE_VERIFY(!Document{}.deserialize(data.prefix(data.size() - 8), structureIdentifiers, propertyIdentifiers));
+    CORRADE_VERIFY(!Document{}.deserialize(data, structureIdentifiers, {"some", "boolean"}));
+
+    {
+        std::string corrupted{data, data.size()};
+        corrupted[0] = 'X';
+        CORRADE_VERIFY(!Document{}.deserialize({corrupted.data(), corrupted.size()}, structureIdentifiers, propertyIdentifiers));
+    } {
+        std::string corrupted{data, data.size()};
+        corrupted[8] = 'X';
+        CORRADE_VERIFY(!Document{}.deserialize({corrupted.data(), corrupted.size()}, structureIdentifiers, propertyIdentifiers));
+    } {
+        /* Data range out of bounds */
+        std::string corrupted{data, data.size()};
+        corrupted[structureOffset + 3*8] = 1;
+        CORRADE_VERIFY(!Document{}.deserialize({corrupted.data(), corrupted.size()}, structureIdentifiers, propertyIdentifiers));
+    } {
+        /* Structure is its own parent */
+        std::string corrupted{data, data.size()};
+        std::fill_n(&corrupted[structureOffset + 5*8], 8, '\0');
+        CORRADE_VERIFY(!Document{}.deserialize({corrupted.data(), corrupted.size()}, structureIdentifiers, propertyIdentifiers));
+    }
+
+    CORRADE_COMPARE(out.str(),
+        "OpenDdl::Document::deserialize(): expected at least 176 bytes, got 16\n"
+        "OpenDdl::Document::deserialize(): size mismatch, got 240 bytes\n"
+        "OpenDdl::Document::deserialize(): the data were created with different identifier lists\n"
+        "OpenDdl::Document::deserialize(): invalid signature\n"
+        "OpenDdl::Document::deserialize(): unsupported version 88\n"
+        "OpenDdl::Document::deserialize(): invalid structure data\n"
+        "OpenDdl::Document::deserialize(): invalid structure data\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::OpenDdl::Test::Test)
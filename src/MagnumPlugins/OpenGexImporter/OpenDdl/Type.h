@@ -26,11 +26,13 @@
 */
 
 /** @file
- * @brief Enum @ref Magnum::OpenDdl::Type, @ref Magnum::OpenDdl::PropertyType, constant @ref Magnum::OpenDdl::UnknownIdentifier
+ * @brief Enum @ref Magnum::OpenDdl::Type, @ref Magnum::OpenDdl::PropertyType, @ref Magnum::OpenDdl::Half, function @ref Magnum::OpenDdl::unpackHalf(), constant @ref Magnum::OpenDdl::UnknownIdentifier
  */
 
 #include <Magnum/Magnum.h>
 
+#include "MagnumPlugins/OpenGexImporter/visibility.h"
+
 namespace Magnum { namespace OpenDdl {
 
 /**
@@ -84,7 +86,11 @@ enum class Type: UnsignedInt {
     Long,
     #endif
 
-    /** @todo Half */
+    /**
+     * Half (16 bit). Stored in @ref OpenDdl::Half "Half" type, use
+     * @ref unpackHalf() to convert it to a @ref Magnum::Float "Float".
+     */
+    Half,
 
     /** Float (32 bit). Stored in @ref Magnum::Float "Float" type. */
     Float,
@@ -152,7 +158,8 @@ enum class PropertyType: UnsignedByte {
     Long,
     #endif
 
-    /** @todo Half */
+    /** Half (16 bit). Stored as if it is @ref PropertyType::Float. */
+    Half,
 
     /** Float (32 bit). Stored in @ref Magnum::Float "Float" type. */
     Float,
@@ -173,6 +180,23 @@ enum class PropertyType: UnsignedByte {
 /** @debugoperatorenum{PropertyType} */
 Debug& operator<<(Debug& debug, PropertyType value);
 
+/**
+@brief Half-precision floating-point value
+
+Raw bits of an IEEE 754 `binary16` value as stored in @ref Type::Half data
+lists. The data are kept in this compact form, use @ref unpackHalf() to convert
+them to a @ref Magnum::Float "Float".
+*/
+enum class Half: UnsignedShort {};
+
+/**
+@brief Unpack a half-precision floating-point value
+
+Infinities, NaNs and denormals are converted to their single-precision
+equivalents.
+*/
+MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT Float unpackHalf(Half value);
+
 enum: Int {
     /**
      * @brief Unknown identifier
@@ -25,6 +25,8 @@
 
 #include "parsers.h"
 
+#include <cfloat>
+#include <cstdint>
 #include <cstring>
 #include <limits>
 #include <tuple>
@@ -32,8 +34,20 @@
 
 #include "MagnumPlugins/OpenGexImporter/OpenDdl/Type.h"
 
-#ifdef CORRADE_TARGET_APPLE
 #include <climits>
+
+/* Whitespace runs are skipped 16 bytes at a time where the instructions are
+   available, otherwise (and for the remaining tail) byte-by-byte. AVX2 would
+   need either a different baseline or runtime dispatch, so it's not used. */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MAGNUM_OPENDDL_USE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define MAGNUM_OPENDDL_USE_NEON
+#include <arm_neon.h>
+#endif
+#if defined(MAGNUM_OPENDDL_USE_SSE2) && defined(_MSC_VER)
+#include <intrin.h>
 #endif
 
 namespace Magnum { namespace OpenDdl { namespace Implementation {
@@ -122,6 +136,153 @@ void extractWithoutUnderscore(const Containers::ArrayView<const char> data, std:
     for(char c: data) if(c != '_') buffer += c;
 }
 
+#ifdef MAGNUM_OPENDDL_USE_SSE2
+inline UnsignedInt firstSetBit(const UnsignedInt mask) {
+    #ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return index;
+    #else
+    return __builtin_ctz(mask);
+    #endif
+}
+
+inline UnsignedInt bitCount(UnsignedInt mask) {
+    #ifdef _MSC_VER
+    /* __popcnt() needs the POPCNT instruction, which is not implied by SSE2 */
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    return (((mask + (mask >> 4)) & 0x0f0f0f0fu)*0x01010101u) >> 24;
+    #else
+    return __builtin_popcount(mask);
+    #endif
+}
+#elif defined(MAGNUM_OPENDDL_USE_NEON)
+inline UnsignedInt firstSetBit(const std::uint64_t mask) {
+    return __builtin_ctzll(mask);
+}
+
+inline UnsignedInt bitCount(const std::uint64_t mask) {
+    return __builtin_popcountll(mask);
+}
+#endif
+
+/* Skips characters that are considered whitespace (i.e., <= 32 in the
+   platform-specific signedness of char, same as the scalar loop at the end) */
+inline const char* blank(const char* i, const char* const end) {
+    #ifdef MAGNUM_OPENDDL_USE_SSE2
+    for(; end - i >= 16; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+        #if CHAR_MIN < 0
+        const __m128i nonblank = _mm_cmpgt_epi8(chunk, _mm_set1_epi8(32));
+        #else
+        const __m128i nonblank = _mm_cmpeq_epi8(_mm_max_epu8(chunk, _mm_set1_epi8(33)), chunk);
+        #endif
+        if(const UnsignedInt mask = _mm_movemask_epi8(nonblank))
+            return i + firstSetBit(mask);
+    }
+    #elif defined(MAGNUM_OPENDDL_USE_NEON)
+    for(; end - i >= 16; i += 16) {
+        #if CHAR_MIN < 0
+        const uint8x16_t nonblank = vcgtq_s8(vld1q_s8(reinterpret_cast<const int8_t*>(i)), vdupq_n_s8(32));
+        #else
+        const uint8x16_t nonblank = vcgtq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(i)), vdupq_n_u8(32));
+        #endif
+        /* There's no movemask on NEON, narrow each byte to four bits
+           instead */
+        const std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(nonblank), 4)), 0);
+        if(mask) return i + firstSetBit(mask)/4;
+    }
+    #endif
+
+    while(i != end && *i <= 32) ++i;
+    return i;
+}
+
+constexpr bool isStructural(const char c) {
+    return c == '{' || c == '}' || c == '"' || c == '\'' || c == '/';
+}
+
+/* Skips characters that can't affect structure nesting, i.e. everything
+   except braces, string and character literal delimiters and comment
+   starts */
+inline const char* nonStructural(const char* i, const char* const end) {
+    #ifdef MAGNUM_OPENDDL_USE_SSE2
+    for(; end - i >= 16; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+        const __m128i structural = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('{')),
+                         _mm_cmpeq_epi8(chunk, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+                                      _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\''))),
+                         _mm_cmpeq_epi8(chunk, _mm_set1_epi8('/'))));
+        if(const UnsignedInt mask = _mm_movemask_epi8(structural))
+            return i + firstSetBit(mask);
+    }
+    #elif defined(MAGNUM_OPENDDL_USE_NEON)
+    for(; end - i >= 16; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(i));
+        const uint8x16_t structural = vorrq_u8(
+            vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('{')),
+                     vceqq_u8(chunk, vdupq_n_u8('}'))),
+            vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('"')),
+                              vceqq_u8(chunk, vdupq_n_u8('\''))),
+                     vceqq_u8(chunk, vdupq_n_u8('/'))));
+        const std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(structural), 4)), 0);
+        if(mask) return i + firstSetBit(mask)/4;
+    }
+    #endif
+
+    while(i != end && !isStructural(*i)) ++i;
+    return i;
+}
+
+/* Same as nonStructural(), but counts list separators in the skipped
+   characters */
+inline const char* nonStructural(const char* i, const char* const end, std::size_t& separators) {
+    #ifdef MAGNUM_OPENDDL_USE_SSE2
+    for(; end - i >= 16; i += 16) {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(i));
+        const __m128i structural = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('{')),
+                         _mm_cmpeq_epi8(chunk, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('"')),
+                                      _mm_cmpeq_epi8(chunk, _mm_set1_epi8('\''))),
+                         _mm_cmpeq_epi8(chunk, _mm_set1_epi8('/'))));
+        const UnsignedInt separatorMask = _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(',')));
+        if(const UnsignedInt mask = _mm_movemask_epi8(structural)) {
+            const UnsignedInt position = firstSetBit(mask);
+            separators += bitCount(separatorMask & ((1u << position) - 1));
+            return i + position;
+        }
+        separators += bitCount(separatorMask);
+    }
+    #elif defined(MAGNUM_OPENDDL_USE_NEON)
+    for(; end - i >= 16; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(i));
+        const uint8x16_t structural = vorrq_u8(
+            vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('{')),
+                     vceqq_u8(chunk, vdupq_n_u8('}'))),
+            vorrq_u8(vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('"')),
+                              vceqq_u8(chunk, vdupq_n_u8('\''))),
+                     vceqq_u8(chunk, vdupq_n_u8('/'))));
+        /* Four bits per byte, see blank() */
+        const std::uint64_t separatorMask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(vceqq_u8(chunk, vdupq_n_u8(','))), 4)), 0);
+        const std::uint64_t mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(structural), 4)), 0);
+        if(mask) {
+            const UnsignedInt position = firstSetBit(mask)/4;
+            separators += bitCount(separatorMask & ((1ull << position*4) - 1))/4;
+            return i + position;
+        }
+        separators += bitCount(separatorMask)/4;
+    }
+    #endif
+
+    for(; i != end && !isStructural(*i); ++i)
+        if(*i == ',') ++separators;
+    return i;
+}
+
 }
 
 bool equals(const Containers::ArrayView<const char> a, const Containers::ArrayView<const char> b) {
@@ -133,36 +294,120 @@ const char* whitespace(const Containers::ArrayView<const char> data) {
     if(!data) return nullptr;
 
     const char* i = data;
-    while(i != data.end()) {
+    const char* const end = data.end();
+    for(;;) {
         /* Whitespace */
-        if(*i <= 32) ++i;
-
-        /* Comment */
-        else if(*i == '/' && i + 1 < data.end() && (i[1] == '*' || i[1] == '/'))
-        {
-            /* Single-line comment */
-            if(i[1] == '/') for(const char* j = i + 2; j != data.end(); ++j) {
-                if(*j == '\n') {
-                    i = j + 1;
-                    break;
-                }
-
-            /* Multi-line comment */
-            } else for(const char* j = i + 2; j != data.end(); ++j) {
-                if(*j == '*' && j + 1 != data.end() && *(j + 1) == '/') {
-                    i = j + 2;
-                    break;
-                }
+        i = blank(i, end);
+
+        /* Something else than a comment, done */
+        if(end - i < 2 || *i != '/') break;
+
+        /* Single-line comment, if there's no newline, the comment spans to
+           the end of the data */
+        if(i[1] == '/') {
+            const char* const j = static_cast<const char*>(std::memchr(i + 2, '\n', end - i - 2));
+            if(!j) return end;
+            i = j + 1;
+
+        /* Multi-line comment, if it's not terminated, it spans to the end of
+           the data */
+        } else if(i[1] == '*') {
+            const char* j = i + 2;
+            for(;;) {
+                j = static_cast<const char*>(std::memchr(j, '*', end - j));
+                if(!j || j + 1 == end) return end;
+                if(j[1] == '/') break;
+                ++j;
             }
-        }
+            i = j + 2;
 
-        /* Something else, done */
-        else break;
+        /* Not a comment, done */
+        } else break;
     }
 
     return i;
 }
 
+const char* structureEnd(const Containers::ArrayView<const char> data) {
+    std::size_t depth = 0;
+    const char* const end = data.end();
+    for(const char* i = nonStructural(data, end); i != end; i = nonStructural(i + 1, end)) switch(*i) {
+        case '{':
+            ++depth;
+            break;
+
+        /* End of the structure once the outermost list is closed, unbalanced
+           brace is an error */
+        case '}':
+            if(!depth) return nullptr;
+            if(!--depth) return i + 1;
+            break;
+
+        /* Skip string and character literals so braces inside them are not
+           counted, unterminated literal is an error */
+        case '"':
+        case '\'': {
+            const char quote = *i;
+            for(++i; i != end && *i != quote; ++i)
+                if(*i == '\\' && i + 1 != end) ++i;
+            if(i == end) return nullptr;
+            break;
+        }
+
+        /* Skip comments, if this is not a comment, whitespace() returns the
+           same position */
+        case '/':
+            i = whitespace(data.suffix(i));
+            if(i == end) return nullptr;
+            if(*i != '/') --i;
+            break;
+    }
+
+    return nullptr;
+}
+
+std::pair<const char*, std::size_t> dataListSize(const Containers::ArrayView<const char> data, const std::size_t subArraySize) {
+    /* Count separators in the list for plain lists and nested lists for
+       arrays. The items themselves are not checked, that's done when the
+       list is actually parsed. */
+    const char* const end = data.end();
+    const char* i = whitespace(data);
+    const bool empty = i == end || *i == '}';
+    std::size_t depth = 0, separators = 0, lists = 0;
+    for(i = nonStructural(i, end, separators); i != end; i = nonStructural(i + 1, end, separators)) switch(*i) {
+        case '{':
+            if(!depth++) ++lists;
+            break;
+
+        /* End of the list once the outermost list is closed */
+        case '}':
+            if(!depth) return {i, subArraySize ? lists*subArraySize : (empty ? 0 : separators + 1)};
+            --depth;
+            break;
+
+        /* Skip string and character literals so separators and braces inside
+           them are not counted, unterminated literal is an error */
+        case '"':
+        case '\'': {
+            const char quote = *i;
+            for(++i; i != end && *i != quote; ++i)
+                if(*i == '\\' && i + 1 != end) ++i;
+            if(i == end) return {};
+            break;
+        }
+
+        /* Skip comments, if this is not a comment, whitespace() returns the
+           same position */
+        case '/':
+            i = whitespace(data.suffix(i));
+            if(i == end) return {};
+            if(*i != '/') --i;
+            break;
+    }
+
+    return {};
+}
+
 std::pair<const char*, char> escapedChar(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Escape sequence is not standalone, thus we can't expect it anywhere */
     CORRADE_INTERNAL_ASSERT(!data.empty() && *data == '\\');
@@ -293,19 +538,11 @@ template<> struct IntegralType<Double> {
 };
 template<class T> using IntegralTypeFor = typename IntegralType<T>::Type;
 
+/* Integral literals are accumulated in the widest available type and then
+   checked against range of the target type */
 template<class> struct ExtractToType;
-/** @todo isn't there something better for extracting to unsigned int on webgl? */
 #ifndef MAGNUM_TARGET_WEBGL
-template<> struct ExtractToType<UnsignedLong> {
-    typedef UnsignedLong Type;
-    static UnsignedLong extract(const std::string& buffer, Int base) {
-        #ifndef CORRADE_TARGET_ANDROID
-        return std::stoul(buffer, nullptr, base);
-        #else
-        return std::strtoul(buffer.data(), nullptr, base);
-        #endif
-    }
-};
+template<> struct ExtractToType<UnsignedLong> { typedef UnsignedLong Type; };
 template<> struct ExtractToType<UnsignedByte>: ExtractToType<UnsignedLong> {};
 template<> struct ExtractToType<Byte>: ExtractToType<UnsignedLong> {};
 template<> struct ExtractToType<UnsignedShort>: ExtractToType<UnsignedLong> {};
@@ -318,16 +555,7 @@ template<> struct ExtractToType<unsigned long>: ExtractToType<UnsignedLong> {};
 template<> struct ExtractToType<long>: ExtractToType<UnsignedLong> {};
 #endif
 #else
-template<> struct ExtractToType<UnsignedInt> {
-    typedef UnsignedInt Type;
-    static UnsignedInt extract(const std::string& buffer, Int base) {
-        #ifndef CORRADE_TARGET_ANDROID
-        return std::stoi(buffer, nullptr, base);
-        #else
-        return std::strtol(buffer.data(), nullptr, base);
-        #endif
-    }
-};
+template<> struct ExtractToType<UnsignedInt> { typedef UnsignedInt Type; };
 template<> struct ExtractToType<UnsignedByte>: ExtractToType<UnsignedInt> {};
 template<> struct ExtractToType<Byte>: ExtractToType<UnsignedInt> {};
 template<> struct ExtractToType<UnsignedShort>: ExtractToType<UnsignedInt> {};
@@ -356,6 +584,100 @@ template<> struct ExtractToType<Double> {
     }
 };
 
+/* Powers of ten that are exactly representable in a double */
+constexpr Double PowersOfTen[]{
+    1.0e0,  1.0e1,  1.0e2,  1.0e3,  1.0e4,  1.0e5,  1.0e6,  1.0e7,
+    1.0e8,  1.0e9,  1.0e10, 1.0e11, 1.0e12, 1.0e13, 1.0e14, 1.0e15,
+    1.0e16, 1.0e17, 1.0e18, 1.0e19, 1.0e20, 1.0e21, 1.0e22
+};
+
+/* Converts an already validated unsigned decimal literal without going
+   through a string buffer. If both the significand and the power of ten are
+   exactly representable in a double, a single IEEE multiplication or
+   division gives a correctly rounded result (Clinger's fast path). Returns
+   false if the literal contains underscores or doesn't fit, the caller is
+   expected to fall back to the standard library in that case. */
+bool fastDecimalLiteral(const char* i, const char* const end, Double& out) {
+    /* With x87 extended precision the result would be rounded twice */
+    #if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD != 0 && FLT_EVAL_METHOD != 1
+    static_cast<void>(i);
+    static_cast<void>(end);
+    static_cast<void>(out);
+    return false;
+    #else
+    /* Significand, leading zeros are not counted into significant digits */
+    std::uint64_t significand = 0;
+    Int digits = 0;
+    Int exponent = 0;
+    bool fraction = false;
+    for(; i != end; ++i) {
+        const char c = *i;
+        if(isBaseN<10>(c)) {
+            if(significand || c != '0') {
+                if(++digits > 19) return false;
+                significand = significand*10 + (c - '0');
+            }
+            if(fraction) --exponent;
+        } else if(c == '.') fraction = true;
+        else break;
+    }
+
+    /* Exponent */
+    if(i != end && (*i == 'e' || *i == 'E')) {
+        ++i;
+
+        bool negative = false;
+        if(*i == '+') ++i;
+        else if(*i == '-') {
+            negative = true;
+            ++i;
+        }
+
+        Int value = 0;
+        for(; i != end && isBaseN<10>(*i); ++i) {
+            if(value > 1000) return false;
+            value = value*10 + (*i - '0');
+        }
+
+        exponent += negative ? -value : value;
+    }
+
+    /* Underscores or anything else unexpected */
+    if(i != end) return false;
+
+    if(!significand) {
+        out = 0.0;
+        return true;
+    }
+
+    if(significand > (1ull << 53) || exponent < -22 || exponent > 22)
+        return false;
+
+    out = exponent < 0 ? Double(significand)/PowersOfTen[-exponent] :
+                         Double(significand)*PowersOfTen[exponent];
+    return true;
+    #endif
+}
+
+template<class T> bool fastFloatingPointLiteral(const char* begin, const char* end, T& out);
+template<> inline bool fastFloatingPointLiteral<Double>(const char* const begin, const char* const end, Double& out) {
+    return fastDecimalLiteral(begin, end, out);
+}
+template<> inline bool fastFloatingPointLiteral<Float>(const char* const begin, const char* const end, Float& out) {
+    Double value;
+    if(!fastDecimalLiteral(begin, end, value)) return false;
+
+    /* Rounding the correctly rounded double to a float gives a correctly
+       rounded float, unless the double lies exactly halfway between two
+       floats */
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(Double));
+    if((bits & 0x1fffffff) == 0x10000000) return false;
+
+    out = Float(value);
+    return true;
+}
+
 template<class> constexpr Type typeFor();
 #define _c(T) template<> constexpr Type typeFor<T>() { return Type::T; }
 _c(UnsignedByte)
@@ -410,7 +732,11 @@ template<Int base, class T> const char* numericCharacters(const Containers::Arra
     return i;
 }
 
-template<Int base, class T> std::pair<const char*, T> baseNLiteral(const Containers::ArrayView<const char> data, std::string& buffer, ParseError& error) {
+inline UnsignedInt digitValue(const char c) {
+    return isBaseN<10>(c) ? c - '0' : (c | 0x20) - 'a' + 10;
+}
+
+template<Int base, class T> std::pair<const char*, T> baseNLiteral(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Propagate errors */
     if(!data) return {};
 
@@ -419,11 +745,20 @@ template<Int base, class T> std::pair<const char*, T> baseNLiteral(const Contain
     /* Propagate errors */
     if(!i) return {};
 
-    extractWithoutUnderscore(data.prefix(i), buffer);
-    const ExtractedType<T> out = ExtractToType<T>::extract(buffer, base);
-    if(out > ExtractedType<T>(std::numeric_limits<T>::max())) {
-        error = {ParseErrorType::LiteralOutOfRange, typeFor<T>(), data};
-        return {};
+    /* Accumulate the value in place, skipping underscores and checking that
+       it doesn't overflow the target type */
+    constexpr ExtractedType<T> max = ExtractedType<T>(std::numeric_limits<T>::max());
+    ExtractedType<T> out{};
+    for(const char* c = data; c != i; ++c) {
+        if(*c == '_') continue;
+
+        const UnsignedInt digit = digitValue(*c);
+        if(out > (max - digit)/base) {
+            error = {ParseErrorType::LiteralOutOfRange, typeFor<T>(), data};
+            return {};
+        }
+
+        out = out*base + digit;
     }
 
     return {i, T(out)};
@@ -431,7 +766,7 @@ template<Int base, class T> std::pair<const char*, T> baseNLiteral(const Contain
 
 }
 
-template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containers::ArrayView<const char> data, std::string& buffer, ParseError& error) {
+template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Propagate errors */
     if(!data) return {};
 
@@ -468,19 +803,19 @@ template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containe
         case 'x':
         case 'X': {
             base = 16;
-            std::tie(i, value) = baseNLiteral<16, T>(data.suffix(i + 2), buffer, error);
+            std::tie(i, value) = baseNLiteral<16, T>(data.suffix(i + 2), error);
             break;
         }
         case 'o':
         case 'O': {
             base = 8;
-            std::tie(i, value) = baseNLiteral<8, T>(data.suffix(i + 2), buffer, error);
+            std::tie(i, value) = baseNLiteral<8, T>(data.suffix(i + 2), error);
             break;
         }
         case 'b':
         case 'B': {
             base = 2;
-            std::tie(i, value) = baseNLiteral<2, T>(data.suffix(i + 2), buffer, error);
+            std::tie(i, value) = baseNLiteral<2, T>(data.suffix(i + 2), error);
             break;
         }
 
@@ -489,26 +824,26 @@ template<class T> std::tuple<const char*, T, Int> integralLiteral(const Containe
     /* Decimal literal  */
     } else {
         base = 10;
-        std::tie(i, value) = baseNLiteral<10, T>(data.suffix(i), buffer, error);
+        std::tie(i, value) = baseNLiteral<10, T>(data.suffix(i), error);
     }
 
     /** @todo C++14: use {} */
     return std::make_tuple(i, sign*value, base);
 }
 
-template std::tuple<const char*, UnsignedByte, Int> integralLiteral<UnsignedByte>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Byte, Int> integralLiteral<Byte>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, UnsignedShort, Int> integralLiteral<UnsignedShort>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Short, Int> integralLiteral<Short>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, UnsignedInt, Int> integralLiteral<UnsignedInt>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Int, Int> integralLiteral<Int>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::tuple<const char*, UnsignedByte, Int> integralLiteral<UnsignedByte>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Byte, Int> integralLiteral<Byte>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, UnsignedShort, Int> integralLiteral<UnsignedShort>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Short, Int> integralLiteral<Short>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, UnsignedInt, Int> integralLiteral<UnsignedInt>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Int, Int> integralLiteral<Int>(Containers::ArrayView<const char>, ParseError&);
 #ifdef CORRADE_TARGET_APPLE
-template std::tuple<const char*, unsigned long, Int> integralLiteral<unsigned long>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, long, Int> integralLiteral<long>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::tuple<const char*, unsigned long, Int> integralLiteral<unsigned long>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, long, Int> integralLiteral<long>(Containers::ArrayView<const char>, ParseError&);
 #endif
 #ifndef MAGNUM_TARGET_WEBGL
-template std::tuple<const char*, UnsignedLong, Int> integralLiteral<UnsignedLong>(Containers::ArrayView<const char>, std::string&, ParseError&);
-template std::tuple<const char*, Long, Int> integralLiteral<Long>(Containers::ArrayView<const char>, std::string&, ParseError&);
+template std::tuple<const char*, UnsignedLong, Int> integralLiteral<UnsignedLong>(Containers::ArrayView<const char>, ParseError&);
+template std::tuple<const char*, Long, Int> integralLiteral<Long>(Containers::ArrayView<const char>, ParseError&);
 #endif
 
 template<class T> std::pair<const char*, T> floatingPointLiteral(const Containers::ArrayView<const char> data, std::string& buffer, ParseError& error) {
@@ -536,17 +871,17 @@ template<class T> std::pair<const char*, T> floatingPointLiteral(const Container
         switch(i[1]) {
             case 'x':
             case 'X': {
-                std::tie(i, integralValue) = baseNLiteral<16, IntegralTypeFor<T>>(data.suffix(i + 2), buffer, error);
+                std::tie(i, integralValue) = baseNLiteral<16, IntegralTypeFor<T>>(data.suffix(i + 2), error);
                 break;
             }
             case 'o':
             case 'O': {
-                std::tie(i, integralValue) = baseNLiteral<8, IntegralTypeFor<T>>(data.suffix(i + 2), buffer, error);
+                std::tie(i, integralValue) = baseNLiteral<8, IntegralTypeFor<T>>(data.suffix(i + 2), error);
                 break;
             }
             case 'b':
             case 'B': {
-                std::tie(i, integralValue) = baseNLiteral<2, IntegralTypeFor<T>>(data.suffix(i + 2), buffer, error);
+                std::tie(i, integralValue) = baseNLiteral<2, IntegralTypeFor<T>>(data.suffix(i + 2), error);
                 break;
             }
 
@@ -582,7 +917,7 @@ template<class T> std::pair<const char*, T> floatingPointLiteral(const Container
         ++i;
 
         /* Exponent sign */
-        if(*i == '+' || *i == '-') ++i;
+        if(i != data.end() && (*i == '+' || *i == '-')) ++i;
 
         i = numericCharacters<10, T>(data.suffix(i), error);
     }
@@ -592,6 +927,11 @@ template<class T> std::pair<const char*, T> floatingPointLiteral(const Container
 
     /** @todo verifying out-of-range */
 
+    /* Most literals can be converted in place, the rest goes through the
+       standard library */
+    T value;
+    if(fastFloatingPointLiteral<T>(before, i, value)) return {i, sign*value};
+
     extractWithoutUnderscore(data.prefix(i), buffer);
     return {i, ExtractToType<T>::extract(buffer)};
 }
@@ -599,6 +939,89 @@ template<class T> std::pair<const char*, T> floatingPointLiteral(const Container
 template std::pair<const char*, Float> floatingPointLiteral<Float>(Containers::ArrayView<const char>, std::string&, ParseError&);
 template std::pair<const char*, Double> floatingPointLiteral<Double>(Containers::ArrayView<const char>, std::string&, ParseError&);
 
+Half packHalf(const Float value) {
+    UnsignedInt bits;
+    std::memcpy(&bits, &value, sizeof(Float));
+
+    const UnsignedInt sign = (bits >> 16) & 0x8000;
+    const Int exponent = Int((bits >> 23) & 0xff) - 127 + 15;
+    UnsignedInt mantissa = bits & 0x7fffff;
+
+    /* Infinity and NaN, keeping the NaN quiet */
+    if(exponent == 0xff - 127 + 15)
+        return Half(sign | 0x7c00 | (mantissa ? 0x200 | (mantissa >> 13) : 0));
+
+    /* Too large, overflow to infinity */
+    if(exponent >= 0x1f) return Half(sign | 0x7c00);
+
+    /* Too small even for a denormal, underflow to zero. This includes float
+       denormals. */
+    if(exponent < -10) return Half(sign);
+
+    /* Denormal, shift the mantissa including the implicit bit */
+    UnsignedInt shift = 13;
+    UnsignedInt out = (UnsignedInt(exponent) << 10);
+    if(exponent <= 0) {
+        mantissa |= 0x800000;
+        shift = 14 - exponent;
+        out = 0;
+    }
+
+    /* Round to nearest even. If the mantissa overflows, the carry correctly
+       propagates to the exponent or to infinity. */
+    out |= mantissa >> shift;
+    const UnsignedInt rest = mantissa & ((1u << shift) - 1);
+    const UnsignedInt halfway = 1u << (shift - 1);
+    if(rest > halfway || (rest == halfway && (out & 1))) ++out;
+
+    return Half(sign | out);
+}
+
+template<> std::pair<const char*, Half> floatingPointLiteral<Half>(const Containers::ArrayView<const char> data, std::string& buffer, ParseError& error) {
+    /* Propagate errors */
+    if(!data) return {};
+
+    /* Binary literals specify the bits directly, the sign flips the sign bit */
+    const char* i = data;
+    if(i != data.end() && (*i == '+' || *i == '-')) ++i;
+    if(i + 1 < data.end() && *i == '0' && isBinaryPrefix(i[1])) {
+        const UnsignedShort sign = *data == '-' ? 0x8000 : 0;
+        UnsignedShort value;
+        switch(i[1]) {
+            case 'x':
+            case 'X': {
+                std::tie(i, value) = baseNLiteral<16, UnsignedShort>(data.suffix(i + 2), error);
+                break;
+            }
+            case 'o':
+            case 'O': {
+                std::tie(i, value) = baseNLiteral<8, UnsignedShort>(data.suffix(i + 2), error);
+                break;
+            }
+            case 'b':
+            case 'B': {
+                std::tie(i, value) = baseNLiteral<2, UnsignedShort>(data.suffix(i + 2), error);
+                break;
+            }
+
+            default: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+        }
+
+        return {i, Half(value ^ sign)};
+    }
+
+    /* Everything else is parsed as a float and then packed, errors are
+       reported for the half type */
+    Float value;
+    std::tie(i, value) = floatingPointLiteral<Float>(data, buffer, error);
+    if(!i) {
+        if(error.type == Type::Float) error.type = Type::Half;
+        return {};
+    }
+
+    return {i, packHalf(value)};
+}
+
 std::pair<const char*, std::string> stringLiteral(const Containers::ArrayView<const char> data, ParseError& error) {
     /* Propagate errors */
     if(!data) return {};
@@ -611,6 +1034,12 @@ std::pair<const char*, std::string> stringLiteral(const Containers::ArrayView<co
     std::string out;
 
     for(const char* i = data + 1; i != data.end(); ) {
+        /* Append runs of ordinary characters at once */
+        const char* const begin = i;
+        while(i != data.end() && *i != '"' && *i != '\\' && UnsignedByte(*i) >= 0x20) ++i;
+        out.append(begin, i);
+        if(i == data.end()) break;
+
         const char c = *i;
 
         if(UnsignedByte(c) < 0x20) {
@@ -619,23 +1048,19 @@ std::pair<const char*, std::string> stringLiteral(const Containers::ArrayView<co
         }
 
         /* Escaped character */
-        if(c == '\\')
+        if(c == '\\') {
             i = escapedUnicode(data.suffix(i), out, error);
+            if(!i) return {};
 
         /* End of string, try searching for continuation */
-        else if(c == '"') {
+        } else {
             const char* j = whitespace(data.suffix(i + 1));
 
             /* Continuation not found, done */
             if(j + 1 >= data.end() || *j != '"')
-                return {j, out};
+                return {j, std::move(out)};
 
             i = j + 1;
-
-        /* Any other character, append it to result */
-        } else {
-            out += c;
-            ++i;
         }
     }
 
@@ -704,7 +1129,8 @@ std::pair<const char*, Type> possiblyTypeLiteral(const Containers::ArrayView<con
     _c(unsigned_int64, UnsignedLong)
     _c(int64, Long)
     #endif
-    /** @todo Half */
+    _c(half, Half)
+    _c(float16, Half)
     _c(float, Float)
     _c(double, Double)
     _c(string, String)
@@ -770,7 +1196,7 @@ std::pair<const char*, InternalPropertyType> propertyValue(const Containers::Arr
 
         /* Integer literal otherwise */
         Int base;
-        std::tie(i, integerValue, base) = integralLiteral<Int>(data, buffer, error);
+        std::tie(i, integerValue, base) = integralLiteral<Int>(data, error);
         switch(base) {
             case 2:
             case 8:
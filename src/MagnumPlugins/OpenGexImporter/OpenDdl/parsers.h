@@ -83,14 +83,18 @@ template<std::size_t size> const char* findLastOf(Containers::ArrayView<const ch
 }
 
 const char* whitespace(Containers::ArrayView<const char> data);
+const char* structureEnd(Containers::ArrayView<const char> data);
+std::pair<const char*, std::size_t> dataListSize(Containers::ArrayView<const char> data, std::size_t subArraySize);
 std::pair<const char*, char> escapedChar(Containers::ArrayView<const char> data, ParseError& error);
 const char* escapedUnicode(Containers::ArrayView<const char> data, std::string& out, ParseError& error);
 const char* identifier(Containers::ArrayView<const char> data, ParseError& error);
 
 std::pair<const char*, bool> boolLiteral(Containers::ArrayView<const char> data, ParseError& error);
 std::pair<const char*, char> characterLiteral(Containers::ArrayView<const char> data, ParseError& error);
-template<class T> std::tuple<const char*, T, Int> integralLiteral(Containers::ArrayView<const char> data, std::string& buffer, ParseError& error);
+template<class T> std::tuple<const char*, T, Int> integralLiteral(Containers::ArrayView<const char> data, ParseError& error);
 template<class T> std::pair<const char*, T> floatingPointLiteral(Containers::ArrayView<const char> data, std::string& buffer, ParseError& error);
+template<> std::pair<const char*, Half> floatingPointLiteral<Half>(Containers::ArrayView<const char> data, std::string& buffer, ParseError& error);
+Half packHalf(Float value);
 std::pair<const char*, std::string> stringLiteral(Containers::ArrayView<const char> data, ParseError& error);
 std::pair<const char*, std::string> nameLiteral(Containers::ArrayView<const char> data, ParseError& error);
 std::pair<const char*, Containers::ArrayView<const char>> referenceLiteral(Containers::ArrayView<const char> data, ParseError& error);
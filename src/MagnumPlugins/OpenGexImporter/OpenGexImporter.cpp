@@ -26,9 +26,13 @@
 #include "OpenGexImporter.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <limits>
+#include <type_traits>
 #include <unordered_map>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/Mesh.h>
 #include <Magnum/Math/Quaternion.h>
@@ -48,11 +52,19 @@
 
 #include "openGexSpec.hpp"
 
+/* Memory mapping is not available everywhere */
+#if (defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_OPENGEXIMPORTER_USE_MAP
+#endif
+
 namespace Magnum { namespace Trade {
 
 using namespace Magnum::Math::Literals;
 
 struct OpenGexImporter::Document {
+    /* Copy of the file data, needed only if parsing lazily */
+    Containers::Array<char> data;
+
     OpenDdl::Document document;
 
     /* Default metrics */
@@ -68,30 +80,28 @@ struct OpenGexImporter::Document {
         lights,
         meshes,
         materials,
-        textures;
+        textures,
+        animationTracks;
 
     std::unordered_map<std::string, Int> nodesForName,
         materialsForName;
 
     std::unordered_map<std::string, UnsignedInt> imagesForName;
     std::vector<std::string> images;
-};
 
-namespace {
+    /* ID of each gathered structure in its respective list, indexed by
+       OpenDdl::Structure::index() */
+    std::vector<Int> structureIds;
 
-inline Int findStructureId(const std::vector<OpenDdl::Structure>& structures, OpenDdl::Structure structure) {
-    auto found = std::find(structures.begin(), structures.end(), structure);
-    return found == structures.end() ? -1 : found - structures.begin();
-}
+    UnsignedInt structureId(const std::vector<OpenDdl::Structure>& structures, OpenDdl::Structure structure) const;
+};
 
-UnsignedInt structureId(const std::vector<OpenDdl::Structure>& structures, OpenDdl::Structure structure) {
-    const Int id = findStructureId(structures, structure);
-    CORRADE_INTERNAL_ASSERT(id != -1);
+UnsignedInt OpenGexImporter::Document::structureId(const std::vector<OpenDdl::Structure>& structures, const OpenDdl::Structure structure) const {
+    const Int id = structureIds[structure.index()];
+    CORRADE_INTERNAL_ASSERT(id != -1 && structures[id] == structure);
     return id;
 }
 
-}
-
 OpenGexImporter::OpenGexImporter() = default;
 
 OpenGexImporter::OpenGexImporter(PluginManager::Manager<AbstractImporter>& manager): AbstractImporter(manager) {}
@@ -116,14 +126,66 @@ void gatherNodes(OpenDdl::Structure node, std::vector<OpenDdl::Structure>& nodes
         gatherNodes(childNode, nodes, nodesForName);
 }
 
+/* Importer instantiated without a plugin manager has an empty configuration,
+   parse on a single thread in that case */
+UnsignedInt threadCount(const Utility::ConfigurationGroup& configuration) {
+    return configuration.hasValue("threadCount") ? configuration.value<UnsignedInt>("threadCount") : 1;
+}
+
+std::size_t lazyParsingThreshold(const Utility::ConfigurationGroup& configuration) {
+    return configuration.hasValue("lazyParsingThreshold") ? configuration.value<std::size_t>("lazyParsingThreshold") : 0;
+}
+
+bool presizeStorage(const Utility::ConfigurationGroup& configuration) {
+    return configuration.hasValue("presizeStorage") && configuration.value<bool>("presizeStorage");
+}
+
+UnsignedInt meshLod(const Utility::ConfigurationGroup& configuration) {
+    return configuration.hasValue("lod") ? configuration.value<UnsignedInt>("lod") : 0;
+}
+
+/* 64-bit FNV-1a, processing eight bytes at a time so hashing large files
+   takes only a fraction of the parse time. Used only to detect changes of the
+   source file, not as a general-purpose hash. */
+std::uint64_t sourceHash(const Containers::ArrayView<const char> data) {
+    std::uint64_t hash = 14695981039346656037ull;
+    std::size_t i = 0;
+    for(; i + 8 <= data.size(); i += 8) {
+        std::uint64_t value;
+        std::memcpy(&value, data + i, 8);
+        hash ^= value;
+        hash *= 1099511628211ull;
+    }
+    for(; i != data.size(); ++i) {
+        hash ^= UnsignedByte(data[i]);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
 }
 
 void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
     std::unique_ptr<Document> d{new Document};
 
+    /* Lazily parsed data lists are parsed from the original data on first
+       access, so the document needs its own copy of them */
+    Containers::ArrayView<const char> source = data;
+    if(const std::size_t threshold = lazyParsingThreshold(configuration())) {
+        d->data = Containers::Array<char>{Containers::NoInit, data.size()};
+        std::copy(data.begin(), data.end(), d->data.begin());
+        source = d->data;
+        d->document.setLazyParsingThreshold(threshold);
+    }
+
     /* Parse the document */
-    if(!d->document.parse(data, OpenGex::structures, OpenGex::properties)) return;
+    d->document.setPresizeStorage(presizeStorage(configuration()));
+    if(!d->document.parse(source, OpenGex::structures, OpenGex::properties, threadCount(configuration()))) return;
 
+    openInternal(std::move(d));
+}
+
+void OpenGexImporter::openInternal(std::unique_ptr<Document> d) {
     /* Validate the document */
     if(!d->document.validate(OpenGex::rootStructures, OpenGex::structureInfo)) return;
 
@@ -184,8 +246,7 @@ void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
     for(const OpenDdl::Structure camera: d->document.childrenOf(OpenGex::CameraObject))
         d->cameras.push_back(camera);
 
-    /* Gather all meshes */
-    /** @todo Support for LOD */
+    /* Gather all meshes. Particular level of detail is picked on import. */
     for(const OpenDdl::Structure geometry: d->document.childrenOf(OpenGex::GeometryObject))
         d->meshes.push_back(geometry);
 
@@ -214,18 +275,86 @@ void OpenGexImporter::doOpenData(const Containers::ArrayView<const char> data) {
     for(const OpenDdl::Structure node: d->document.childrenOf(OpenGex::Node, OpenGex::BoneNode, OpenGex::GeometryNode, OpenGex::CameraNode, OpenGex::LightNode))
         gatherNodes(node, d->nodes, d->nodesForName);
 
+    /* Gather animation tracks of all nodes */
+    for(const OpenDdl::Structure node: d->nodes)
+        for(const OpenDdl::Structure animation: node.childrenOf(OpenGex::Animation))
+            for(const OpenDdl::Structure track: animation.childrenOf(OpenGex::Track))
+                d->animationTracks.push_back(track);
+
+    /* Map the structures back to their IDs so references can be converted to
+       IDs without searching the lists */
+    d->structureIds.assign(d->document.structureCount(), -1);
+    for(const std::vector<OpenDdl::Structure>* const structures: {&d->nodes, &d->cameras, &d->lights, &d->meshes, &d->materials, &d->textures})
+        for(std::size_t i = 0; i != structures->size(); ++i)
+            d->structureIds[(*structures)[i].index()] = i;
+
     /* Everything okay, save the instance */
     _d = std::move(d);
 }
 
 void OpenGexImporter::doOpenFile(const std::string& filename) {
-    /* Make doOpenData() do the thing */
-    AbstractImporter::doOpenFile(filename);
+    /* Make doOpenData() do the thing if there's no cache */
+    const std::string cacheExtension = configuration().value("cacheExtension");
+    if(cacheExtension.empty()) AbstractImporter::doOpenFile(filename);
+    else openFileCached(filename, filename + cacheExtension);
 
     /* If succeeded, save file path for later */
     if(_d) _d->filePath = Utility::Directory::path(filename);
 }
 
+void OpenGexImporter::openFileCached(const std::string& filename, const std::string& cacheFilename) {
+    /* Map the file if possible so huge files don't need to be read whole into
+       memory, otherwise read it */
+    #ifdef MAGNUM_OPENGEXIMPORTER_USE_MAP
+    const Containers::Array<const char, Utility::Directory::MapDeleter> data = Utility::Directory::mapRead(filename);
+    if(!data) {
+        Error() << "Trade::OpenGexImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+    #else
+    if(!Utility::Directory::fileExists(filename)) {
+        Error() << "Trade::OpenGexImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+    const Containers::Array<char> data = Utility::Directory::read(filename);
+    #endif
+
+    /* The cache is prefixed with size and hash of the source file */
+    const std::uint64_t key[]{data.size(), sourceHash(data)};
+
+    /* Try to load the cache, if it's there and matches the file */
+    std::unique_ptr<Document> d{new Document};
+    bool cached = false;
+    if(Utility::Directory::fileExists(cacheFilename)) {
+        #ifdef MAGNUM_OPENGEXIMPORTER_USE_MAP
+        const Containers::Array<const char, Utility::Directory::MapDeleter> cache = Utility::Directory::mapRead(cacheFilename);
+        #else
+        const Containers::Array<char> cache = Utility::Directory::read(cacheFilename);
+        #endif
+        if(cache.size() >= sizeof(key) && std::memcmp(cache, key, sizeof(key)) == 0) {
+            cached = d->document.deserialize(cache.suffix(sizeof(key)), OpenGex::structures, OpenGex::properties);
+
+            /* The document has undefined contents on failure, start over */
+            if(!cached) d.reset(new Document);
+        }
+    }
+
+    /* Otherwise parse the file. Lazy parsing is not used here as the whole
+       document needs to be parsed for the cache anyway. */
+    if(!cached && !d->document.parse(data, OpenGex::structures, OpenGex::properties, threadCount(configuration()))) return;
+
+    openInternal(std::move(d));
+
+    /* Save the cache if the file was parsed and is valid */
+    if(!_d || cached) return;
+    const Containers::Array<char> serialized = _d->document.serialize();
+    Containers::Array<char> cache{Containers::NoInit, sizeof(key) + serialized.size()};
+    std::memcpy(cache, key, sizeof(key));
+    std::memcpy(cache + sizeof(key), serialized, serialized.size());
+    if(!Utility::Directory::write(cacheFilename, cache))
+        Warning() << "Trade::OpenGexImporter::openFile(): cannot write cache file" << cacheFilename;
+}
+
 void OpenGexImporter::doClose() { _d = nullptr; }
 
 Int OpenGexImporter::doDefaultScene() { return 0; }
@@ -309,6 +438,11 @@ namespace {
         m[3].xyz() *= distanceMultiplier;
         return m;
     }
+
+    inline Matrix4 fixTransformation(const Matrix4& m, const Float distanceMultiplier, const bool yUp) {
+        const Matrix4 scaled = fixMatrixTranslation(m, distanceMultiplier);
+        return yUp ? scaled : fixMatrixZUp(scaled);
+    }
 }
 
 std::unique_ptr<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt id) {
@@ -419,7 +553,7 @@ std::unique_ptr<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt id)
     /* Child node IDs */
     std::vector<UnsignedInt> children;
     for(const OpenDdl::Structure childNode: node.childrenOf(OpenGex::Node, OpenGex::BoneNode, OpenGex::GeometryNode, OpenGex::CameraNode, OpenGex::LightNode))
-        children.push_back(structureId(_d->nodes, childNode));
+        children.push_back(_d->structureId(_d->nodes, childNode));
 
     /* Mesh object */
     if(node.identifier() == OpenGex::GeometryNode) {
@@ -429,14 +563,14 @@ std::unique_ptr<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt id)
             Error() << "Trade::OpenGexImporter::object3D(): null geometry reference";
             return nullptr;
         }
-        const UnsignedInt meshId = structureId(_d->meshes, *mesh);
+        const UnsignedInt meshId = _d->structureId(_d->meshes, *mesh);
 
         /* Material ID, if present */
         /** @todo support more materials per mesh */
         Int materialId = -1;
         if(const auto materialRef = node.findFirstChildOf(OpenGex::MaterialRef))
             if(const auto material = materialRef->firstChildOf(OpenDdl::Type::Reference).asReference())
-                materialId = structureId(_d->materials, *material);
+                materialId = _d->structureId(_d->materials, *material);
 
         return std::unique_ptr<ObjectData3D>{new MeshObjectData3D{children, transformation, meshId, materialId, &node}};
 
@@ -448,7 +582,7 @@ std::unique_ptr<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt id)
             Error() << "Trade::OpenGexImporter::object3D(): null camera reference";
             return nullptr;
         }
-        const UnsignedInt cameraId = structureId(_d->cameras, *camera);
+        const UnsignedInt cameraId = _d->structureId(_d->cameras, *camera);
 
         return std::unique_ptr<ObjectData3D>{new ObjectData3D{children, transformation, ObjectInstanceType3D::Camera, cameraId, &node}};
 
@@ -460,7 +594,7 @@ std::unique_ptr<ObjectData3D> OpenGexImporter::doObject3D(const UnsignedInt id)
             Error() << "Trade::OpenGexImporter::object3D(): null light reference";
             return nullptr;
         }
-        const UnsignedInt lightId = structureId(_d->lights, *light);
+        const UnsignedInt lightId = _d->structureId(_d->lights, *light);
 
         return std::unique_ptr<ObjectData3D>{new ObjectData3D{children, transformation, ObjectInstanceType3D::Light, lightId, &node}};
     }
@@ -548,10 +682,15 @@ UnsignedInt OpenGexImporter::doMesh3DCount() const {
 
 namespace {
 
-template<class Result, class Original> std::vector<Result> extractVertexData3(const OpenDdl::Structure vertexArray) {
-    const Containers::ArrayView<const typename Original::Type> data = vertexArray.asArray<typename Original::Type>();
-    const std::size_t vertexCount = vertexArray.arraySize()/(vertexArray.subArraySize() ? vertexArray.subArraySize() : 1);
+template<class Result, class Original> std::vector<Result> extractVertexData4(const Containers::ArrayView<const typename Original::Type> data, const std::size_t vertexCount, std::true_type) {
+    /* The data are already in the result layout, copy them in bulk. Empty
+       arrays have no data to point to. */
+    if(!vertexCount) return {};
+    const Result* const begin = &Result::from(data.data());
+    return {begin, begin + vertexCount};
+}
 
+template<class Result, class Original> std::vector<Result> extractVertexData4(const Containers::ArrayView<const typename Original::Type> data, const std::size_t vertexCount, std::false_type) {
     std::vector<Result> output;
     output.reserve(vertexCount);
     for(std::size_t i = 0; i != vertexCount; ++i)
@@ -561,9 +700,33 @@ template<class Result, class Original> std::vector<Result> extractVertexData3(co
     return output;
 }
 
+template<class Result, class Original> std::vector<Result> extractVertexData3(const OpenDdl::Structure vertexArray) {
+    const Containers::ArrayView<const typename Original::Type> data = vertexArray.asArray<typename Original::Type>();
+    const std::size_t vertexCount = vertexArray.arraySize()/(vertexArray.subArraySize() ? vertexArray.subArraySize() : 1);
+    return extractVertexData4<Result, Original>(data, vertexCount, std::integral_constant<bool, std::size_t(Original::Size) == std::size_t(Result::Size) && std::is_same<typename Original::Type, typename Result::Type>::value>{});
+}
+
+/* Half-floats are kept packed in the document, unpack them component by
+   component */
+template<class Result, std::size_t originalSize> std::vector<Result> extractHalfVertexData(const OpenDdl::Structure vertexArray) {
+    const Containers::ArrayView<const OpenDdl::Half> data = vertexArray.asArray<OpenDdl::Half>();
+    const std::size_t vertexCount = vertexArray.arraySize()/originalSize;
+    std::vector<Result> output;
+    output.reserve(vertexCount);
+    for(std::size_t i = 0; i != vertexCount; ++i) {
+        Math::Vector<originalSize, Float> value;
+        for(std::size_t j = 0; j != originalSize; ++j)
+            value[j] = OpenDdl::unpackHalf(data[i*originalSize + j]);
+        output.push_back(Result::pad(value));
+    }
+
+    return output;
+}
+
 template<class Result, std::size_t originalSize> std::vector<Result> extractVertexData2(const OpenDdl::Structure vertexArray) {
     switch(vertexArray.type()) {
-        /** @todo half */
+        case OpenDdl::Type::Half:
+            return extractHalfVertexData<Result, originalSize>(vertexArray);
         case OpenDdl::Type::Float:
             return extractVertexData3<Result, Math::Vector<originalSize, Float>>(vertexArray);
         case OpenDdl::Type::Double:
@@ -589,6 +752,38 @@ template<class Result> std::vector<Result> extractVertexData(const OpenDdl::Stru
     CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
 }
 
+/* Scales the positions and converts them from Z up to Y up in a single pass.
+   Unit scale and Y up are common enough to skip the loop altogether. */
+void fixPositions(std::vector<Vector3>& positions, const Float distanceMultiplier, const bool yUp) {
+    if(yUp) {
+        if(distanceMultiplier != 1.0f) for(Vector3& i: positions)
+            i *= distanceMultiplier;
+    } else for(Vector3& i: positions)
+        i = {i.x()*distanceMultiplier, i.z()*distanceMultiplier, -i.y()*distanceMultiplier};
+}
+
+/* Picks the mesh with the largest level of detail not larger than the
+   requested one. If all levels are larger, picks the most detailed one. */
+OpenDdl::Structure meshForLod(const OpenDdl::Structure geometry, const UnsignedInt lod) {
+    Containers::Optional<OpenDdl::Structure> found;
+    UnsignedInt foundLevel{};
+    for(const OpenDdl::Structure mesh: geometry.childrenOf(OpenGex::Mesh)) {
+        const Containers::Optional<OpenDdl::Property> lodProperty = mesh.findPropertyOf(OpenGex::lod);
+        const UnsignedInt level = lodProperty ? lodProperty->as<Int>() : 0;
+        if(!found || (level <= lod ?
+            foundLevel > lod || level > foundLevel :
+            foundLevel > lod && level < foundLevel))
+        {
+            found = mesh;
+            foundLevel = level;
+        }
+    }
+
+    /* The validation ensures there's always at least one mesh */
+    CORRADE_INTERNAL_ASSERT(found);
+    return *found;
+}
+
 template<class T> std::vector<UnsignedInt> extractIndices(const OpenDdl::Structure indexArray) {
     const Containers::ArrayView<const T> data = indexArray.asArray<T>();
     return {data.begin(), data.end()};
@@ -597,7 +792,7 @@ template<class T> std::vector<UnsignedInt> extractIndices(const OpenDdl::Structu
 }
 
 Containers::Optional<MeshData3D> OpenGexImporter::doMesh3D(const UnsignedInt id) {
-    const OpenDdl::Structure& mesh = _d->meshes[id].firstChildOf(OpenGex::Mesh);
+    const OpenDdl::Structure mesh = meshForLod(_d->meshes[id], meshLod(configuration()));
 
     /* Primitive type, triangles by default */
     std::size_t indexArraySubArraySize = 3;
@@ -636,7 +831,8 @@ Containers::Optional<MeshData3D> OpenGexImporter::doMesh3D(const UnsignedInt id)
         const OpenDdl::Structure vertexArrayData = vertexArray.firstChild();
 
         /* Sanity checks (would be too bloaty to do in actual templated code) */
-        if(vertexArrayData.type() != OpenDdl::Type::Float &&
+        if(vertexArrayData.type() != OpenDdl::Type::Half &&
+           vertexArrayData.type() != OpenDdl::Type::Float &&
            vertexArrayData.type() != OpenDdl::Type::Double)
         {
             Error() << "Trade::OpenGexImporter::mesh3D(): unsupported vertex array type" << vertexArrayData.type();
@@ -647,11 +843,13 @@ Containers::Optional<MeshData3D> OpenGexImporter::doMesh3D(const UnsignedInt id)
             return Containers::NullOpt;
         }
 
+        /* Parse the data, if that was deferred */
+        if(!vertexArrayData.parseData()) return Containers::NullOpt;
+
         /* Vertex positions */
         if(attrib == "position") {
             std::vector<Vector3> positionData = extractVertexData<Vector3>(vertexArrayData);
-            for(auto& i: positionData) i *= _d->distanceMultiplier;
-            if(!_d->yUp) for(auto& i: positionData) i = fixVectorZUp(i);
+            fixPositions(positionData, _d->distanceMultiplier, _d->yUp);
             positions.push_back(std::move(positionData));
 
         /* Normals */
@@ -698,6 +896,9 @@ Containers::Optional<MeshData3D> OpenGexImporter::doMesh3D(const UnsignedInt id)
             return Containers::NullOpt;
         }
 
+        /* Parse the data, if that was deferred */
+        if(!indexArrayData.parseData()) return Containers::NullOpt;
+
         switch(indexArrayData.type()) {
             case OpenDdl::Type::UnsignedByte:
                 indices = extractIndices<UnsignedByte>(indexArrayData);
@@ -718,7 +919,7 @@ Containers::Optional<MeshData3D> OpenGexImporter::doMesh3D(const UnsignedInt id)
         }
     }
 
-    return MeshData3D{primitive, indices, positions, normals, textureCoordinates, {}, &mesh};
+    return MeshData3D{primitive, std::move(indices), std::move(positions), std::move(normals), std::move(textureCoordinates), {}, &_d->meshes[id]};
 }
 
 UnsignedInt OpenGexImporter::doMaterialCount() const { return _d->materials.size(); }
@@ -742,10 +943,10 @@ std::unique_ptr<AbstractMaterialData> OpenGexImporter::doMaterial(const Unsigned
     for(const OpenDdl::Structure texture: material.childrenOf(OpenGex::Texture)) {
         const auto& attrib = texture.propertyOf(OpenGex::attrib).as<std::string>();
         if(attrib == "diffuse") {
-            diffuseTexture = structureId(_d->textures, texture);
+            diffuseTexture = _d->structureId(_d->textures, texture);
             flags |= PhongMaterialData::Flag::DiffuseTexture;
         } else if(attrib == "specular") {
-            specularTexture = structureId(_d->textures, texture);
+            specularTexture = _d->structureId(_d->textures, texture);
             flags |= PhongMaterialData::Flag::SpecularTexture;
         }
     }
@@ -815,6 +1016,330 @@ Containers::Optional<ImageData2D> OpenGexImporter::doImage2D(const UnsignedInt i
     return imageImporter.image2D(0);
 }
 
+UnsignedInt OpenGexImporter::animationTrackCount() const {
+    CORRADE_ASSERT(isOpened(), "Trade::OpenGexImporter::animationTrackCount(): no file opened", {});
+    return _d->animationTracks.size();
+}
+
+namespace {
+
+/* Data of the first key with "value" kind, which is the default */
+Containers::Optional<OpenDdl::Structure> findValueKey(const OpenDdl::Structure keys) {
+    for(const OpenDdl::Structure key: keys.childrenOf(OpenGex::Key)) {
+        const Containers::Optional<OpenDdl::Property> kind = key.findPropertyOf(OpenGex::kind);
+        if(!kind || kind->as<std::string>() == "value") return key.firstChild();
+    }
+
+    return Containers::NullOpt;
+}
+
+}
+
+Containers::Optional<OpenGexImporter::AnimationTrack> OpenGexImporter::animationTrack(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::OpenGexImporter::animationTrack(): no file opened", {});
+    CORRADE_ASSERT(id < animationTrackCount(), "Trade::OpenGexImporter::animationTrack(): index out of range", {});
+
+    const OpenDdl::Structure& track = _d->animationTracks[id];
+    const OpenDdl::Structure animation = *track.parent();
+    const OpenDdl::Structure node = *animation.parent();
+
+    /* The target has to be a transformation or morph weight of the same node
+       the animation belongs to */
+    const Containers::Optional<OpenDdl::Structure> target = track.propertyOf(OpenGex::target).asReference();
+    if(!target || !target->parent() || *target->parent() != node) {
+        Error() << "Trade::OpenGexImporter::animationTrack(): invalid target";
+        return Containers::NullOpt;
+    }
+    AnimationTrack::Target targetType;
+    switch(target->identifier()) {
+        case OpenGex::Transform:
+            targetType = AnimationTrack::Target::Transformation;
+            break;
+        case OpenGex::Translation:
+            targetType = AnimationTrack::Target::Translation;
+            break;
+        case OpenGex::Rotation:
+            targetType = AnimationTrack::Target::Rotation;
+            break;
+        case OpenGex::Scale:
+            targetType = AnimationTrack::Target::Scaling;
+            break;
+        case OpenGex::MorphWeight:
+            targetType = AnimationTrack::Target::MorphWeight;
+            break;
+        default:
+            Error() << "Trade::OpenGexImporter::animationTrack(): invalid target";
+            return Containers::NullOpt;
+    }
+
+    /* Clip index, zero by default */
+    const Containers::Optional<OpenDdl::Property> clipProperty = animation.findPropertyOf(OpenGex::clip);
+    const UnsignedInt clip = clipProperty ? clipProperty->as<Int>() : 0;
+
+    /* Time curve, linear by default. Bezier control points are ignored. */
+    const OpenDdl::Structure time = track.firstChildOf(OpenGex::Time);
+    if(const Containers::Optional<OpenDdl::Property> curve = time.findPropertyOf(OpenGex::curve)) {
+        auto&& curveString = curve->as<std::string>();
+        if(curveString != "linear" && curveString != "bezier") {
+            Error() << "Trade::OpenGexImporter::animationTrack(): unsupported time curve" << curveString;
+            return Containers::NullOpt;
+        }
+    }
+
+    /* Value curve, linear by default */
+    const OpenDdl::Structure value = track.firstChildOf(OpenGex::Value);
+    AnimationTrack::Interpolation interpolation = AnimationTrack::Interpolation::Linear;
+    if(const Containers::Optional<OpenDdl::Property> curve = value.findPropertyOf(OpenGex::curve)) {
+        auto&& curveString = curve->as<std::string>();
+        if(curveString == "constant")
+            interpolation = AnimationTrack::Interpolation::Constant;
+        else if(curveString == "bezier")
+            interpolation = AnimationTrack::Interpolation::Bezier;
+        else if(curveString == "tcb")
+            interpolation = AnimationTrack::Interpolation::Tcb;
+        else if(curveString != "linear") {
+            Error() << "Trade::OpenGexImporter::animationTrack(): unsupported value curve" << curveString;
+            return Containers::NullOpt;
+        }
+    }
+
+    /* Key data */
+    const Containers::Optional<OpenDdl::Structure> timeData = findValueKey(time);
+    const Containers::Optional<OpenDdl::Structure> valueData = findValueKey(value);
+    if(!timeData || !valueData) {
+        Error() << "Trade::OpenGexImporter::animationTrack(): missing key values";
+        return Containers::NullOpt;
+    }
+    if(timeData->subArraySize() > 1) {
+        Error() << "Trade::OpenGexImporter::animationTrack(): invalid time key array subarray size" << timeData->subArraySize();
+        return Containers::NullOpt;
+    }
+    const std::size_t keyCount = timeData->arraySize();
+    const UnsignedInt valueSize = valueData->subArraySize() ? valueData->subArraySize() : 1;
+    if(valueData->arraySize() != keyCount*valueSize) {
+        Error() << "Trade::OpenGexImporter::animationTrack(): mismatched time and value key count";
+        return Containers::NullOpt;
+    }
+
+    /* Parse the data, if that was deferred */
+    if(!timeData->parseData() || !valueData->parseData())
+        return Containers::NullOpt;
+
+    /* Copy both key arrays in bulk, then apply the time metric */
+    Containers::Array<Float> data{Containers::NoInit, keyCount*(valueSize + 1)};
+    const Containers::ArrayView<const Float> times = timeData->asArray<Float>();
+    const Containers::ArrayView<const Float> values = valueData->asArray<Float>();
+    std::copy(times.begin(), times.end(), data.begin());
+    std::copy(values.begin(), values.end(), data.begin() + keyCount);
+    if(_d->timeMultiplier != 1.0f)
+        for(Float& i: data.prefix(keyCount)) i *= _d->timeMultiplier;
+
+    /* Apply the distance and angle metrics to the values and convert them to
+       Y up the same way as object3D() does for the static transformations.
+       Single-axis values can't change their axis, so the kind property of
+       the target keeps naming the axis in the file. The x, y and z axes of a
+       Z up file are X, -Z and Y, so values along y are negated to apply along
+       +Z. */
+    Float* const keyValues = data.data() + keyCount;
+    const Containers::Optional<OpenDdl::Property> kindProperty = target->findPropertyOf(OpenGex::kind);
+    const std::string kind = kindProperty ? kindProperty->as<std::string>() : std::string{};
+    const bool singleAxis = valueSize == 1 && (kind == "x" || kind == "y" || kind == "z");
+    const Float singleAxisSign = !_d->yUp && kind == "y" ? -1.0f : 1.0f;
+    bool valid = true;
+    switch(targetType) {
+        case AnimationTrack::Target::Transformation:
+            if(valueSize == 16) for(std::size_t i = 0; i != keyCount; ++i) {
+                Matrix4& m = Matrix4::from(keyValues + 16*i);
+                m = fixTransformation(m, _d->distanceMultiplier, _d->yUp);
+            } else valid = false;
+            break;
+
+        case AnimationTrack::Target::Translation:
+            if((kind.empty() || kind == "xyz") && valueSize == 3) {
+                for(std::size_t i = 0; i != keyCount; ++i) {
+                    Vector3& v = Vector3::from(keyValues + 3*i);
+                    v *= _d->distanceMultiplier;
+                    if(!_d->yUp) v = fixVectorZUp(v);
+                }
+            } else if(singleAxis) {
+                for(std::size_t i = 0; i != keyCount; ++i)
+                    keyValues[i] *= _d->distanceMultiplier*singleAxisSign;
+            } else valid = false;
+            break;
+
+        case AnimationTrack::Target::Rotation:
+            if((kind.empty() || kind == "axis") && valueSize == 4) {
+                for(std::size_t i = 0; i != keyCount; ++i) {
+                    keyValues[4*i] *= _d->angleMultiplier;
+                    if(!_d->yUp) {
+                        Vector3& axis = Vector3::from(keyValues + 4*i + 1);
+                        axis = fixVectorZUp(axis);
+                    }
+                }
+            } else if(kind == "quaternion" && valueSize == 4) {
+                /* Rotating the vector part is enough, the scalar part stays */
+                if(!_d->yUp) for(std::size_t i = 0; i != keyCount; ++i) {
+                    Vector3& vector = Vector3::from(keyValues + 4*i);
+                    vector = fixVectorZUp(vector);
+                }
+            } else if(singleAxis) {
+                for(std::size_t i = 0; i != keyCount; ++i)
+                    keyValues[i] *= _d->angleMultiplier*singleAxisSign;
+            } else valid = false;
+            break;
+
+        case AnimationTrack::Target::Scaling:
+            if((kind.empty() || kind == "xyz") && valueSize == 3) {
+                if(!_d->yUp) for(std::size_t i = 0; i != keyCount; ++i) {
+                    Vector3& v = Vector3::from(keyValues + 3*i);
+                    v = fixScalingZUp(v);
+                }
+            } else if(!singleAxis) valid = false;
+            break;
+
+        case AnimationTrack::Target::MorphWeight:
+            break;
+    }
+    if(!valid) {
+        Error() << "Trade::OpenGexImporter::animationTrack(): invalid key value size" << valueSize << "for the target";
+        return Containers::NullOpt;
+    }
+
+    return AnimationTrack{targetType, _d->structureId(_d->nodes, node), clip, interpolation, valueSize, std::move(data), &track};
+}
+
+namespace {
+
+template<class T> Containers::Array<UnsignedInt> extractBoneData2(const OpenDdl::Structure data) {
+    const Containers::ArrayView<const T> view = data.asArray<T>();
+    Containers::Array<UnsignedInt> out{Containers::NoInit, view.size()};
+    std::copy(view.begin(), view.end(), out.begin());
+    return out;
+}
+
+/* Bone counts and indices can be of any unsigned type except 64bit */
+bool extractBoneData(const OpenDdl::Structure data, Containers::Array<UnsignedInt>& out) {
+    switch(data.type()) {
+        case OpenDdl::Type::UnsignedByte:
+            out = extractBoneData2<UnsignedByte>(data);
+            return true;
+        case OpenDdl::Type::UnsignedShort:
+            out = extractBoneData2<UnsignedShort>(data);
+            return true;
+        case OpenDdl::Type::UnsignedInt:
+            out = extractBoneData2<UnsignedInt>(data);
+            return true;
+        #ifndef MAGNUM_TARGET_WEBGL
+        case OpenDdl::Type::UnsignedLong:
+            Error() << "Trade::OpenGexImporter::skin(): unsupported 64bit bone data";
+            return false;
+        #endif
+
+        default: CORRADE_ASSERT_UNREACHABLE(); /* LCOV_EXCL_LINE */
+    }
+}
+
+}
+
+Containers::Optional<OpenGexImporter::Skin> OpenGexImporter::skin(const UnsignedInt id) {
+    CORRADE_ASSERT(isOpened(), "Trade::OpenGexImporter::skin(): no file opened", {});
+    CORRADE_ASSERT(id < mesh3DCount(), "Trade::OpenGexImporter::skin(): index out of range", {});
+
+    const OpenDdl::Structure mesh = meshForLod(_d->meshes[id], meshLod(configuration()));
+    const Containers::Optional<OpenDdl::Structure> skin = mesh.findFirstChildOf(OpenGex::Skin);
+    if(!skin) {
+        Error() << "Trade::OpenGexImporter::skin(): the mesh has no skin";
+        return Containers::NullOpt;
+    }
+
+    /* Bind transformation of the mesh, identity if not present */
+    Matrix4 bindTransformation;
+    if(const Containers::Optional<OpenDdl::Structure> transform = skin->findFirstChildOf(OpenGex::Transform)) {
+        const OpenDdl::Structure data = transform->firstChild();
+        if(data.subArraySize() != 16 || data.arraySize() != 16) {
+            Error() << "Trade::OpenGexImporter::skin(): invalid bind transformation";
+            return Containers::NullOpt;
+        }
+
+        /* Parse the data, if that was deferred */
+        if(!data.parseData()) return Containers::NullOpt;
+
+        bindTransformation = fixTransformation(Matrix4::from(data.asArray<Float>()), _d->distanceMultiplier, _d->yUp);
+    }
+
+    /* Bone object IDs */
+    const OpenDdl::Structure skeleton = skin->firstChildOf(OpenGex::Skeleton);
+    const Containers::Array<Containers::Optional<OpenDdl::Structure>> boneReferences = skeleton.firstChildOf(OpenGex::BoneRefArray).firstChild().asReferenceArray();
+    std::vector<UnsignedInt> bones;
+    bones.reserve(boneReferences.size());
+    for(const Containers::Optional<OpenDdl::Structure>& bone: boneReferences) {
+        if(!bone || (bone->identifier() != OpenGex::Node &&
+                     bone->identifier() != OpenGex::BoneNode &&
+                     bone->identifier() != OpenGex::GeometryNode &&
+                     bone->identifier() != OpenGex::CameraNode &&
+                     bone->identifier() != OpenGex::LightNode))
+        {
+            Error() << "Trade::OpenGexImporter::skin(): invalid bone reference";
+            return Containers::NullOpt;
+        }
+
+        bones.push_back(_d->structureId(_d->nodes, *bone));
+    }
+
+    /* Bone bind transformations, one for each bone */
+    const OpenDdl::Structure boneTransformationData = skeleton.firstChildOf(OpenGex::Transform).firstChild();
+    if(boneTransformationData.subArraySize() != 16 || boneTransformationData.arraySize() != 16*bones.size()) {
+        Error() << "Trade::OpenGexImporter::skin(): invalid bone transformations";
+        return Containers::NullOpt;
+    }
+
+    /* Parse the data, if that was deferred */
+    if(!boneTransformationData.parseData()) return Containers::NullOpt;
+
+    std::vector<Matrix4> boneTransformations;
+    boneTransformations.reserve(bones.size());
+    for(std::size_t i = 0; i != bones.size(); ++i)
+        boneTransformations.push_back(fixTransformation(Matrix4::from(boneTransformationData.asArray<Float>() + 16*i), _d->distanceMultiplier, _d->yUp));
+
+    /* Per-vertex bone influences */
+    const OpenDdl::Structure boneCountData = skin->firstChildOf(OpenGex::BoneCountArray).firstChild();
+    const OpenDdl::Structure boneIndexData = skin->firstChildOf(OpenGex::BoneIndexArray).firstChild();
+    const OpenDdl::Structure boneWeightData = skin->firstChildOf(OpenGex::BoneWeightArray).firstChild();
+    if(boneCountData.subArraySize() > 1 || boneIndexData.subArraySize() > 1 || boneWeightData.subArraySize() > 1) {
+        Error() << "Trade::OpenGexImporter::skin(): invalid bone array subarray size";
+        return Containers::NullOpt;
+    }
+
+    /* Parse the data, if that was deferred */
+    if(!boneCountData.parseData() || !boneIndexData.parseData() || !boneWeightData.parseData())
+        return Containers::NullOpt;
+
+    Containers::Array<UnsignedInt> boneCounts, boneIndices;
+    if(!extractBoneData(boneCountData, boneCounts) || !extractBoneData(boneIndexData, boneIndices))
+        return Containers::NullOpt;
+
+    /* Convert the counts to offsets into the index and weight streams */
+    Containers::Array<UnsignedInt> boneOffsets{Containers::NoInit, boneCounts.size() + 1};
+    boneOffsets[0] = 0;
+    for(std::size_t i = 0; i != boneCounts.size(); ++i)
+        boneOffsets[i + 1] = boneOffsets[i] + boneCounts[i];
+    if(boneOffsets[boneCounts.size()] != boneIndices.size() || boneIndices.size() != boneWeightData.arraySize()) {
+        Error() << "Trade::OpenGexImporter::skin(): mismatched bone count, index and weight array sizes";
+        return Containers::NullOpt;
+    }
+    for(const UnsignedInt index: boneIndices) if(index >= bones.size()) {
+        Error() << "Trade::OpenGexImporter::skin(): bone index" << index << "out of range for" << bones.size() << "bones";
+        return Containers::NullOpt;
+    }
+
+    /* Weights are copied in bulk */
+    const Containers::ArrayView<const Float> weights = boneWeightData.asArray<Float>();
+    Containers::Array<Float> boneWeights{Containers::NoInit, weights.size()};
+    std::copy(weights.begin(), weights.end(), boneWeights.begin());
+
+    return Skin{bindTransformation, std::move(bones), std::move(boneTransformations), std::move(boneOffsets), std::move(boneIndices), std::move(boneWeights), &_d->meshes[id]};
+}
+
 const void* OpenGexImporter::doImporterState() const {
     return &_d->document;
 }
@@ -29,6 +29,9 @@
  * @brief Class @ref Magnum::Trade::OpenGexImporter
  */
 
+#include <vector>
+#include <Corrade/Containers/Array.h>
+#include <Magnum/Math/Matrix4.h>
 #include <Magnum/Trade/AbstractImporter.h>
 
 #include "MagnumPlugins/OpenGexImporter/visibility.h"
@@ -43,6 +46,8 @@ Imports the [OpenDDL](http://openddl.org)-based [OpenGEX](http://opengex.org)
 format.
 
 Supports importing of scene, object, camera, mesh, texture and image data.
+Animation and skin data are imported through plugin-specific APIs, see
+@ref Trade-OpenGexImporter-animation below.
 
 This plugin depends on the @ref Trade library and the @ref AnyImageImporter
 plugin. It is built if `WITH_OPENGEXIMPORTER` is enabled when building Magnum
@@ -55,7 +60,6 @@ and link to the `MagnumPlugins::OpenGexImporter` target. See
 
 @section Trade-OpenGexImporter-limitations Behavior and limitations
 
--   `half` data type results in parsing error.
 -   On OpenGL ES, usage of double type and on WebGL additionally also usage of
     64bit integer types results in parsing error.
 
@@ -66,6 +70,18 @@ and link to the `MagnumPlugins::OpenGexImporter` target. See
     are ignored.
 -   Geometry node visibility, shadow and motion blur properties are ignored.
 
+@subsection Trade-OpenGexImporter-limitations-animations Animation and skin import
+
+-   Only animations of nodes are imported, texture animations are ignored.
+-   Only the @cb{.ini} "value" @ce keys are imported, Bézier control points
+    and TCB parameters are ignored. The curve type is available through
+    @ref AnimationTrack::interpolation().
+-   Single-axis translation, rotation and scaling values keep the axis given
+    by the @cb{.ini} kind @ce property of the animated structure, see
+    @ref Trade-OpenGexImporter-animation for how they're converted from Z up.
+-   Animation begin and end times are ignored.
+-   64bit bone counts and indices are not supported.
+
 @subsection Trade-OpenGexImporter-limitations-lights Light import
 
 -   Light attenuation properties are not yet supported.
@@ -75,7 +91,11 @@ and link to the `MagnumPlugins::OpenGexImporter` target. See
 
 -   64bit indices are not supported.
 -   Quads are not supported.
--   Additional mesh LoDs after the first one are ignored.
+-   Only one mesh level of detail is imported for each geometry object, see
+    @ref Trade-OpenGexImporter-lod below.
+-   Half-float vertex data are converted to @ref Magnum::Float "Float", the
+    original packed data are accessible through the importer state, see
+    @ref Trade-OpenGexImporter-state below.
 -   `w` coordinate for vertex positions and normals is ignored if present.
 
 @subsection Trade-OpenGexImporter-limitations-materials Material import
@@ -99,6 +119,92 @@ and link to the `MagnumPlugins::OpenGexImporter` target. See
     present in the image list only once. Note that only a simple string
     comparison is used without any path normalization.
 
+@subsection Trade-OpenGexImporter-animation Animation and skin import
+
+There's no generic interface for animation and skin data in
+@ref AbstractImporter, so these are imported through functions specific to
+this plugin, available when using the plugin class directly, for example when
+linking it statically.
+
+Each @ref OpenGex::Track structure of all node animations is imported as a
+separate track, in order in which they appear in the file. Use
+@ref animationTrackCount() and @ref animationTrack() to access them. The key
+times and values of each track are stored in a single contiguous array, the
+times followed by the values, with the time metric applied to the times.
+
+The values are converted the same way as node transformations --- the
+distance metric is applied to transformation matrices and translations, the
+angle metric to rotation angles, and matrices, translation and scaling
+vectors, rotation axes and vector parts of quaternions are converted to Y up.
+Single-axis values can't change their axis, so for files with Z up the
+@cb{.ini} "x" @ce, @cb{.ini} "y" @ce and @cb{.ini} "z" @ce kinds of the
+animated structure correspond to the X, Z and Y axis, with translations and
+rotation angles along the @cb{.ini} "y" @ce axis negated. A track with value
+size not matching the animated structure fails to import.
+
+Skin of a mesh is imported using @ref skin(). Bones are referenced using their
+object IDs, per-vertex bone influences are stored as packed streams of bone
+indices and weights, with an offset table pointing to the first influence of
+each vertex. Bind transformations are converted to Y up and the distance
+metric is applied to them the same way as with node transformations.
+
+@subsection Trade-OpenGexImporter-parallel Parallel parsing
+
+Large files can be parsed on multiple threads by setting the
+@cb{.ini} threadCount @ce option in the @cb{.ini} [configuration] @ce group of
+the plugin configuration before opening the file. The file is split between
+top-level structures and the parts are parsed in parallel, see
+@ref OpenDdl::Document::parse() for details. The option is documented in the
+`OpenGexImporter.conf` file.
+
+@subsection Trade-OpenGexImporter-lazy Lazy parsing
+
+When only a part of a large file is needed, for example just the scene
+hierarchy, it's possible to defer parsing of large data lists such as vertex
+and index arrays to the time they're accessed by setting the
+@cb{.ini} lazyParsingThreshold @ce option in the @cb{.ini} [configuration] @ce
+group to the minimal size of a deferred list in bytes. Only the size of these
+lists is calculated when opening the file, errors in their contents are
+reported on first access, e.g. from @ref mesh3D(). The importer keeps a copy of
+the file data in that case, see @ref OpenDdl::Document::setLazyParsingThreshold()
+for details.
+
+@subsection Trade-OpenGexImporter-presize Memory usage
+
+By default the storage for parsed data grows as the file is parsed, which can
+temporarily take up to twice the memory of the final document. Enabling the
+@cb{.ini} presizeStorage @ce option in the @cb{.ini} [configuration] @ce group
+makes the importer scan the file first and allocate everything at once,
+trading parsing speed for lower peak memory usage. See
+@ref OpenDdl::Document::setPresizeStorage() for details.
+
+@subsection Trade-OpenGexImporter-lod Mesh levels of detail
+
+Each geometry object is imported as a single mesh. If it contains multiple
+meshes with different @cb{.ini} lod @ce properties, the one with the largest
+level of detail not larger than the @cb{.ini} lod @ce option in the
+@cb{.ini} [configuration] @ce group is imported, falling back to the most
+detailed one. The option is read on every @ref mesh3D() call, so different
+levels can be imported from a single opened file. Combined with lazy parsing,
+data of the levels that are not imported are never parsed.
+
+@subsection Trade-OpenGexImporter-cache Binary cache
+
+When a file is opened using @ref openFile() and the @cb{.ini} cacheExtension @ce
+configuration option is set, the parsed document is saved next to the file in
+a binary form using @ref OpenDdl::Document::serialize(), with given extension
+appended to the filename. Next time the file is opened, the cache is loaded
+instead of parsing the file again, which is significantly faster for large
+files. The cache is keyed by size and hash of the original file, so it's
+regenerated when the original file changes. The cache is specific to given
+platform and plugin version; if it can't be loaded, the file is parsed again
+and the cache overwritten. Files opened using @ref openData() are not cached.
+
+Loading the cache is a fast load, not a zero-copy memory mapping --- all
+document data are copied out of the cache file into the document, so the
+time and memory needed for opening still grows with the document size, just
+with a much smaller constant than parsing.
+
 @subsection Trade-OpenGexImporter-state Access to internal importer state
 
 Generic importer for OpenDDL files is implemented in the @ref OpenDdl::Document
@@ -115,10 +221,16 @@ importer-specific data accessors:
     -   @ref TextureData::importerState() returns @ref OpenGex::Texture
         structure
     -   @ref MeshData3D::importerState() returns @ref OpenGex::GeometryObject
-        structure
+        structure. Half-float vertex data are stored in the document packed,
+        their @ref OpenDdl::Type::Half data lists are accessible via
+        @ref OpenDdl::Structure::asArray() with @ref OpenDdl::Half as the type.
     -   @ref ObjectData3D::importerState() returns @ref OpenGex::Node,
         @ref OpenGex::BoneNode, @ref OpenGex::GeometryNode,
         @ref OpenGex::CameraNode or @ref OpenGex::LightNode structure
+    -   @ref AnimationTrack::importerState() returns @ref OpenGex::Track
+        structure
+    -   @ref Skin::importerState() returns @ref OpenGex::GeometryObject
+        structure the skin belongs to
 */
 class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT OpenGexImporter: public AbstractImporter {
     public:
@@ -141,8 +253,39 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT OpenGexImporter: public AbstractImport
         /** @brief Plugin manager constructor */
         explicit OpenGexImporter(PluginManager::AbstractManager& manager, const std::string& plugin);
 
+        class AnimationTrack;
+        class Skin;
+
         ~OpenGexImporter();
 
+        /**
+         * @brief Animation track count
+         *
+         * Expects that a file is opened. See
+         * @ref Trade-OpenGexImporter-animation for more information.
+         */
+        UnsignedInt animationTrackCount() const;
+
+        /**
+         * @brief Animation track
+         * @param id    Animation track ID, from range [0, @ref animationTrackCount()).
+         *
+         * Expects that a file is opened. Returns given track or
+         * @ref Containers::NullOpt if the track is invalid.
+         */
+        Containers::Optional<AnimationTrack> animationTrack(UnsignedInt id);
+
+        /**
+         * @brief Mesh skin
+         * @param id    Mesh ID, from range [0, @ref mesh3DCount()).
+         *
+         * Expects that a file is opened. Returns skin of the same mesh level
+         * of detail that is imported by @ref mesh3D() or
+         * @ref Containers::NullOpt if the mesh has no skin or the skin is
+         * invalid.
+         */
+        Containers::Optional<Skin> skin(UnsignedInt id);
+
         /**
          * @brief Importer state
          *
@@ -163,6 +306,9 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT OpenGexImporter: public AbstractImport
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL void doClose() override;
 
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL void openInternal(std::unique_ptr<Document> d);
+        MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL void openFileCached(const std::string& filename, const std::string& cacheFilename);
+
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL Int doDefaultScene() override;
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL UnsignedInt doSceneCount() const override;
         MAGNUM_TRADE_OPENGEXIMPORTER_LOCAL Containers::Optional<SceneData> doScene(UnsignedInt id) override;
@@ -197,6 +343,178 @@ class MAGNUM_TRADE_OPENGEXIMPORTER_EXPORT OpenGexImporter: public AbstractImport
         std::unique_ptr<Document> _d;
 };
 
+/**
+@brief OpenGEX animation track
+
+Track of an @ref OpenGex::Animation structure. See
+@ref Trade-OpenGexImporter-animation for more information.
+@see @ref OpenGexImporter::animationTrack()
+*/
+class OpenGexImporter::AnimationTrack {
+    public:
+        /** @brief Animated structure */
+        enum class Target: UnsignedByte {
+            Transformation, /**< @ref OpenGex::Transform structure */
+            Translation,    /**< @ref OpenGex::Translation structure */
+            Rotation,       /**< @ref OpenGex::Rotation structure */
+            Scaling,        /**< @ref OpenGex::Scale structure */
+            MorphWeight     /**< @ref OpenGex::MorphWeight structure */
+        };
+
+        /** @brief Value interpolation */
+        enum class Interpolation: UnsignedByte {
+            Constant,   /**< Constant */
+            Linear,     /**< Linear */
+            Bezier,     /**< Bézier curve */
+            Tcb         /**< Tension-continuity-bias spline */
+        };
+
+        /**
+         * @brief Constructor
+         * @param target        Animated structure
+         * @param object        Object ID of the animated node
+         * @param clip          Animation clip index
+         * @param interpolation Value interpolation
+         * @param valueSize     Count of components of each value
+         * @param data          Key times followed by key values
+         * @param importerState Importer-specific state
+         */
+        explicit AnimationTrack(Target target, UnsignedInt object, UnsignedInt clip, Interpolation interpolation, UnsignedInt valueSize, Containers::Array<Float>&& data, const void* importerState = nullptr) noexcept: _target{target}, _interpolation{interpolation}, _object{object}, _clip{clip}, _valueSize{valueSize}, _data{std::move(data)}, _importerState{importerState} {}
+
+        /** @brief Animated structure */
+        Target target() const { return _target; }
+
+        /** @brief Object ID of the animated node */
+        UnsignedInt object() const { return _object; }
+
+        /** @brief Animation clip index */
+        UnsignedInt clip() const { return _clip; }
+
+        /** @brief Value interpolation */
+        Interpolation interpolation() const { return _interpolation; }
+
+        /** @brief Key count */
+        std::size_t keyCount() const { return _data.size()/(_valueSize + 1); }
+
+        /** @brief Count of components of each value */
+        UnsignedInt valueSize() const { return _valueSize; }
+
+        /** @brief Key times */
+        Containers::ArrayView<const Float> times() const {
+            return _data.prefix(keyCount());
+        }
+
+        /**
+         * @brief Key values
+         *
+         * Contains @ref keyCount() values, each consisting of
+         * @ref valueSize() components.
+         */
+        Containers::ArrayView<const Float> values() const {
+            return _data.suffix(keyCount());
+        }
+
+        /**
+         * @brief Importer-specific state
+         *
+         * Returns pointer to the @ref OpenGex::Track structure.
+         */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        Target _target;
+        Interpolation _interpolation;
+        UnsignedInt _object, _clip, _valueSize;
+        Containers::Array<Float> _data;
+        const void* _importerState;
+};
+
+/**
+@brief OpenGEX mesh skin
+
+Contents of an @ref OpenGex::Skin structure. See
+@ref Trade-OpenGexImporter-animation for more information.
+@see @ref OpenGexImporter::skin()
+*/
+class OpenGexImporter::Skin {
+    public:
+        /**
+         * @brief Constructor
+         * @param bindTransformation    Bind transformation of the mesh
+         * @param bones                 Object IDs of the bones
+         * @param boneTransformations   Bind transformations of the bones
+         * @param boneOffsets           Offsets of first bone influence of
+         *      each vertex, with one additional item at the end
+         * @param boneIndices           Bone indices of all influences
+         * @param boneWeights           Bone weights of all influences
+         * @param importerState         Importer-specific state
+         */
+        explicit Skin(const Matrix4& bindTransformation, std::vector<UnsignedInt> bones, std::vector<Matrix4> boneTransformations, Containers::Array<UnsignedInt>&& boneOffsets, Containers::Array<UnsignedInt>&& boneIndices, Containers::Array<Float>&& boneWeights, const void* importerState = nullptr) noexcept: _bindTransformation{bindTransformation}, _bones{std::move(bones)}, _boneTransformations{std::move(boneTransformations)}, _boneOffsets{std::move(boneOffsets)}, _boneIndices{std::move(boneIndices)}, _boneWeights{std::move(boneWeights)}, _importerState{importerState} {}
+
+        /** @brief Bind transformation of the mesh */
+        Matrix4 bindTransformation() const { return _bindTransformation; }
+
+        /** @brief Object IDs of the bones */
+        const std::vector<UnsignedInt>& bones() const { return _bones; }
+
+        /**
+         * @brief Bind transformations of the bones
+         *
+         * Same size as @ref bones().
+         */
+        const std::vector<Matrix4>& boneTransformations() const {
+            return _boneTransformations;
+        }
+
+        /** @brief Vertex count */
+        std::size_t vertexCount() const { return _boneOffsets.size() - 1; }
+
+        /**
+         * @brief Bone influence offsets
+         *
+         * Contains @ref vertexCount() plus one items. Influences of vertex
+         * @f$ i @f$ are in range @f$ [ o_i, o_{i + 1} ) @f$ of
+         * @ref boneIndices() and @ref boneWeights().
+         */
+        Containers::ArrayView<const UnsignedInt> boneOffsets() const {
+            return _boneOffsets;
+        }
+
+        /**
+         * @brief Bone indices
+         *
+         * Indices into @ref bones().
+         */
+        Containers::ArrayView<const UnsignedInt> boneIndices() const {
+            return _boneIndices;
+        }
+
+        /**
+         * @brief Bone weights
+         *
+         * Same size as @ref boneIndices().
+         */
+        Containers::ArrayView<const Float> boneWeights() const {
+            return _boneWeights;
+        }
+
+        /**
+         * @brief Importer-specific state
+         *
+         * Returns pointer to the @ref OpenGex::GeometryObject structure the
+         * skin belongs to.
+         */
+        const void* importerState() const { return _importerState; }
+
+    private:
+        Matrix4 _bindTransformation;
+        std::vector<UnsignedInt> _bones;
+        std::vector<Matrix4> _boneTransformations;
+        Containers::Array<UnsignedInt> _boneOffsets, _boneIndices;
+        Containers::Array<Float> _boneWeights;
+        const void* _importerState;
+};
+
 }}
 
 #endif
@@ -24,11 +24,13 @@
 */
 
 #include <sstream>
-#include <Corrade/Containers/ArrayView.h>
+#include <Corrade/Containers/Array.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/Mesh.h>
+#include <Magnum/Math/Matrix4.h>
 #include <Magnum/Math/Quaternion.h>
 #include <Magnum/Math/Vector3.h>
 #include <Magnum/Trade/ImageData.h>
@@ -60,6 +62,10 @@ struct OpenGexImporterTest: public TestSuite::Tester {
     void openParseError();
     void openValidationError();
     void openInvalidMetric();
+    void openParallel();
+    void openCached();
+    void openLazy();
+    void openPresized();
 
     void camera();
     void cameraMetrics();
@@ -83,6 +89,9 @@ struct OpenGexImporterTest: public TestSuite::Tester {
     void meshIndexed();
     void meshEnlargeShrink();
     void meshMetrics();
+    void meshHalf();
+    void meshEmpty();
+    void meshLod();
 
     void meshInvalidPrimitive();
     void meshUnsupportedSize();
@@ -93,6 +102,22 @@ struct OpenGexImporterTest: public TestSuite::Tester {
     void meshUnsupportedIndexType();
     #endif
 
+    void animationTrack();
+    void animationTrackMetrics();
+    void animationTrackInvalidTarget();
+    void animationTrackInvalidTargetType();
+    void animationTrackNoValueKey();
+    void animationTrackMismatchedKeyCount();
+    void animationTrackUnsupportedCurve();
+    void animationTrackInvalidValueSize();
+
+    void skin();
+    void skinNoSkin();
+    void skinInvalidBoneReference();
+    void skinInvalidBoneTransformations();
+    void skinMismatchedSizes();
+    void skinBoneIndexOutOfRange();
+
     void materialDefaults();
     void materialColors();
     void materialTextured();
@@ -113,6 +138,10 @@ OpenGexImporterTest::OpenGexImporterTest() {
               &OpenGexImporterTest::openParseError,
               &OpenGexImporterTest::openValidationError,
               &OpenGexImporterTest::openInvalidMetric,
+              &OpenGexImporterTest::openParallel,
+              &OpenGexImporterTest::openCached,
+              &OpenGexImporterTest::openLazy,
+              &OpenGexImporterTest::openPresized,
 
               &OpenGexImporterTest::camera,
               &OpenGexImporterTest::cameraMetrics,
@@ -136,6 +165,9 @@ OpenGexImporterTest::OpenGexImporterTest() {
               &OpenGexImporterTest::meshIndexed,
               &OpenGexImporterTest::meshEnlargeShrink,
               &OpenGexImporterTest::meshMetrics,
+              &OpenGexImporterTest::meshHalf,
+              &OpenGexImporterTest::meshEmpty,
+              &OpenGexImporterTest::meshLod,
 
               &OpenGexImporterTest::meshInvalidPrimitive,
               &OpenGexImporterTest::meshUnsupportedSize,
@@ -146,6 +178,22 @@ OpenGexImporterTest::OpenGexImporterTest() {
               &OpenGexImporterTest::meshUnsupportedIndexType,
               #endif
 
+              &OpenGexImporterTest::animationTrack,
+              &OpenGexImporterTest::animationTrackMetrics,
+              &OpenGexImporterTest::animationTrackInvalidTarget,
+              &OpenGexImporterTest::animationTrackInvalidTargetType,
+              &OpenGexImporterTest::animationTrackNoValueKey,
+              &OpenGexImporterTest::animationTrackMismatchedKeyCount,
+              &OpenGexImporterTest::animationTrackUnsupportedCurve,
+              &OpenGexImporterTest::animationTrackInvalidValueSize,
+
+              &OpenGexImporterTest::skin,
+              &OpenGexImporterTest::skinNoSkin,
+              &OpenGexImporterTest::skinInvalidBoneReference,
+              &OpenGexImporterTest::skinInvalidBoneTransformations,
+              &OpenGexImporterTest::skinMismatchedSizes,
+              &OpenGexImporterTest::skinBoneIndexOutOfRange,
+
               &OpenGexImporterTest::materialDefaults,
               &OpenGexImporterTest::materialColors,
               &OpenGexImporterTest::materialTextured,
@@ -213,6 +261,114 @@ Metric (key = "distance") { string { "0.5" } }
     CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::openData(): invalid value for distance metric\n");
 }
 
+void OpenGexImporterTest::openParallel() {
+    OpenGexImporter importer;
+    importer.configuration().setValue("threadCount", 4);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "object.ogex")));
+    CORRADE_COMPARE(importer.sceneCount(), 1);
+    CORRADE_COMPARE(importer.object3DCount(), 5);
+
+    Containers::Optional<Trade::SceneData> scene = importer.scene(0);
+    CORRADE_VERIFY(scene);
+    CORRADE_COMPARE(scene->children3D(), (std::vector<UnsignedInt>{0, 3}));
+
+    std::unique_ptr<Trade::ObjectData3D> boneObject = importer.object3D(3);
+    CORRADE_VERIFY(boneObject);
+    CORRADE_COMPARE(boneObject->children(), (std::vector<UnsignedInt>{4}));
+}
+
+void OpenGexImporterTest::openCached() {
+    const std::string filename = Utility::Directory::join(OPENGEXIMPORTER_WRITE_TEST_DIR, "cached.ogex");
+    const std::string cacheFilename = filename + ".cache";
+    if(Utility::Directory::fileExists(cacheFilename))
+        CORRADE_VERIFY(Utility::Directory::rm(cacheFilename));
+    CORRADE_VERIFY(Utility::Directory::write(filename, Utility::Directory::read(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "object.ogex"))));
+
+    /* First time the file is parsed and the cache is created */
+    OpenGexImporter importer;
+    importer.configuration().setValue("cacheExtension", ".cache");
+    CORRADE_VERIFY(importer.openFile(filename));
+    CORRADE_COMPARE(importer.object3DCount(), 5);
+    CORRADE_VERIFY(Utility::Directory::fileExists(cacheFilename));
+    const Containers::Array<char> cache = Utility::Directory::read(cacheFilename);
+
+    /* Second time the cache is loaded and left untouched */
+    CORRADE_VERIFY(importer.openFile(filename));
+    CORRADE_COMPARE(importer.object3DCount(), 5);
+    {
+        Containers::Optional<Trade::SceneData> scene = importer.scene(0);
+        CORRADE_VERIFY(scene);
+        CORRADE_COMPARE(scene->children3D(), (std::vector<UnsignedInt>{0, 3}));
+    }
+    {
+        const Containers::Array<char> cache2 = Utility::Directory::read(cacheFilename);
+        CORRADE_COMPARE(std::string(cache2, cache2.size()), std::string(cache, cache.size()));
+    }
+
+    /* Changed file makes the cache stale, it gets parsed and recreated */
+    CORRADE_VERIFY(Utility::Directory::write(filename, Utility::Directory::read(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "camera.ogex"))));
+    CORRADE_VERIFY(importer.openFile(filename));
+    CORRADE_COMPARE(importer.object3DCount(), 0);
+    CORRADE_COMPARE(importer.cameraCount(), 2);
+    {
+        const Containers::Array<char> cache2 = Utility::Directory::read(cacheFilename);
+        CORRADE_VERIFY(std::string(cache2, cache2.size()) != std::string(cache, cache.size()));
+    }
+
+    /* Corrupted cache matching the file is reported and the file is parsed
+       again */
+    {
+        Containers::Array<char> corrupted = Utility::Directory::read(cacheFilename);
+        corrupted[16] = 'X';
+        CORRADE_VERIFY(Utility::Directory::write(cacheFilename, corrupted));
+    }
+    std::ostringstream out;
+    {
+        Error redirectError{&out};
+        CORRADE_VERIFY(importer.openFile(filename));
+    }
+    CORRADE_COMPARE(importer.cameraCount(), 2);
+    CORRADE_COMPARE(out.str(), "OpenDdl::Document::deserialize(): invalid signature\n");
+}
+
+void OpenGexImporterTest::openLazy() {
+    OpenGexImporter importer;
+    importer.configuration().setValue("lazyParsingThreshold", 1);
+
+    /* The importer should keep its own copy of the data */
+    {
+        Containers::Array<char> data = Utility::Directory::read(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "mesh.ogex"));
+        CORRADE_VERIFY(importer.openData(data));
+        for(char& c: data) c = ' ';
+    }
+
+    Containers::Optional<Trade::MeshData3D> mesh = importer.mesh3D(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positionArrayCount(), 1);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {0.0f, 1.0f, 3.0f}, {-1.0f, 2.0f, 2.0f}, {3.0f, 3.0f, 1.0f}, {5.0f, 7.0f, 0.5f}
+    }));
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{
+        2, 0, 1, 1, 2, 3
+    }));
+}
+
+void OpenGexImporterTest::openPresized() {
+    OpenGexImporter importer;
+    importer.configuration().setValue("presizeStorage", true);
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "mesh.ogex")));
+
+    Containers::Optional<Trade::MeshData3D> mesh = importer.mesh3D(1);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positionArrayCount(), 1);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {0.0f, 1.0f, 3.0f}, {-1.0f, 2.0f, 2.0f}, {3.0f, 3.0f, 1.0f}, {5.0f, 7.0f, 0.5f}
+    }));
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{
+        2, 0, 1, 1, 2, 3
+    }));
+}
+
 void OpenGexImporterTest::camera() {
     OpenGexImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "camera.ogex")));
@@ -743,6 +899,67 @@ void OpenGexImporterTest::meshMetrics() {
     }));
 }
 
+void OpenGexImporterTest::meshHalf() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "mesh.ogex")));
+
+    Containers::Optional<Trade::MeshData3D> mesh = importer.mesh3D(3);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positionArrayCount(), 1);
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{
+        {0.5f, 1.0f, -2.0f}, {65504.0f, 0.0f, 0.25f}
+    }));
+    CORRADE_COMPARE(mesh->textureCoords2DArrayCount(), 1);
+    CORRADE_COMPARE(mesh->textureCoords2D(0), (std::vector<Vector2>{
+        {0.125f, 1.0f}, {0.0f, -0.5f}
+    }));
+
+    /* The packed data are available through the importer state */
+    CORRADE_VERIFY(mesh->importerState());
+    const OpenDdl::Structure data = static_cast<const OpenDdl::Structure*>(mesh->importerState())->firstChildOf(OpenGex::Mesh).firstChildOf(OpenGex::VertexArray).firstChild();
+    CORRADE_COMPARE(data.type(), OpenDdl::Type::Half);
+    CORRADE_COMPARE(data.arraySize(), 6);
+    CORRADE_COMPARE(UnsignedShort(data.asArray<OpenDdl::Half>()[3]), 0x7bff);
+}
+
+void OpenGexImporterTest::meshEmpty() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "mesh.ogex")));
+
+    Containers::Optional<Trade::MeshData3D> mesh = importer.mesh3D(4);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->positionArrayCount(), 1);
+    CORRADE_VERIFY(mesh->positions(0).empty());
+    CORRADE_COMPARE(mesh->normalArrayCount(), 1);
+    CORRADE_VERIFY(mesh->normals(0).empty());
+}
+
+void OpenGexImporterTest::meshLod() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "mesh-lod.ogex")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+
+    auto lodPosition = [&importer](UnsignedInt id) {
+        Containers::Optional<Trade::MeshData3D> mesh = importer.mesh3D(id);
+        return mesh ? mesh->positions(0).front().x() : -1.0f;
+    };
+
+    /* Most detailed level by default, falling back to the most detailed
+       available */
+    CORRADE_COMPARE(lodPosition(0), 0.0f);
+    CORRADE_COMPARE(lodPosition(1), 1.0f);
+
+    /* Exact match */
+    importer.configuration().setValue("lod", 1);
+    CORRADE_COMPARE(lodPosition(0), 1.0f);
+    CORRADE_COMPARE(lodPosition(1), 1.0f);
+
+    /* Largest available not larger than requested */
+    importer.configuration().setValue("lod", 5);
+    CORRADE_COMPARE(lodPosition(0), 2.0f);
+    CORRADE_COMPARE(lodPosition(1), 3.0f);
+}
+
 void OpenGexImporterTest::meshInvalidPrimitive() {
     OpenGexImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "mesh-invalid.ogex")));
@@ -811,6 +1028,277 @@ void OpenGexImporterTest::meshUnsupportedIndexType() {
 }
 #endif
 
+void OpenGexImporterTest::animationTrack() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 2);
+
+    /* Linear translation track, with the time metric applied */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(0);
+        CORRADE_VERIFY(track);
+        CORRADE_VERIFY(track->target() == OpenGexImporter::AnimationTrack::Target::Translation);
+        CORRADE_COMPARE(track->object(), 1);
+        CORRADE_COMPARE(importer.object3DName(track->object()), "Animated");
+        CORRADE_COMPARE(track->clip(), 3);
+        CORRADE_VERIFY(track->interpolation() == OpenGexImporter::AnimationTrack::Interpolation::Linear);
+        CORRADE_COMPARE(track->keyCount(), 3);
+        CORRADE_COMPARE(track->valueSize(), 1);
+        CORRADE_COMPARE((std::vector<Float>{track->times().begin(), track->times().end()}),
+            (std::vector<Float>{0.0f, 1.0f, 3.0f}));
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{1.0f, 2.0f, -3.0f}));
+        CORRADE_VERIFY(track->importerState());
+        CORRADE_COMPARE(static_cast<const OpenDdl::Structure*>(track->importerState())->identifier(), OpenGex::Track);
+    }
+
+    /* Bezier rotation track, only the values are imported */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(1);
+        CORRADE_VERIFY(track);
+        CORRADE_VERIFY(track->target() == OpenGexImporter::AnimationTrack::Target::Rotation);
+        CORRADE_COMPARE(track->object(), 1);
+        CORRADE_VERIFY(track->interpolation() == OpenGexImporter::AnimationTrack::Interpolation::Bezier);
+        CORRADE_COMPARE(track->keyCount(), 2);
+        CORRADE_COMPARE(track->valueSize(), 4);
+        CORRADE_COMPARE((std::vector<Float>{track->times().begin(), track->times().end()}),
+            (std::vector<Float>{0.5f, 2.0f}));
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{0.0f, 0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f}));
+    }
+}
+
+void OpenGexImporterTest::animationTrackMetrics() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation-metrics.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 8);
+
+    /* Transformation, translation scaled and converted to Y up, rotation
+       around X stays the same */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(0);
+        CORRADE_VERIFY(track);
+        CORRADE_VERIFY(track->target() == OpenGexImporter::AnimationTrack::Target::Transformation);
+        CORRADE_COMPARE(track->valueSize(), 16);
+        CORRADE_COMPARE(Matrix4::from(track->values().data()), Matrix4::translation({2.0f, 6.0f, -4.0f})*Matrix4::rotationX(90.0_degf));
+    }
+
+    /* Translation, scaled and converted to Y up */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(1);
+        CORRADE_VERIFY(track);
+        CORRADE_VERIFY(track->target() == OpenGexImporter::AnimationTrack::Target::Translation);
+        CORRADE_COMPARE(track->valueSize(), 3);
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{2.0f, 6.0f, -4.0f, -2.0f, 0.0f, -1.0f}));
+    }
+
+    /* Translation along Y, scaled and negated to apply along +Z */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(2);
+        CORRADE_VERIFY(track);
+        CORRADE_COMPARE(track->valueSize(), 1);
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{-3.0f}));
+    }
+
+    /* Axis-angle rotation, angle scaled and axis converted to Y up */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(3);
+        CORRADE_VERIFY(track);
+        CORRADE_VERIFY(track->target() == OpenGexImporter::AnimationTrack::Target::Rotation);
+        CORRADE_COMPARE(track->valueSize(), 4);
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{1.0f, 0.0f, 0.0f, -1.0f}));
+    }
+
+    /* Quaternion rotation, vector part converted to Y up */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(4);
+        CORRADE_VERIFY(track);
+        CORRADE_COMPARE(track->valueSize(), 4);
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{1.0f, 3.0f, -2.0f, 4.0f}));
+    }
+
+    /* Rotation around Z, only the angle is scaled */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(5);
+        CORRADE_VERIFY(track);
+        CORRADE_COMPARE(track->valueSize(), 1);
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{1.5f}));
+    }
+
+    /* Scaling, converted to Y up */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(6);
+        CORRADE_VERIFY(track);
+        CORRADE_VERIFY(track->target() == OpenGexImporter::AnimationTrack::Target::Scaling);
+        CORRADE_COMPARE(track->valueSize(), 3);
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{1.0f, 3.0f, 2.0f}));
+    }
+
+    /* Scaling along Y, unchanged */
+    {
+        Containers::Optional<OpenGexImporter::AnimationTrack> track = importer.animationTrack(7);
+        CORRADE_VERIFY(track);
+        CORRADE_COMPARE(track->valueSize(), 1);
+        CORRADE_COMPARE((std::vector<Float>{track->values().begin(), track->values().end()}),
+            (std::vector<Float>{4.0f}));
+    }
+}
+
+void OpenGexImporterTest::animationTrackInvalidTarget() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation-invalid.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 6);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.animationTrack(0));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::animationTrack(): invalid target\n");
+}
+
+void OpenGexImporterTest::animationTrackInvalidTargetType() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation-invalid.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 6);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.animationTrack(1));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::animationTrack(): invalid target\n");
+}
+
+void OpenGexImporterTest::animationTrackNoValueKey() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation-invalid.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 6);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.animationTrack(2));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::animationTrack(): missing key values\n");
+}
+
+void OpenGexImporterTest::animationTrackMismatchedKeyCount() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation-invalid.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 6);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.animationTrack(3));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::animationTrack(): mismatched time and value key count\n");
+}
+
+void OpenGexImporterTest::animationTrackUnsupportedCurve() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation-invalid.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 6);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.animationTrack(4));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::animationTrack(): unsupported value curve cubic\n");
+}
+
+void OpenGexImporterTest::animationTrackInvalidValueSize() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "animation-invalid.ogex")));
+    CORRADE_COMPARE(importer.animationTrackCount(), 6);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.animationTrack(5));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::animationTrack(): invalid key value size 2 for the target\n");
+}
+
+void OpenGexImporterTest::skin() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "skin.ogex")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+
+    Containers::Optional<OpenGexImporter::Skin> skin = importer.skin(0);
+    CORRADE_VERIFY(skin);
+
+    /* Distance metric is applied to the transformations */
+    CORRADE_COMPARE(skin->bindTransformation(), Matrix4::translation({2.0f, 4.0f, 6.0f}));
+    CORRADE_COMPARE(skin->bones(), (std::vector<UnsignedInt>{0, 1}));
+    CORRADE_COMPARE(skin->boneTransformations(), (std::vector<Matrix4>{
+        Matrix4{},
+        Matrix4::translation(Vector3::yAxis(1.0f))
+    }));
+
+    /* Bone counts converted to offsets into packed index and weight streams */
+    CORRADE_COMPARE(skin->vertexCount(), 3);
+    CORRADE_COMPARE((std::vector<UnsignedInt>{skin->boneOffsets().begin(), skin->boneOffsets().end()}),
+        (std::vector<UnsignedInt>{0, 1, 3, 3}));
+    CORRADE_COMPARE((std::vector<UnsignedInt>{skin->boneIndices().begin(), skin->boneIndices().end()}),
+        (std::vector<UnsignedInt>{1, 0, 1}));
+    CORRADE_COMPARE((std::vector<Float>{skin->boneWeights().begin(), skin->boneWeights().end()}),
+        (std::vector<Float>{1.0f, 0.25f, 0.75f}));
+    CORRADE_VERIFY(skin->importerState());
+    CORRADE_COMPARE(static_cast<const OpenDdl::Structure*>(skin->importerState())->identifier(), OpenGex::GeometryObject);
+}
+
+void OpenGexImporterTest::skinNoSkin() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "skin.ogex")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.skin(1));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::skin(): the mesh has no skin\n");
+}
+
+void OpenGexImporterTest::skinInvalidBoneReference() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "skin-invalid.ogex")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 4);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.skin(0));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::skin(): invalid bone reference\n");
+}
+
+void OpenGexImporterTest::skinInvalidBoneTransformations() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "skin-invalid.ogex")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 4);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.skin(1));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::skin(): invalid bone transformations\n");
+}
+
+void OpenGexImporterTest::skinMismatchedSizes() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "skin-invalid.ogex")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 4);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.skin(2));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::skin(): mismatched bone count, index and weight array sizes\n");
+}
+
+void OpenGexImporterTest::skinBoneIndexOutOfRange() {
+    OpenGexImporter importer;
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "skin-invalid.ogex")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 4);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(!importer.skin(3));
+    CORRADE_COMPARE(out.str(), "Trade::OpenGexImporter::skin(): bone index 1 out of range for 1 bones\n");
+}
+
 void OpenGexImporterTest::materialDefaults() {
     OpenGexImporter importer;
     CORRADE_VERIFY(importer.openFile(Utility::Directory::join(OPENGEXIMPORTER_TEST_DIR, "material.ogex")));
@@ -30,3 +30,4 @@
 #endif
 
 #define OPENGEXIMPORTER_TEST_DIR "${OPENGEXIMPORTER_TEST_DIR}"
+#define OPENGEXIMPORTER_WRITE_TEST_DIR "${OPENGEXIMPORTER_WRITE_TEST_DIR}"
@@ -29,9 +29,7 @@
 #ifndef DOXYGEN_GENERATING_OUTPUT
 namespace Magnum { namespace Trade { namespace OpenGex {
 
-/* Version 1.1.1 except for the following:
-    - Half types
-*/
+/* Version 1.1.1 */
 
 using namespace OpenDdl;
 using namespace OpenDdl::Validation;
@@ -200,7 +198,7 @@ const std::initializer_list<Validation::Structure> structureInfo{
                                    Type::UnsignedLong,
                                    Type::Long,
                                    #endif
-                                   /** @todo Half */
+                                   Type::Half,
                                    Type::Float,
                                    Type::Double,
                                    Type::String,
@@ -359,7 +357,7 @@ const std::initializer_list<Validation::Structure> structureInfo{
                                    {Extension, {}}}},
     {VertexArray,       Properties{{attrib, PropertyType::String, RequiredProperty},
                                    {morph, PropertyType::UnsignedInt, OptionalProperty}},
-                        Primitives{/** @todo half */
+                        Primitives{Type::Half,
                                    Type::Float,
                                    Type::Double}, 1, 0,
                         Structures{{Extension, {}}}}};
@@ -25,9 +25,11 @@
 
 #include "StanfordImporter.h"
 
-#include <fstream>
-#include <sstream>
+#include <algorithm>
+#include <cstring>
 #include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
+#include <Corrade/Utility/Directory.h>
 #include <Corrade/Utility/String.h>
 #include <Corrade/Utility/Endianness.h>
 #include <Magnum/Array.h>
@@ -35,36 +37,12 @@
 #include <Magnum/Math/Color.h>
 #include <Magnum/Trade/MeshData3D.h>
 
-namespace Magnum { namespace Trade {
-
-StanfordImporter::StanfordImporter() = default;
-
-StanfordImporter::StanfordImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
-
-StanfordImporter::~StanfordImporter() = default;
+/* Memory mapping is not available everywhere */
+#if (defined(CORRADE_TARGET_UNIX) && !defined(CORRADE_TARGET_EMSCRIPTEN)) || (defined(CORRADE_TARGET_WINDOWS) && !defined(CORRADE_TARGET_WINDOWS_RT))
+#define MAGNUM_STANFORDIMPORTER_USE_MAP
+#endif
 
-auto StanfordImporter::doFeatures() const -> Features { return Feature::OpenData; }
-
-bool StanfordImporter::doIsOpened() const { return !!_in; }
-
-void StanfordImporter::doClose() { _in = nullptr; }
-
-void StanfordImporter::doOpenFile(const std::string& filename) {
-    /* Open file in *binary* mode to avoid broken binary data (need to handle \r manually) */
-    std::unique_ptr<std::istream> in{new std::ifstream{filename, std::ifstream::binary}};
-    if(!in->good()) {
-        Error() << "Trade::ObjImporter::openFile(): cannot open file" << filename;
-        return;
-    }
-
-    _in = std::move(in);
-}
-
-void StanfordImporter::doOpenData(const Containers::ArrayView<const char> data) {
-    _in.reset(new std::istringstream{{data, data.size()}});
-}
-
-UnsignedInt StanfordImporter::doMesh3DCount() const { return 1; }
+namespace Magnum { namespace Trade {
 
 namespace {
 
@@ -200,19 +178,100 @@ inline void extractQuad(std::vector<UnsignedInt>& indices, const char* const buf
     });
 }
 
+/* Like std::getline(), but operating on a memory view */
+bool readLine(const Containers::ArrayView<const char> data, std::size_t& position, std::string& line) {
+    if(position >= data.size()) return false;
+
+    const char* const begin = data + position;
+    const char* const end = std::find(begin, data.end(), '\n');
+    line.assign(begin, end);
+    position = end - data.begin() + (end != data.end() ? 1 : 0);
+    return true;
+}
+
+}
+
+struct StanfordImporter::State {
+    /* Either a copy of the data or a memory-mapped file, the view points to
+       whichever is used */
+    Containers::Array<char> data;
+    #ifdef MAGNUM_STANFORDIMPORTER_USE_MAP
+    Containers::Array<const char, Utility::Directory::MapDeleter> mappedData;
+    #endif
+    Containers::ArrayView<const char> view;
+    std::size_t dataOffset;
+
+    FileFormat fileFormat;
+    UnsignedInt stride, vertexCount, faceCount;
+    Array3D<Type> componentTypes;
+    Vector3i componentOffsets;
+    Type faceSizeType, faceIndexType;
+    bool hasFaces;
+
+    UnsignedInt pointChunkSize, faceChunkSize;
+
+    /* Offsets of face chunks relative to the beginning of face data, filled
+       on first access as faces can have different sizes */
+    std::vector<std::size_t> faceChunkOffsets;
+};
+
+StanfordImporter::StanfordImporter() = default;
+
+StanfordImporter::StanfordImporter(PluginManager::AbstractManager& manager, const std::string& plugin): AbstractImporter{manager, plugin} {}
+
+StanfordImporter::~StanfordImporter() = default;
+
+auto StanfordImporter::doFeatures() const -> Features { return Feature::OpenData; }
+
+bool StanfordImporter::doIsOpened() const { return !!_state; }
+
+void StanfordImporter::doClose() { _state = nullptr; }
+
+void StanfordImporter::doOpenFile(const std::string& filename) {
+    std::unique_ptr<State> state{new State};
+
+    /* Map the file if possible so huge files don't need to be read whole into
+       memory, otherwise read it */
+    #ifdef MAGNUM_STANFORDIMPORTER_USE_MAP
+    state->mappedData = Utility::Directory::mapRead(filename);
+    if(!state->mappedData) {
+        Error() << "Trade::StanfordImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+    state->view = state->mappedData;
+    #else
+    if(!Utility::Directory::fileExists(filename)) {
+        Error() << "Trade::StanfordImporter::openFile(): cannot open file" << filename;
+        return;
+    }
+    state->data = Utility::Directory::read(filename);
+    state->view = state->data;
+    #endif
+
+    openInternal(std::move(state), "Trade::StanfordImporter::openFile():");
+}
+
+void StanfordImporter::doOpenData(const Containers::ArrayView<const char> data) {
+    std::unique_ptr<State> state{new State};
+    state->data = Containers::Array<char>{data.size()};
+    std::copy(data.begin(), data.end(), state->data.begin());
+    state->view = state->data;
+
+    openInternal(std::move(state), "Trade::StanfordImporter::openData():");
 }
 
-Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
-    _in->seekg(0);
+void StanfordImporter::openInternal(std::unique_ptr<State> state, const char* const prefix) {
+    const Containers::ArrayView<const char> data = state->view;
+    std::size_t position = 0;
 
     /* Check file signature */
     {
         std::string header;
-        std::getline(*_in, header);
+        readLine(data, position, header);
         header = Utility::String::rtrim(std::move(header));
         if(header != "ply") {
-            Error() << "Trade::StanfordImporter::mesh3D(): invalid file signature" << header;
-            return Containers::NullOpt;
+            Error() << prefix << "invalid file signature" << header;
+            return;
         }
     }
 
@@ -220,7 +279,7 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
     FileFormat fileFormat{};
     {
         std::string line;
-        while(std::getline(*_in, line)) {
+        while(readLine(data, position, line)) {
             std::vector<std::string> tokens = Utility::String::splitWithoutEmptyParts(line);
 
             /* Skip empty lines and comments */
@@ -228,13 +287,13 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                 continue;
 
             if(tokens[0] != "format") {
-                Error() << "Trade::StanfordImporter::mesh3D(): expected format line";
-                return Containers::NullOpt;
+                Error() << prefix << "expected format line";
+                return;
             }
 
             if(tokens.size() != 3) {
-                Error() << "Trade::StanfordImporter::mesh3D(): invalid format line" << line;
-                return Containers::NullOpt;
+                Error() << prefix << "invalid format line" << line;
+                return;
             }
 
             if(tokens[2] == "1.0") {
@@ -247,15 +306,15 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                 }
             }
 
-            Error() << "Trade::StanfordImporter::mesh3D(): unsupported file format" << tokens[1] << tokens[2];
-            return Containers::NullOpt;
+            Error() << prefix << "unsupported file format" << tokens[1] << tokens[2];
+            return;
         }
     }
 
     /* Check format line consistency */
     if(fileFormat == FileFormat{}) {
-        Error() << "Trade::StanfordImporter::mesh3D(): missing format line";
-        return Containers::NullOpt;
+        Error() << prefix << "missing format line";
+        return;
     }
 
     /* Parse rest of the header */
@@ -263,11 +322,12 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
     Array3D<Type> componentTypes;
     Type faceSizeType{}, faceIndexType{};
     Vector3i componentOffsets{-1};
+    bool hasFaces = false;
     {
         std::size_t componentOffset = 0;
         std::string line;
         PropertyType propertyType{};
-        while(std::getline(*_in, line)) {
+        while(readLine(data, position, line)) {
             std::vector<std::string> tokens = Utility::String::splitWithoutEmptyParts(line);
 
             /* Skip empty lines and comments */
@@ -286,18 +346,19 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                     propertyType = PropertyType::Vertex;
 
                 /* Face elements */
-                } else if(tokens.size() == 3 &&tokens[1] == "face") {
+                } else if(tokens.size() == 3 && tokens[1] == "face") {
                     #ifndef CORRADE_TARGET_ANDROID
                     faceCount = std::stoi(tokens[2]);
                     #else
                     faceCount = std::strtoul(tokens[2].data(), nullptr, 10);
                     #endif
                     propertyType = PropertyType::Face;
+                    hasFaces = true;
 
                 /* Something else */
                 } else {
-                    Error() << "Trade::StanfordImporter::mesh3D(): unknown element" << tokens[1];
-                    return Containers::NullOpt;
+                    Error() << prefix << "unknown element" << tokens[1];
+                    return;
                 }
 
             /* Element properties */
@@ -305,15 +366,15 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                 /* Vertex element properties */
                 if(propertyType == PropertyType::Vertex) {
                     if(tokens.size() != 3) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid vertex property line" << line;
-                        return Containers::NullOpt;
+                        Error() << prefix << "invalid vertex property line" << line;
+                        return;
                     }
 
                     /* Component type */
                     const Type componentType = parseType(tokens[1]);
                     if(componentType == Type{}) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid vertex component type" << tokens[1];
-                        return Containers::NullOpt;
+                        Error() << prefix << "invalid vertex component type" << tokens[1];
+                        return;
                     }
 
                     /* Component */
@@ -327,7 +388,7 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                         componentOffsets.z() = componentOffset;
                         componentTypes.z() = componentType;
                     }
-                    else Debug() << "Trade::StanfordImporter::mesh3D(): ignoring unknown vertex component" << tokens[2];
+                    else Debug() << prefix << "ignoring unknown vertex component" << tokens[2];
 
                     /* Add size of current component to total offset */
                     componentOffset += sizeOf(componentType);
@@ -335,26 +396,26 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
                 /* Face element properties */
                 } else if(propertyType == PropertyType::Face) {
                     if(tokens.size() != 5 || tokens[1] != "list" || tokens[4] != "vertex_indices") {
-                        Error() << "Trade::StanfordImporter::mesh3D(): unknown face property line" << line;
-                        return Containers::NullOpt;
+                        Error() << prefix << "unknown face property line" << line;
+                        return;
                     }
 
                     /* Face size type */
                     if((faceSizeType = parseType(tokens[2])) == Type{}) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid face size type" << tokens[2];
-                        return Containers::NullOpt;
+                        Error() << prefix << "invalid face size type" << tokens[2];
+                        return;
                     }
 
                     /* Face index type */
                     if((faceIndexType = parseType(tokens[3])) == Type{}) {
-                        Error() << "Trade::StanfordImporter::mesh3D(): invalid face index type" << tokens[3];
-                        return Containers::NullOpt;
+                        Error() << prefix << "invalid face index type" << tokens[3];
+                        return;
                     }
 
                 /* Unexpected property line */
                 } else if(propertyType != PropertyType::Ignored) {
-                    Error() << "Trade::StanfordImporter::mesh3D(): unexpected property line";
-                    return Containers::NullOpt;
+                    Error() << prefix << "unexpected property line";
+                    return;
                 }
 
             /* Header end */
@@ -363,8 +424,8 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
 
             /* Something else */
             } else {
-                Error() << "Trade::StanfordImporter::mesh3D(): unknown line" << line;
-                return Containers::NullOpt;
+                Error() << prefix << "unknown line" << line;
+                return;
             }
         }
 
@@ -373,58 +434,204 @@ Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(UnsignedInt) {
 
     /* Check header consistency */
     if((componentOffsets < Vector3i{0}).any()) {
-        Error() << "Trade::StanfordImporter::mesh3D(): incomplete vertex specification";
-        return Containers::NullOpt;
+        Error() << prefix << "incomplete vertex specification";
+        return;
     }
-    if(faceSizeType == Type{} || faceIndexType == Type{}) {
-        Error() << "Trade::StanfordImporter::mesh3D(): incomplete face specification";
-        return Containers::NullOpt;
+    if(hasFaces && (faceSizeType == Type{} || faceIndexType == Type{})) {
+        Error() << prefix << "incomplete face specification";
+        return;
     }
 
-    /* Parse vertices */
-    std::vector<Vector3> positions;
-    positions.reserve(vertexCount);
-    {
-        Containers::Array<char> buffer{stride};
-        for(std::size_t i = 0; i != vertexCount; ++i) {
-            _in->read(buffer, stride);
-            positions.emplace_back(
-                extract<Float>(buffer + componentOffsets.x(), fileFormat, componentTypes.x()),
-                extract<Float>(buffer + componentOffsets.y(), fileFormat, componentTypes.y()),
-                extract<Float>(buffer + componentOffsets.z(), fileFormat, componentTypes.z())
-            );
-        }
+    /* Save the parsed header, the data are parsed on demand */
+    state->dataOffset = position;
+    state->fileFormat = fileFormat;
+    state->stride = stride;
+    state->vertexCount = vertexCount;
+    state->faceCount = faceCount;
+    state->componentTypes = componentTypes;
+    state->componentOffsets = componentOffsets;
+    state->faceSizeType = faceSizeType;
+    state->faceIndexType = faceIndexType;
+    state->hasFaces = hasFaces;
+    state->pointChunkSize = configuration().value<UnsignedInt>("pointChunkSize");
+    state->faceChunkSize = configuration().value<UnsignedInt>("faceChunkSize");
+    _state = std::move(state);
+}
+
+UnsignedInt StanfordImporter::doMesh3DCount() const {
+    /* Point clouds can be split into vertex chunks, meshes into face chunks.
+       Empty point clouds and meshes are still a single (empty) mesh. */
+    if(!_state->hasFaces && _state->pointChunkSize && _state->vertexCount)
+        return (_state->vertexCount + _state->pointChunkSize - 1)/_state->pointChunkSize;
+    if(_state->hasFaces && _state->faceChunkSize && _state->faceCount)
+        return (_state->faceCount + _state->faceChunkSize - 1)/_state->faceChunkSize;
+
+    return 1;
+}
+
+Containers::Optional<MeshData3D> StanfordImporter::doMesh3D(const UnsignedInt id) {
+    const Containers::ArrayView<const char> data = _state->view;
+    const FileFormat fileFormat = _state->fileFormat;
+    const UnsignedInt stride = _state->stride;
+    const std::size_t faceDataOffset = _state->dataOffset + std::size_t(stride)*_state->vertexCount;
+
+    /* Vertex range to import. Point clouds can be split into chunks, meshes
+       are imported whole unless split into face chunks below. */
+    std::size_t vertexOffset = 0;
+    std::size_t vertexCount = _state->vertexCount;
+    if(!_state->hasFaces && _state->pointChunkSize) {
+        vertexOffset = std::size_t(id)*_state->pointChunkSize;
+        vertexCount = std::min<std::size_t>(_state->pointChunkSize, _state->vertexCount - vertexOffset);
     }
 
     /* Parse faces, reserve optimistically amount for all-triangle faces */
     std::vector<UnsignedInt> indices;
-    indices.reserve(faceCount*3);
-    {
-        /* Assuming max four four-byte indices per face */
-        char buffer[4*4];
-
+    if(_state->hasFaces) {
+        const Type faceSizeType = _state->faceSizeType;
+        const Type faceIndexType = _state->faceIndexType;
         const UnsignedInt faceSizeTypeSize = sizeOf(faceSizeType);
         const UnsignedInt faceIndexTypeSize = sizeOf(faceIndexType);
-        for(std::size_t i = 0; i != faceCount; ++i) {
+        const char* const faceDataEnd = data.end();
+
+        /* Face range to import */
+        std::size_t faceOffset = 0;
+        std::size_t faceCount = _state->faceCount;
+        const char* position = data + std::min(faceDataOffset, data.size());
+        if(_state->faceChunkSize) {
+            /* Find where each chunk starts, reading just the face sizes */
+            if(_state->faceChunkOffsets.empty()) {
+                std::vector<std::size_t> faceChunkOffsets;
+                faceChunkOffsets.reserve(doMesh3DCount());
+                const char* chunkPosition = position;
+                for(std::size_t i = 0; i != _state->faceCount; ++i) {
+                    if(i % _state->faceChunkSize == 0)
+                        faceChunkOffsets.push_back(chunkPosition - position);
+
+                    if(chunkPosition + faceSizeTypeSize > faceDataEnd) {
+                        Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+                        return Containers::NullOpt;
+                    }
+                    const UnsignedInt faceSize = extract<UnsignedInt>(chunkPosition, fileFormat, faceSizeType);
+                    if(faceSize < 3 || faceSize > 4) {
+                        Error() << "Trade::StanfordImporter::mesh3D(): unsupported face size" << faceSize;
+                        return Containers::NullOpt;
+                    }
+                    chunkPosition += faceSizeTypeSize + faceSize*faceIndexTypeSize;
+                }
+
+                _state->faceChunkOffsets = std::move(faceChunkOffsets);
+            }
+
+            faceOffset = std::size_t(id)*_state->faceChunkSize;
+            faceCount = std::min<std::size_t>(_state->faceChunkSize, _state->faceCount - faceOffset);
+            position += _state->faceChunkOffsets[id];
+        }
+
+        /* If the faces are triangles with uchar size and 32-bit indices in
+           machine endianness (such as in files produced by
+           StanfordSceneConverter), copy the indices directly until a face of
+           different size is encountered. The rest is parsed below. */
+        std::size_t i = 0;
+        if(faceSizeType == Type::UnsignedByte &&
+           (faceIndexType == Type::UnsignedInt || faceIndexType == Type::Int) &&
+           (fileFormat == FileFormat::BigEndian) == Utility::Endianness::isBigEndian())
+        {
+            constexpr std::size_t triangleSize = 1 + 3*sizeof(UnsignedInt);
+            const std::size_t count = std::min<std::size_t>(faceCount, (faceDataEnd - position)/triangleSize);
+            indices.resize(count*3);
+            UnsignedInt* out = indices.data();
+            for(; i != count && *position == 3; ++i, position += triangleSize, out += 3)
+                std::memcpy(out, position + 1, 3*sizeof(UnsignedInt));
+            indices.resize(i*3);
+        }
+
+        indices.reserve(faceCount*3);
+        for(; i != faceCount; ++i) {
             /* Get face size */
-            _in->read(buffer, faceSizeTypeSize);
-            const UnsignedInt faceSize = extract<UnsignedInt>(buffer, fileFormat, faceSizeType);
+            if(position + faceSizeTypeSize > faceDataEnd) {
+                Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+                return Containers::NullOpt;
+            }
+            const UnsignedInt faceSize = extractAndSkip<UnsignedInt>(position, fileFormat, faceSizeType);
             if(faceSize < 3 || faceSize > 4) {
                 Error() << "Trade::StanfordImporter::mesh3D(): unsupported face size" << faceSize;
                 return Containers::NullOpt;
             }
 
             /* Parse face indices */
-            if(!_in->read(buffer, faceIndexTypeSize*faceSize)) {
+            if(position + faceIndexTypeSize*faceSize > faceDataEnd) {
                 Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
                 return Containers::NullOpt;
             }
             faceSize == 3 ?
-                extractTriangle(indices, buffer, fileFormat, faceIndexType) :
-                extractQuad(indices, buffer, fileFormat, faceIndexType);
+                extractTriangle(indices, position, fileFormat, faceIndexType) :
+                extractQuad(indices, position, fileFormat, faceIndexType);
+            position += faceIndexTypeSize*faceSize;
+        }
+
+        /* For face chunks import only the range of vertices referenced by the
+           faces and make the indices relative to it */
+        if(_state->faceChunkSize) {
+            if(indices.empty()) {
+                vertexCount = 0;
+            } else {
+                const auto minmax = std::minmax_element(indices.begin(), indices.end());
+                if(*minmax.second >= _state->vertexCount) {
+                    Error() << "Trade::StanfordImporter::mesh3D(): index" << *minmax.second << "out of bounds for" << _state->vertexCount << "vertices";
+                    return Containers::NullOpt;
+                }
+
+                vertexOffset = *minmax.first;
+                vertexCount = *minmax.second - vertexOffset + 1;
+                for(UnsignedInt& index: indices) index -= UnsignedInt(vertexOffset);
+            }
         }
     }
 
+    /* Parse vertices in given range */
+    const Array3D<Type>& componentTypes = _state->componentTypes;
+    const Vector3i& componentOffsets = _state->componentOffsets;
+    std::vector<Vector3> positions;
+    {
+        if(_state->dataOffset + (vertexOffset + vertexCount)*stride > data.size()) {
+            Error() << "Trade::StanfordImporter::mesh3D(): file is too short";
+            return Containers::NullOpt;
+        }
+        const char* const vertexData = data + _state->dataOffset + vertexOffset*stride;
+
+        /* If the positions are consecutive floats in machine endianness
+           (such as in files produced by StanfordSceneConverter), copy them
+           directly -- all at once if there's nothing else in the vertex,
+           otherwise one vertex at a time */
+        if(componentOffsets.y() == componentOffsets.x() + 4 &&
+           componentOffsets.z() == componentOffsets.x() + 8 &&
+           componentTypes.x() == Type::Float &&
+           componentTypes.y() == Type::Float &&
+           componentTypes.z() == Type::Float &&
+           (fileFormat == FileFormat::BigEndian) == Utility::Endianness::isBigEndian())
+        {
+            positions.resize(vertexCount);
+            if(stride == sizeof(Vector3)) {
+                if(vertexCount) std::memcpy(positions.data(), vertexData, vertexCount*sizeof(Vector3));
+            } else for(std::size_t i = 0; i != vertexCount; ++i)
+                std::memcpy(positions[i].data(), vertexData + i*stride + componentOffsets.x(), sizeof(Vector3));
+        } else {
+            positions.reserve(vertexCount);
+            for(std::size_t i = 0; i != vertexCount; ++i) {
+                const char* const vertex = vertexData + i*stride;
+                positions.emplace_back(
+                    extract<Float>(vertex + componentOffsets.x(), fileFormat, componentTypes.x()),
+                    extract<Float>(vertex + componentOffsets.y(), fileFormat, componentTypes.y()),
+                    extract<Float>(vertex + componentOffsets.z(), fileFormat, componentTypes.z())
+                );
+            }
+        }
+    }
+
+    /* Vertex-only files are point clouds */
+    if(!_state->hasFaces)
+        return MeshData3D{MeshPrimitive::Points, {}, {std::move(positions)}, {}, {}, {}, nullptr};
+
     return MeshData3D{MeshPrimitive::Triangles, std::move(indices), {std::move(positions)}, {}, {}, {}, nullptr};
 }
 
@@ -58,6 +58,22 @@ namespace Magnum { namespace Trade {
 Supports little and big endian binary format (ASCII files are not supported),
 triangle/quad meshes. Only vertex positions are imported.
 
+Files without a `face` element are imported as point clouds with
+@ref MeshPrimitive::Points. The header is parsed when the file is opened and
+the data only when a mesh is requested. Files opened using @ref openFile() are
+memory-mapped on platforms that support it.
+
+Large files can be split into chunks by setting options in the
+@cb{.ini} [configuration] @ce group of the plugin configuration before opening
+the file. Point clouds are split into chunks of at most @cb{.ini} pointChunkSize @ce
+vertices, meshes into chunks of at most @cb{.ini} faceChunkSize @ce faces. Each
+chunk is then exposed as a separate mesh and decoded from the file only when
+requested. A face chunk contains only the range of vertices referenced by its
+faces, with indices relative to the beginning of that range. With spatially
+coherent data (such as most scans) it's thus possible to process files larger
+than available memory by importing one chunk after another. The options are
+documented in the `StanfordImporter.conf` file.
+
 This plugin depends on the @ref Trade library and is built if
 `WITH_STANFORDIMPORTER` is enabled when building Magnum Plugins. To use as a
 dynamic plugin, you need to load the @cpp "StanfordImporter" @ce plugin from
@@ -78,17 +94,20 @@ class MAGNUM_STANFORDIMPORTER_EXPORT StanfordImporter: public AbstractImporter {
         ~StanfordImporter();
 
     private:
+        struct State;
+
         MAGNUM_STANFORDIMPORTER_LOCAL Features doFeatures() const override;
 
         MAGNUM_STANFORDIMPORTER_LOCAL bool doIsOpened() const override;
         MAGNUM_STANFORDIMPORTER_LOCAL void doOpenData(Containers::ArrayView<const char> data) override;
         MAGNUM_STANFORDIMPORTER_LOCAL void doOpenFile(const std::string& filename) override;
         MAGNUM_STANFORDIMPORTER_LOCAL void doClose() override;
+        MAGNUM_STANFORDIMPORTER_LOCAL void openInternal(std::unique_ptr<State> state, const char* prefix);
 
         MAGNUM_STANFORDIMPORTER_LOCAL UnsignedInt doMesh3DCount() const override;
         MAGNUM_STANFORDIMPORTER_LOCAL Containers::Optional<MeshData3D> doMesh3D(UnsignedInt id) override;
 
-        std::unique_ptr<std::istream> _in;
+        std::unique_ptr<State> _state;
 };
 
 }}
@@ -25,7 +25,9 @@
 
 #include <sstream>
 #include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/ConfigurationGroup.h>
 #include <Corrade/Utility/Directory.h>
+#include <Magnum/Mesh.h>
 #include <Magnum/Math/Vector3.h>
 #include <Magnum/Trade/MeshData3D.h>
 
@@ -65,6 +67,13 @@ struct StanfordImporterTest: TestSuite::Tester {
     void bigEndian();
     void crlf();
     void ignoredVertexComponents();
+
+    void points();
+    void pointsChunked();
+    void pointsShortFile();
+
+    void faceChunked();
+    void faceChunkedIndexOutOfBounds();
 };
 
 StanfordImporterTest::StanfordImporterTest() {
@@ -94,7 +103,14 @@ StanfordImporterTest::StanfordImporterTest() {
               &StanfordImporterTest::common,
               &StanfordImporterTest::bigEndian,
               &StanfordImporterTest::crlf,
-              &StanfordImporterTest::ignoredVertexComponents});
+              &StanfordImporterTest::ignoredVertexComponents,
+
+              &StanfordImporterTest::points,
+              &StanfordImporterTest::pointsChunked,
+              &StanfordImporterTest::pointsShortFile,
+
+              &StanfordImporterTest::faceChunked,
+              &StanfordImporterTest::faceChunkedIndexOutOfBounds});
 }
 
 void StanfordImporterTest::invalidSignature() {
@@ -102,9 +118,14 @@ void StanfordImporterTest::invalidSignature() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-signature.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid file signature bla\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-signature.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid file signature bla\n");
+
+    /* Errors are reported under the function that was called */
+    out.str({});
+    const auto data = Utility::Directory::read(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-signature.ply"));
+    CORRADE_VERIFY(!importer.openData(data));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openData(): invalid file signature bla\n");
 }
 
 void StanfordImporterTest::invalidFormat() {
@@ -112,9 +133,8 @@ void StanfordImporterTest::invalidFormat() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-format.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid format line format binary_big_endian 1.0 extradata\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-format.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid format line format binary_big_endian 1.0 extradata\n");
 }
 
 void StanfordImporterTest::unsupportedFormat() {
@@ -122,9 +142,8 @@ void StanfordImporterTest::unsupportedFormat() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unsupported-format.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unsupported file format ascii 1.0\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unsupported-format.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unsupported file format ascii 1.0\n");
 }
 
 void StanfordImporterTest::missingFormat() {
@@ -132,9 +151,8 @@ void StanfordImporterTest::missingFormat() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "missing-format.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): missing format line\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "missing-format.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): missing format line\n");
 }
 
 void StanfordImporterTest::unknownLine() {
@@ -142,9 +160,8 @@ void StanfordImporterTest::unknownLine() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-line.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unknown line heh\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-line.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unknown line heh\n");
 }
 
 void StanfordImporterTest::unknownElement() {
@@ -152,9 +169,8 @@ void StanfordImporterTest::unknownElement() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-element.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unknown element edge\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-element.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unknown element edge\n");
 }
 
 void StanfordImporterTest::unexpectedProperty() {
@@ -162,9 +178,8 @@ void StanfordImporterTest::unexpectedProperty() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unexpected-property.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unexpected property line\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unexpected-property.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unexpected property line\n");
 }
 
 void StanfordImporterTest::invalidVertexProperty() {
@@ -172,9 +187,8 @@ void StanfordImporterTest::invalidVertexProperty() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-property.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid vertex property line property float x extradata\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-property.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid vertex property line property float x extradata\n");
 }
 
 void StanfordImporterTest::invalidVertexType() {
@@ -182,9 +196,8 @@ void StanfordImporterTest::invalidVertexType() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-type.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid vertex component type float16\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-vertex-type.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid vertex component type float16\n");
 }
 
 void StanfordImporterTest::unknownFaceProperty() {
@@ -192,9 +205,8 @@ void StanfordImporterTest::unknownFaceProperty() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-face-property.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): unknown face property line property float x\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "unknown-face-property.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): unknown face property line property float x\n");
 }
 
 void StanfordImporterTest::invalidFaceSizeType() {
@@ -202,9 +214,8 @@ void StanfordImporterTest::invalidFaceSizeType() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-size-type.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid face size type int128\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-size-type.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid face size type int128\n");
 }
 
 void StanfordImporterTest::invalidFaceIndexType() {
@@ -212,9 +223,8 @@ void StanfordImporterTest::invalidFaceIndexType() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-index-type.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): invalid face index type int128\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "invalid-face-index-type.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): invalid face index type int128\n");
 }
 
 void StanfordImporterTest::incompleteVertex() {
@@ -222,9 +232,8 @@ void StanfordImporterTest::incompleteVertex() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-vertex.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): incomplete vertex specification\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-vertex.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): incomplete vertex specification\n");
 }
 
 void StanfordImporterTest::incompleteFace() {
@@ -232,9 +241,8 @@ void StanfordImporterTest::incompleteFace() {
 
     std::ostringstream out;
     Error redirectError{&out};
-    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-face.ply")));
-    CORRADE_VERIFY(!importer.mesh3D(0));
-    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): incomplete face specification\n");
+    CORRADE_VERIFY(!importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "incomplete-face.ply")));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::openFile(): incomplete face specification\n");
 }
 
 void StanfordImporterTest::invalidFaceSize() {
@@ -331,6 +339,86 @@ void StanfordImporterTest::ignoredVertexComponents() {
     CORRADE_COMPARE(mesh->positions(0), positions);
 }
 
+void StanfordImporterTest::points() {
+    StanfordImporter importer;
+
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "points.ply")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 1);
+
+    auto mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Points);
+    CORRADE_VERIFY(!mesh->isIndexed());
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+void StanfordImporterTest::pointsChunked() {
+    StanfordImporter importer;
+    importer.configuration().setValue("pointChunkSize", 2);
+
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "points.ply")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 3);
+
+    /* Import in reverse order to verify the chunks are independent */
+    auto mesh2 = importer.mesh3D(2);
+    CORRADE_VERIFY(mesh2);
+    CORRADE_COMPARE(mesh2->primitive(), MeshPrimitive::Points);
+    CORRADE_COMPARE(mesh2->positions(0), (std::vector<Vector3>{positions[4]}));
+
+    auto mesh1 = importer.mesh3D(1);
+    CORRADE_VERIFY(mesh1);
+    CORRADE_COMPARE(mesh1->positions(0), (std::vector<Vector3>{positions[2], positions[3]}));
+
+    auto mesh0 = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh0);
+    CORRADE_COMPARE(mesh0->positions(0), (std::vector<Vector3>{positions[0], positions[1]}));
+}
+
+void StanfordImporterTest::pointsShortFile() {
+    StanfordImporter importer;
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "points-short-file.ply")));
+    CORRADE_VERIFY(!importer.mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): file is too short\n");
+}
+
+void StanfordImporterTest::faceChunked() {
+    StanfordImporter importer;
+    importer.configuration().setValue("faceChunkSize", 1);
+
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "common.ply")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 2);
+
+    /* Second face is a triangle referencing vertices 2 to 4, import it first
+       to verify the chunk offsets are calculated independently of import
+       order */
+    auto mesh1 = importer.mesh3D(1);
+    CORRADE_VERIFY(mesh1);
+    CORRADE_COMPARE(mesh1->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh1->indices(), (std::vector<UnsignedInt>{1, 0, 2}));
+    CORRADE_COMPARE(mesh1->positions(0), (std::vector<Vector3>{positions[2], positions[3], positions[4]}));
+
+    /* First face is a quad referencing vertices 0 to 3 */
+    auto mesh0 = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh0);
+    CORRADE_COMPARE(mesh0->indices(), (std::vector<UnsignedInt>{0, 1, 2, 0, 2, 3}));
+    CORRADE_COMPARE(mesh0->positions(0), (std::vector<Vector3>{positions[0], positions[1], positions[2], positions[3]}));
+}
+
+void StanfordImporterTest::faceChunkedIndexOutOfBounds() {
+    StanfordImporter importer;
+    importer.configuration().setValue("faceChunkSize", 2);
+
+    std::ostringstream out;
+    Error redirectError{&out};
+    CORRADE_VERIFY(importer.openFile(Utility::Directory::join(STANFORDIMPORTER_TEST_DIR, "face-index-out-of-bounds.ply")));
+    CORRADE_COMPARE(importer.mesh3DCount(), 1);
+    CORRADE_VERIFY(!importer.mesh3D(0));
+    CORRADE_COMPARE(out.str(), "Trade::StanfordImporter::mesh3D(): index 9 out of bounds for 5 vertices\n");
+}
+
 }}}
 
 CORRADE_TEST_MAIN(Magnum::Trade::Test::StanfordImporterTest)
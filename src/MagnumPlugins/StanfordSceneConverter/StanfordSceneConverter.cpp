@@ -0,0 +1,167 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include "StanfordSceneConverter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Utility/Assert.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Trade/MeshData3D.h>
+
+namespace Magnum { namespace Trade {
+
+namespace {
+
+template<class T> inline void writeAndSkip(char*& buffer, const T value) {
+    const T swapped = Utility::Endianness::littleEndian<T>(value);
+    std::memcpy(buffer, &swapped, sizeof(T));
+    buffer += sizeof(T);
+}
+
+inline void writeAndSkip(char*& buffer, const Vector3& value) {
+    writeAndSkip<Float>(buffer, value.x());
+    writeAndSkip<Float>(buffer, value.y());
+    writeAndSkip<Float>(buffer, value.z());
+}
+
+inline void writeAndSkip(char*& buffer, const Color4& value) {
+    for(std::size_t i = 0; i != 4; ++i)
+        *buffer++ = char(UnsignedByte(Math::clamp(value[i], 0.0f, 1.0f)*255.0f + 0.5f));
+}
+
+}
+
+StanfordSceneConverter::StanfordSceneConverter() = default;
+
+Containers::Array<char> StanfordSceneConverter::exportToData(const MeshData3D& mesh) const {
+    if(mesh.primitive() != MeshPrimitive::Triangles) {
+        Error() << "Trade::StanfordSceneConverter::exportToData(): expected triangle mesh, got" << mesh.primitive();
+        return nullptr;
+    }
+
+    const std::vector<Vector3>& positions = mesh.positions(0);
+
+    /* Only the first normal and color array is exported, they need to have
+       the same size as positions */
+    const std::vector<Vector3>* normals = nullptr;
+    if(mesh.normalArrayCount()) {
+        normals = &mesh.normals(0);
+        if(normals->size() != positions.size()) {
+            Error() << "Trade::StanfordSceneConverter::exportToData(): expected" << positions.size() << "normals but got" << normals->size();
+            return nullptr;
+        }
+    }
+    const std::vector<Color4>* colors = nullptr;
+    if(mesh.colorArrayCount()) {
+        colors = &mesh.colors(0);
+        if(colors->size() != positions.size()) {
+            Error() << "Trade::StanfordSceneConverter::exportToData(): expected" << positions.size() << "colors but got" << colors->size();
+            return nullptr;
+        }
+    }
+
+    const std::size_t indexCount = mesh.isIndexed() ? mesh.indices().size() : positions.size();
+    if(indexCount % 3) {
+        Error() << "Trade::StanfordSceneConverter::exportToData(): index count" << indexCount << "is not divisible by three";
+        return nullptr;
+    }
+
+    /* Header. Positions are always first so the importer can copy them
+       directly if there's nothing else in the vertex. */
+    std::string header;
+    {
+        std::ostringstream out;
+        out << "ply\n"
+               "format binary_little_endian 1.0\n"
+               "element vertex " << positions.size() << "\n"
+               "property float x\n"
+               "property float y\n"
+               "property float z\n";
+        if(normals) out <<
+               "property float nx\n"
+               "property float ny\n"
+               "property float nz\n";
+        if(colors) out <<
+               "property uchar red\n"
+               "property uchar green\n"
+               "property uchar blue\n"
+               "property uchar alpha\n";
+        out << "element face " << indexCount/3 << "\n"
+               "property list uchar uint vertex_indices\n"
+               "end_header\n";
+        header = out.str();
+    }
+
+    const std::size_t vertexSize = sizeof(Vector3) + (normals ? sizeof(Vector3) : 0) + (colors ? 4 : 0);
+    const std::size_t faceSize = 1 + 3*sizeof(UnsignedInt);
+    Containers::Array<char> data{header.size() + positions.size()*vertexSize + indexCount/3*faceSize};
+    std::copy(header.begin(), header.end(), data.begin());
+    char* out = data + header.size();
+
+    /* Vertices. If there are only positions and the machine is little-endian,
+       the data can be copied as a whole. */
+    if(!normals && !colors && !positions.empty() && !Utility::Endianness::isBigEndian()) {
+        std::memcpy(out, positions.data(), positions.size()*sizeof(Vector3));
+        out += positions.size()*sizeof(Vector3);
+    } else for(std::size_t i = 0; i != positions.size(); ++i) {
+        writeAndSkip(out, positions[i]);
+        if(normals) writeAndSkip(out, (*normals)[i]);
+        if(colors) writeAndSkip(out, (*colors)[i]);
+    }
+
+    /* Faces, non-indexed meshes get a trivial index buffer */
+    for(std::size_t i = 0; i != indexCount; i += 3) {
+        *out++ = 3;
+        for(std::size_t j = 0; j != 3; ++j)
+            writeAndSkip<UnsignedInt>(out, mesh.isIndexed() ? mesh.indices()[i + j] : UnsignedInt(i + j));
+    }
+
+    CORRADE_INTERNAL_ASSERT(out == data.end());
+    return data;
+}
+
+bool StanfordSceneConverter::exportToFile(const MeshData3D& mesh, const std::string& filename) const {
+    const auto data = exportToData(mesh);
+    if(!data) return false;
+
+    /* Open file */
+    std::ofstream out{filename, std::ofstream::binary};
+    if(!out.good()) {
+        Error() << "Trade::StanfordSceneConverter::exportToFile(): cannot write to file" << filename;
+        return false;
+    }
+
+    out.write(data, data.size());
+    return true;
+}
+
+}}
@@ -0,0 +1,99 @@
+#ifndef Magnum_Trade_StanfordSceneConverter_h
+#define Magnum_Trade_StanfordSceneConverter_h
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+/** @file
+ * @brief Class @ref Magnum::Trade::StanfordSceneConverter
+ */
+
+#include <string>
+#include <Corrade/Containers/Containers.h>
+#include <Corrade/Utility/VisibilityMacros.h>
+#include <Magnum/Trade/Trade.h>
+
+#include "MagnumPlugins/StanfordSceneConverter/configure.h"
+
+#ifndef DOXYGEN_GENERATING_OUTPUT
+#ifndef MAGNUM_STANFORDSCENECONVERTER_BUILD_STATIC
+    #ifdef MagnumStanfordSceneConverter_EXPORTS
+        #define MAGNUM_STANFORDSCENECONVERTER_EXPORT CORRADE_VISIBILITY_EXPORT
+    #else
+        #define MAGNUM_STANFORDSCENECONVERTER_EXPORT CORRADE_VISIBILITY_IMPORT
+    #endif
+#else
+    #define MAGNUM_STANFORDSCENECONVERTER_EXPORT CORRADE_VISIBILITY_STATIC
+#endif
+#else
+#define MAGNUM_STANFORDSCENECONVERTER_EXPORT
+#endif
+
+namespace Magnum { namespace Trade {
+
+/**
+@brief Stanford PLY converter
+
+Creates binary little-endian Stanford (`*.ply`) files from triangle meshes.
+Vertex positions are written as three @cpp float @ce properties at the
+beginning of each vertex, followed by normals (if present) and colors (if
+present, as four @cpp uchar @ce properties). Faces are written as a
+@cpp uchar @ce-sized list of @cpp uint @ce indices. Non-indexed meshes get a
+trivial index buffer. Only the first position, normal and color array is
+written, texture coordinates are ignored. The output can be read back with
+@ref StanfordImporter, which copies the positions and triangle indices
+directly instead of converting them component by component on
+little-endian machines.
+
+Magnum doesn't provide a scene converter plugin interface yet, so unlike other
+classes in this repository this is a regular library and not a plugin. It
+depends on the @ref Trade library and is built if `WITH_STANFORDSCENECONVERTER`
+is enabled when building Magnum Plugins. To use it with CMake, you need to
+request the `StanfordSceneConverter` component of the `MagnumPlugins` package
+and link to the `MagnumPlugins::StanfordSceneConverter` target. See
+@ref building-plugins and @ref cmake-plugins for more information.
+*/
+class MAGNUM_STANFORDSCENECONVERTER_EXPORT StanfordSceneConverter {
+    public:
+        /** @brief Default constructor */
+        explicit StanfordSceneConverter();
+
+        /**
+         * @brief Export mesh to raw data
+         *
+         * Returns data on success, zero-sized array otherwise.
+         */
+        Containers::Array<char> exportToData(const MeshData3D& mesh) const;
+
+        /**
+         * @brief Export mesh to file
+         *
+         * Returns @cpp true @ce on success, @cpp false @ce otherwise.
+         */
+        bool exportToFile(const MeshData3D& mesh, const std::string& filename) const;
+};
+
+}}
+
+#endif
@@ -0,0 +1,235 @@
+/*
+    This file is part of Magnum.
+
+    Copyright © 2010, 2011, 2012, 2013, 2014, 2015, 2016, 2017, 2018
+              Vladimír Vondruš <mosra@centrum.cz>
+
+    Permission is hereby granted, free of charge, to any person obtaining a
+    copy of this software and associated documentation files (the "Software"),
+    to deal in the Software without restriction, including without limitation
+    the rights to use, copy, modify, merge, publish, distribute, sublicense,
+    and/or sell copies of the Software, and to permit persons to whom the
+    Software is furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included
+    in all copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+    THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+    FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+    DEALINGS IN THE SOFTWARE.
+*/
+
+#include <cstring>
+#include <sstream>
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+#include <Corrade/Utility/Endianness.h>
+#include <Magnum/Mesh.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/Trade/MeshData3D.h>
+
+#include "MagnumPlugins/StanfordImporter/StanfordImporter.h"
+#include "MagnumPlugins/StanfordSceneConverter/StanfordSceneConverter.h"
+
+#include "configure.h"
+
+namespace Magnum { namespace Trade { namespace Test {
+
+struct StanfordSceneConverterTest: TestSuite::Tester {
+    explicit StanfordSceneConverterTest();
+
+    void wrongPrimitive();
+    void wrongNormalCount();
+    void wrongColorCount();
+    void wrongIndexCount();
+
+    void data();
+    void nonIndexed();
+    void normalsColors();
+    void file();
+};
+
+StanfordSceneConverterTest::StanfordSceneConverterTest() {
+    addTests({&StanfordSceneConverterTest::wrongPrimitive,
+              &StanfordSceneConverterTest::wrongNormalCount,
+              &StanfordSceneConverterTest::wrongColorCount,
+              &StanfordSceneConverterTest::wrongIndexCount,
+
+              &StanfordSceneConverterTest::data,
+              &StanfordSceneConverterTest::nonIndexed,
+              &StanfordSceneConverterTest::normalsColors,
+              &StanfordSceneConverterTest::file});
+}
+
+namespace {
+    /* Same data as in StanfordImporter tests.
+
+        0--3--4
+        |\ | /
+        | \|/
+        1--2
+    */
+    const std::vector<UnsignedInt> indices{0, 1, 2, 0, 2, 3, 3, 2, 4};
+    const std::vector<Vector3> positions{
+        {1.0f, 3.0f, 2.0f},
+        {1.0f, 1.0f, 2.0f},
+        {3.0f, 3.0f, 2.0f},
+        {3.0f, 1.0f, 2.0f},
+        {5.0f, 3.0f, 9.0f}
+    };
+}
+
+void StanfordSceneConverterTest::wrongPrimitive() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const auto data = StanfordSceneConverter{}.exportToData(MeshData3D{MeshPrimitive::Lines, {}, {positions}, {}, {}, {}, nullptr});
+    CORRADE_VERIFY(!data);
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::exportToData(): expected triangle mesh, got MeshPrimitive::Lines\n");
+}
+
+void StanfordSceneConverterTest::wrongNormalCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const auto data = StanfordSceneConverter{}.exportToData(MeshData3D{MeshPrimitive::Triangles, indices, {positions}, {{Vector3::zAxis()}}, {}, {}, nullptr});
+    CORRADE_VERIFY(!data);
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::exportToData(): expected 5 normals but got 1\n");
+}
+
+void StanfordSceneConverterTest::wrongColorCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const auto data = StanfordSceneConverter{}.exportToData(MeshData3D{MeshPrimitive::Triangles, indices, {positions}, {}, {}, {{Color4{}, Color4{}}}, nullptr});
+    CORRADE_VERIFY(!data);
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::exportToData(): expected 5 colors but got 2\n");
+}
+
+void StanfordSceneConverterTest::wrongIndexCount() {
+    std::ostringstream out;
+    Error redirectError{&out};
+
+    const auto data = StanfordSceneConverter{}.exportToData(MeshData3D{MeshPrimitive::Triangles, {0, 1, 2, 3}, {positions}, {}, {}, {}, nullptr});
+    CORRADE_VERIFY(!data);
+    CORRADE_COMPARE(out.str(), "Trade::StanfordSceneConverter::exportToData(): index count 4 is not divisible by three\n");
+}
+
+void StanfordSceneConverterTest::data() {
+    const auto data = StanfordSceneConverter{}.exportToData(MeshData3D{MeshPrimitive::Triangles, indices, {positions}, {}, {}, {}, nullptr});
+    CORRADE_VERIFY(data);
+
+    const std::string header =
+        "ply\n"
+        "format binary_little_endian 1.0\n"
+        "element vertex 5\n"
+        "property float x\n"
+        "property float y\n"
+        "property float z\n"
+        "element face 3\n"
+        "property list uchar uint vertex_indices\n"
+        "end_header\n";
+    CORRADE_COMPARE(data.size(), header.size() + 5*12 + 3*13);
+    CORRADE_COMPARE(std::string(data.data(), header.size()), header);
+
+    StanfordImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+
+    auto mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->primitive(), MeshPrimitive::Triangles);
+    CORRADE_COMPARE(mesh->indices(), indices);
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+void StanfordSceneConverterTest::nonIndexed() {
+    const auto data = StanfordSceneConverter{}.exportToData(MeshData3D{MeshPrimitive::Triangles, {}, {{positions[0], positions[1], positions[2]}}, {}, {}, {}, nullptr});
+    CORRADE_VERIFY(data);
+
+    StanfordImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+
+    auto mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), (std::vector<UnsignedInt>{0, 1, 2}));
+    CORRADE_COMPARE(mesh->positions(0), (std::vector<Vector3>{positions[0], positions[1], positions[2]}));
+}
+
+void StanfordSceneConverterTest::normalsColors() {
+    const std::vector<Vector3> normals{
+        {0.0f, 0.0f, 1.0f},
+        {0.0f, 1.0f, 0.0f},
+        {1.0f, 0.0f, 0.0f},
+        {-0.5f, 0.25f, 0.125f},
+        {0.0f, -1.0f, 0.0f}
+    };
+    const std::vector<Color4> colors{
+        {1.0f, 0.0f, 0.5f, 2.0f},
+        {0.0f, 1.0f, 0.0f, 1.0f},
+        {0.2f, 0.4f, 0.6f, 0.8f},
+        {-1.0f, 0.0f, 1.0f, 0.0f},
+        {0.25f, 0.75f, 1.5f, 0.5f}
+    };
+    /* Colors are clamped and packed to bytes */
+    const UnsignedByte expectedColors[][4]{
+        {255, 0, 128, 255},
+        {0, 255, 0, 255},
+        {51, 102, 153, 204},
+        {0, 0, 255, 0},
+        {64, 191, 255, 128}
+    };
+
+    const auto data = StanfordSceneConverter{}.exportToData(MeshData3D{MeshPrimitive::Triangles, indices, {positions}, {normals}, {}, {colors}, nullptr});
+    CORRADE_VERIFY(data);
+
+    /* Check all normals and colors, positions are checked below */
+    const char* vertex = data.end() - 3*13 - 5*28;
+    for(std::size_t i = 0; i != 5; ++i, vertex += 28) {
+        Vector3 normal;
+        for(std::size_t j = 0; j != 3; ++j) {
+            Float component;
+            std::memcpy(&component, vertex + 12 + j*4, 4);
+            normal[j] = Utility::Endianness::littleEndian(component);
+        }
+        CORRADE_COMPARE(normal, normals[i]);
+
+        for(std::size_t j = 0; j != 4; ++j)
+            CORRADE_COMPARE(UnsignedByte(vertex[24 + j]), expectedColors[i][j]);
+    }
+
+    StanfordImporter importer;
+    CORRADE_VERIFY(importer.openData(data));
+
+    /* The importer imports positions only */
+    std::ostringstream out;
+    Debug redirectDebug{&out};
+    auto mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), indices);
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+void StanfordSceneConverterTest::file() {
+    const std::string filename = Utility::Directory::join(STANFORDSCENECONVERTER_TEST_OUTPUT_DIR, "file.ply");
+    if(Utility::Directory::fileExists(filename))
+        CORRADE_VERIFY(Utility::Directory::rm(filename));
+
+    CORRADE_VERIFY(StanfordSceneConverter{}.exportToFile(MeshData3D{MeshPrimitive::Triangles, indices, {positions}, {}, {}, {}, nullptr}, filename));
+
+    StanfordImporter importer;
+    CORRADE_VERIFY(importer.openFile(filename));
+
+    auto mesh = importer.mesh3D(0);
+    CORRADE_VERIFY(mesh);
+    CORRADE_COMPARE(mesh->indices(), indices);
+    CORRADE_COMPARE(mesh->positions(0), positions);
+}
+
+}}}
+
+CORRADE_TEST_MAIN(Magnum::Trade::Test::StanfordSceneConverterTest)